@@ -0,0 +1,508 @@
+// Header files
+#include "./mwc_validation_node.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+
+using namespace std;
+
+
+// Namespace
+using namespace MwcValidationNode;
+
+
+// Classes
+
+// Map hashes class
+class MapHashes final {
+
+	// Public
+	public:
+	
+		// Contains
+		bool contains(const uint64_t index) const;
+		
+		// At
+		const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &at(const uint64_t index) const;
+		
+		// Emplace
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &emplace(const uint64_t index, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &hash);
+		
+		// Erase
+		void erase(const uint64_t index);
+		
+	// Private
+	private:
+	
+		// Hashes
+		map<uint64_t, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> hashes;
+};
+
+
+// Constants
+
+// Merkle mountain range hashes benchmark number of leaves
+static const uint64_t MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES = 250000;
+
+// Merkle mountain range hashes benchmark number of roots
+static const uint64_t MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_ROOTS = 100000;
+
+// Merkle mountain range hashes benchmark pruned leaves percent
+static const uint64_t MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_PRUNED_LEAVES_PERCENT = 90;
+
+// Unique outputs commitment prefix
+static const uint8_t UNIQUE_OUTPUTS_COMMITMENT_PREFIX = 0x08;
+
+// Random number generator seed
+static const mt19937_64::result_type RANDOM_NUMBER_GENERATOR_SEED = 0;
+
+// Proof of work benchmark number of headers
+static const size_t PROOF_OF_WORK_BENCHMARK_NUMBER_OF_HEADERS = 1000;
+
+// Proof of work benchmark number of verifications
+static const uint64_t PROOF_OF_WORK_BENCHMARK_NUMBER_OF_VERIFICATIONS = 10000;
+
+// Proof of work benchmark SipHash implementations
+static const pair<ProofOfWork::SipHashImplementation, const char *> PROOF_OF_WORK_BENCHMARK_SIPHASH_IMPLEMENTATIONS[] = {
+	{ProofOfWork::SipHashImplementation::SCALAR, "Scalar"},
+	{ProofOfWork::SipHashImplementation::AVX2, "AVX2"},
+	{ProofOfWork::SipHashImplementation::AVX512, "AVX-512"}
+};
+
+
+// Global variables
+
+// Allocated bytes
+static atomic_size_t allocatedBytes;
+
+
+// Function prototypes
+
+// Benchmark Merkle mountain range hashes
+static void benchmarkMerkleMountainRangeHashes();
+
+// Benchmark state restore
+static void benchmarkStateRestore(const char *stateFile);
+
+// Benchmark proof of work
+static void benchmarkProofOfWork(const char *stateFile);
+
+// Benchmark Merkle mountain range hashes storage
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> static void benchmarkMerkleMountainRangeHashesStorage(const char *leafType, const char *storageType, const vector<MerkleMountainRangeLeafDerivedClass> &leaves, const bool pruneLeaves);
+
+// Get unique outputs
+static vector<Output> getUniqueOutputs(const uint64_t numberOfOutputs);
+
+// Get megabytes
+static double getMegabytes(const size_t bytes);
+
+
+// Main function
+int main(int argc, char *argv[]) {
+
+	// Try
+	try {
+	
+		// Benchmark Merkle mountain range hashes
+		benchmarkMerkleMountainRangeHashes();
+		
+		// Check if a state file was provided
+		if(argc > 1) {
+		
+			// Benchmark state restore with the state file
+			benchmarkStateRestore(argv[1]);
+		}
+		
+		// Benchmark proof of work with the state file if one was provided
+		benchmarkProofOfWork((argc > 1) ? argv[1] : nullptr);
+	}
+	
+	// Catch errors
+	catch(const exception &error) {
+	
+		// Display message
+		cout << "Benchmark failed: " << error.what() << endl;
+		
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
+	// Return success
+	return EXIT_SUCCESS;
+}
+
+
+// Supporting function implementation
+
+// New operator
+void *operator new(const size_t size) {
+
+	// Check if allocating memory with space for its size failed
+	uint8_t *memory = static_cast<uint8_t *>(malloc(sizeof(max_align_t) + size));
+	if(!memory) {
+	
+		// Throw exception
+		throw bad_alloc();
+	}
+	
+	// Store the memory's size before it
+	*reinterpret_cast<size_t *>(memory) = size;
+	
+	// Update allocated bytes
+	allocatedBytes += size;
+	
+	// Return memory after its size
+	return memory + sizeof(max_align_t);
+}
+
+// Delete operator
+void operator delete(void *memory) noexcept {
+
+	// Check if memory exists
+	if(memory) {
+	
+		// Get the start of the memory's allocation
+		uint8_t *start = static_cast<uint8_t *>(memory) - sizeof(max_align_t);
+		
+		// Update allocated bytes
+		allocatedBytes -= *reinterpret_cast<size_t *>(start);
+		
+		// Free allocation
+		free(start);
+	}
+}
+
+// Delete operator
+void operator delete(void *memory, const size_t size) noexcept {
+
+	// Delete memory
+	operator delete(memory);
+}
+
+// Contains
+bool MapHashes::contains(const uint64_t index) const {
+
+	// Return if hashes contains the index
+	return hashes.contains(index);
+}
+
+// At
+const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &MapHashes::at(const uint64_t index) const {
+
+	// Return hash at the index
+	return hashes.at(index);
+}
+
+// Emplace
+array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &MapHashes::emplace(const uint64_t index, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &hash) {
+
+	// Return hash at the index
+	return hashes.emplace(index, hash).first->second;
+}
+
+// Erase
+void MapHashes::erase(const uint64_t index) {
+
+	// Remove hash at the index
+	hashes.erase(index);
+}
+
+// Benchmark Merkle mountain range hashes
+void benchmarkMerkleMountainRangeHashes() {
+
+	// Display message
+	cout << "Merkle mountain range hashes: " << MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES << " leaves, " << MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_ROOTS << " roots, " << MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_PRUNED_LEAVES_PERCENT << "% of leaves pruned" << endl;
+	
+	// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+	#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+	
+		// Display message
+		cout << "Leaves and paged hashes are memory mapped, so their memory only counts sparse pages and lookup tables" << endl;
+	#endif
+	
+	// Benchmark paged and map storage with headers without pruning them since headers are never pruned
+	benchmarkMerkleMountainRangeHashesStorage<Header, MerkleMountainRangeHashes>("Header", "paged", {Consensus::GENESIS_BLOCK_HEADER}, false);
+	benchmarkMerkleMountainRangeHashesStorage<Header, MapHashes>("Header", "map", {Consensus::GENESIS_BLOCK_HEADER}, false);
+	
+	// Benchmark paged and map storage with kernels
+	benchmarkMerkleMountainRangeHashesStorage<Kernel, MerkleMountainRangeHashes>("Kernel", "paged", {Consensus::GENESIS_BLOCK_KERNEL}, true);
+	benchmarkMerkleMountainRangeHashesStorage<Kernel, MapHashes>("Kernel", "map", {Consensus::GENESIS_BLOCK_KERNEL}, true);
+	
+	// Benchmark paged and map storage with unique outputs since outputs' lookup values can't be duplicates
+	const vector outputs = getUniqueOutputs(MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES);
+	benchmarkMerkleMountainRangeHashesStorage<Output, MerkleMountainRangeHashes>("Output", "paged", outputs, true);
+	benchmarkMerkleMountainRangeHashesStorage<Output, MapHashes>("Output", "map", outputs, true);
+	
+	// Benchmark paged and map storage with rangeproofs
+	benchmarkMerkleMountainRangeHashesStorage<Rangeproof, MerkleMountainRangeHashes>("Rangeproof", "paged", {Consensus::GENESIS_BLOCK_RANGEPROOF}, true);
+	benchmarkMerkleMountainRangeHashesStorage<Rangeproof, MapHashes>("Rangeproof", "map", {Consensus::GENESIS_BLOCK_RANGEPROOF}, true);
+}
+
+// Benchmark state restore
+void benchmarkStateRestore(const char *stateFile) {
+
+	// Display message
+	cout << "State restore: " << stateFile << endl;
+	
+	// Set state file to throw exception on error
+	ifstream file;
+	file.exceptions(ios::badbit | ios::failbit);
+	
+	// Open state file
+	file.open(stateFile, ios::binary);
+	
+	// Restore node from the state file
+	Node node;
+	const chrono::time_point restoreStart = chrono::steady_clock::now();
+	node.restore(file);
+	const chrono::duration<double, milli> restoreDuration = chrono::steady_clock::now() - restoreStart;
+	
+	// Close state file
+	file.close();
+	
+	// Set saved file to throw exception on error
+	const string savedFileName = string(stateFile) + ".benchmark";
+	ofstream savedFile;
+	savedFile.exceptions(ios::badbit | ios::failbit);
+	
+	// Open saved file
+	savedFile.open(savedFileName, ios::binary | ios::trunc);
+	
+	// Save node to the saved file in the current state format
+	const chrono::time_point saveStart = chrono::steady_clock::now();
+	node.save(savedFile);
+	savedFile.close();
+	const chrono::duration<double, milli> saveDuration = chrono::steady_clock::now() - saveStart;
+	
+	// Set restored file to throw exception on error
+	ifstream restoredFile;
+	restoredFile.exceptions(ios::badbit | ios::failbit);
+	
+	// Open restored file
+	restoredFile.open(savedFileName, ios::binary);
+	
+	// Restore another node from the saved file
+	Node restoredNode;
+	const chrono::time_point savedRestoreStart = chrono::steady_clock::now();
+	restoredNode.restore(restoredFile);
+	const chrono::duration<double, milli> savedRestoreDuration = chrono::steady_clock::now() - savedRestoreStart;
+	
+	// Close restored file
+	restoredFile.close();
+	
+	// Remove saved file
+	filesystem::remove(savedFileName);
+	
+	// Display results
+	cout << "Restore " << restoreDuration.count() << " ms, save " << saveDuration.count() << " ms, restore saved state " << savedRestoreDuration.count() << " ms, memory " << getMegabytes(allocatedBytes.load()) << " MiB" << endl;
+}
+
+// Benchmark proof of work
+void benchmarkProofOfWork(const char *stateFile) {
+
+	// Initialize headers with the genesis block header
+	vector<Header> headers = {Consensus::GENESIS_BLOCK_HEADER};
+	
+	// Check if a state file was provided
+	if(stateFile) {
+	
+		// Set state file to throw exception on error
+		ifstream file;
+		file.exceptions(ios::badbit | ios::failbit);
+		
+		// Open state file
+		file.open(stateFile, ios::binary);
+		
+		// Restore node from the state file
+		Node node;
+		node.restore(file);
+		
+		// Close state file
+		file.close();
+		
+		// Go through the node's newest headers
+		const MerkleMountainRange<Header> &nodeHeaders = node.getHeaders();
+		for(uint64_t i = nodeHeaders.getNumberOfLeaves(); i > 0 && headers.size() < PROOF_OF_WORK_BENCHMARK_NUMBER_OF_HEADERS; --i) {
+		
+			// Get header
+			const Header *header = nodeHeaders.getLeaf(i - 1);
+			
+			// Check if header isn't pruned and isn't the genesis block header
+			if(header && header->getHeight() != Consensus::GENESIS_BLOCK_HEADER.getHeight()) {
+			
+				// Add header to the list of headers
+				headers.push_back(*header);
+			}
+		}
+	}
+	
+	// Display message
+	cout << "Proof of work: " << headers.size() << " headers, " << PROOF_OF_WORK_BENCHMARK_NUMBER_OF_VERIFICATIONS << " verifications" << endl;
+	
+	// Get current SipHash implementation
+	const ProofOfWork::SipHashImplementation currentSipHashImplementation = ProofOfWork::getSipHashImplementation();
+	
+	// Initialize number of valid verifications
+	optional<uint64_t> numberOfValidVerifications;
+	
+	// Go through all SipHash implementations
+	for(const pair<ProofOfWork::SipHashImplementation, const char *> &sipHashImplementation : PROOF_OF_WORK_BENCHMARK_SIPHASH_IMPLEMENTATIONS) {
+	
+		// Check if SipHash implementation isn't supported
+		if(!ProofOfWork::setSipHashImplementation(sipHashImplementation.first)) {
+		
+			// Display message
+			cout << sipHashImplementation.second << " SipHash isn't supported" << endl;
+			
+			// Continue
+			continue;
+		}
+		
+		// Verify the headers' proof of work
+		uint64_t numberOfValidHeaders = 0;
+		const chrono::time_point start = chrono::steady_clock::now();
+		for(uint64_t i = 0; i < PROOF_OF_WORK_BENCHMARK_NUMBER_OF_VERIFICATIONS; ++i) {
+		
+			// Check if header has a valid proof of work
+			if(ProofOfWork::hasValidProofOfWork(headers[i % headers.size()])) {
+			
+				// Increment number of valid headers
+				++numberOfValidHeaders;
+			}
+		}
+		const chrono::duration<double, micro> duration = chrono::steady_clock::now() - start;
+		
+		// Check if SipHash implementation's results differ from another implementation's
+		if(numberOfValidVerifications.has_value() && numberOfValidVerifications.value() != numberOfValidHeaders) {
+		
+			// Restore SipHash implementation
+			ProofOfWork::setSipHashImplementation(currentSipHashImplementation);
+			
+			// Throw exception
+			throw runtime_error("SipHash implementations disagree");
+		}
+		
+		// Set number of valid verifications
+		numberOfValidVerifications = numberOfValidHeaders;
+		
+		// Display results
+		cout << sipHashImplementation.second << " SipHash " << duration.count() / PROOF_OF_WORK_BENCHMARK_NUMBER_OF_VERIFICATIONS << " us per header, " << numberOfValidHeaders << " valid" << endl;
+	}
+	
+	// Restore SipHash implementation
+	ProofOfWork::setSipHashImplementation(currentSipHashImplementation);
+}
+
+// Benchmark Merkle mountain range hashes storage
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void benchmarkMerkleMountainRangeHashesStorage(const char *leafType, const char *storageType, const vector<MerkleMountainRangeLeafDerivedClass> &leaves, const bool pruneLeaves) {
+
+	// Get allocated bytes before appending
+	const size_t initialAllocatedBytes = allocatedBytes.load();
+	
+	// Initialize Merkle mountain range with the hashes storage
+	MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass> merkleMountainRange;
+	
+	// Go through all leaves
+	const chrono::time_point appendStart = chrono::steady_clock::now();
+	for(uint64_t i = 0; i < MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES; ++i) {
+	
+		// Append leaf
+		merkleMountainRange.appendLeaf(leaves[i % leaves.size()]);
+	}
+	
+	// Get append duration and allocated bytes
+	const chrono::duration<double, nano> appendDuration = chrono::steady_clock::now() - appendStart;
+	const size_t appendedAllocatedBytes = allocatedBytes.load() - initialAllocatedBytes;
+	
+	// Go through all roots
+	uint8_t rootsChecksum = 0;
+	const chrono::time_point rootsStart = chrono::steady_clock::now();
+	for(uint64_t i = 0; i < MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_ROOTS; ++i) {
+	
+		// Update roots checksum with the root so that getting it isn't optimized out
+		rootsChecksum += merkleMountainRange.getRootAtSize(merkleMountainRange.getSize())[0];
+	}
+	
+	// Get roots duration
+	const chrono::duration<double, nano> rootsDuration = chrono::steady_clock::now() - rootsStart;
+	
+	// Display results
+	cout << leafType << " " << storageType << ": append " << appendDuration.count() / MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES << " ns/leaf, root " << rootsDuration.count() / MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_ROOTS << " ns, memory " << getMegabytes(appendedAllocatedBytes) << " MiB";
+	
+	// Check if pruning leaves
+	if(pruneLeaves) {
+	
+		// Go through all leaves
+		mt19937_64 randomNumberGenerator(RANDOM_NUMBER_GENERATOR_SEED);
+		uint64_t numberOfPrunedLeaves = 0;
+		const chrono::time_point pruneStart = chrono::steady_clock::now();
+		for(uint64_t i = 0; i < MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_NUMBER_OF_LEAVES; ++i) {
+		
+			// Check if leaf is randomly chosen to be pruned
+			if(randomNumberGenerator() % 100 < MERKLE_MOUNTAIN_RANGE_HASHES_BENCHMARK_PRUNED_LEAVES_PERCENT) {
+			
+				// Permanently prune leaf
+				merkleMountainRange.pruneLeaf(i, true);
+				
+				// Increment number of pruned leaves
+				++numberOfPrunedLeaves;
+			}
+		}
+		
+		// Get prune duration and allocated bytes
+		const chrono::duration<double, nano> pruneDuration = chrono::steady_clock::now() - pruneStart;
+		const size_t prunedAllocatedBytes = allocatedBytes.load() - initialAllocatedBytes;
+		
+		// Display results
+		cout << ", prune " << pruneDuration.count() / max(numberOfPrunedLeaves, static_cast<uint64_t>(1)) << " ns/leaf, memory after pruning " << getMegabytes(prunedAllocatedBytes) << " MiB";
+	}
+	
+	// Display roots checksum
+	cout << " (checksum " << static_cast<unsigned>(rootsChecksum) << ")" << endl;
+}
+
+// Get unique outputs
+vector<Output> getUniqueOutputs(const uint64_t numberOfOutputs) {
+
+	// Initialize outputs
+	vector<Output> outputs;
+	outputs.reserve(numberOfOutputs);
+	
+	// Initialize commitment with the unique outputs commitment prefix
+	uint8_t commitment[Crypto::COMMITMENT_LENGTH] = {UNIQUE_OUTPUTS_COMMITMENT_PREFIX};
+	
+	// Go through all candidate commitments until enough outputs exist
+	for(uint64_t i = 1; outputs.size() < numberOfOutputs; ++i) {
+	
+		// Set commitment's x coordinate to the candidate
+		const uint64_t candidateBigEndian = Common::hostByteOrderToBigEndian(i);
+		memcpy(&commitment[sizeof(commitment) - sizeof(candidateBigEndian)], &candidateBigEndian, sizeof(candidateBigEndian));
+		
+		// Try
+		try {
+		
+			// Append output with the commitment to list
+			outputs.emplace_back(Output::Features::PLAIN, commitment);
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+		}
+	}
+	
+	// Return outputs
+	return outputs;
+}
+
+// Get megabytes
+double getMegabytes(const size_t bytes) {
+
+	// Return bytes in megabytes
+	return static_cast<double>(bytes) / Common::BYTES_IN_A_KILOBYTE / Common::BYTES_IN_A_KILOBYTE;
+}
@@ -1,7 +1,7 @@
 // Header files
 #include "./common.h"
+#include <algorithm>
 #include <cstring>
-#include <set>
 #include "blake2.h"
 #include "./block.h"
 #include "./consensus.h"
@@ -17,7 +17,7 @@ using namespace MwcValidationNode;
 // Supporting function implementation
 
 // Constructor
-Block::Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels) :
+Block::Block(vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels) :
 
 	// Delegate constructor
 	Block(move(inputs), move(outputs), move(rangeproofs), move(kernels), false, true)
@@ -25,42 +25,42 @@ Block::Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&ra
 }
 
 // Get inputs
-const list<Input> &Block::getInputs() const {
+const vector<Input> &Block::getInputs() const {
 
 	// Return inputs
 	return inputs;
 }
 
 // Get outputs
-const list<Output> &Block::getOutputs() const {
+const vector<Output> &Block::getOutputs() const {
 
 	// Return outputs
 	return outputs;
 }
 
 // Get rangeproofs
-const list<Rangeproof> &Block::getRangeproofs() const {
+const vector<Rangeproof> &Block::getRangeproofs() const {
 
 	// Return rangeproofs
 	return rangeproofs;
 }
 
 // Get kernels
-const list<Kernel> &Block::getKernels() const {
+const vector<Kernel> &Block::getKernels() const {
 
 	// Return kernels
 	return kernels;
 }
 
 // Get inputs
-list<Input> &Block::getInputs() {
+vector<Input> &Block::getInputs() {
 
 	// Return inputs
 	return inputs;
 }
 
 // Constructor
-Block::Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels, const bool isTransaction, const bool verify) :
+Block::Block(vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels, const bool isTransaction, const bool verify) :
 
 	// Set inputs to inputs
 	inputs(move(inputs)),
@@ -111,11 +111,14 @@ Block::Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&ra
 // Is sorted and unique
 bool Block::isSortedAndUnique() const {
 
+	// Initialize previous hash
+	uint8_t previousHash[Crypto::BLAKE2B_HASH_LENGTH];
+	
 	// Go through all inputs
-	for(list<Input>::const_iterator i = next(inputs.cbegin()); i != inputs.cend(); ++i) {
+	for(vector<Input>::size_type i = 0; i < inputs.size(); ++i) {
 	
 		// Get serialized input
-		const vector serializedInput = i->serialize();
+		const vector serializedInput = inputs[i].serialize();
 		
 		// Check if creating input's hash failed
 		uint8_t inputHash[Crypto::BLAKE2B_HASH_LENGTH];
@@ -125,30 +128,22 @@ bool Block::isSortedAndUnique() const {
 			throw runtime_error("Creating input's hash failed");
 		}
 		
-		// Get serialized previous input
-		const vector serializedPreviousInput = prev(i)->serialize();
-		
-		// Check if creating previous input's hash failed
-		uint8_t previousInputHash[Crypto::BLAKE2B_HASH_LENGTH];
-		if(blake2b(previousInputHash, sizeof(previousInputHash), serializedPreviousInput.data(), serializedPreviousInput.size(), nullptr, 0)) {
-		
-			// Throw exception
-			throw runtime_error("Creating previous input's hash failed");
-		}
-		
 		// Check if inputs aren't sorted and/or aren't unique
-		if(memcmp(inputHash, previousInputHash, sizeof(previousInputHash)) <= 0) {
+		if(i && memcmp(inputHash, previousHash, sizeof(previousHash)) <= 0) {
 		
 			// Return false
 			return false;
 		}
+		
+		// Set previous hash to the input's hash so that it's only created once
+		memcpy(previousHash, inputHash, sizeof(inputHash));
 	}
 	
 	// Go through all outputs
-	for(list<Output>::const_iterator i = next(outputs.cbegin()); i != outputs.cend(); ++i) {
+	for(vector<Output>::size_type i = 0; i < outputs.size(); ++i) {
 	
 		// Get serialized output
-		const vector serializedOutput = i->serialize();
+		const vector serializedOutput = outputs[i].serialize();
 		
 		// Check if creating output's hash failed
 		uint8_t outputHash[Crypto::BLAKE2B_HASH_LENGTH];
@@ -158,30 +153,22 @@ bool Block::isSortedAndUnique() const {
 			throw runtime_error("Creating outputs's hash failed");
 		}
 		
-		// Get serialized previous output
-		const vector serializedPreviousOutput = prev(i)->serialize();
-		
-		// Check if creating previous output's hash failed
-		uint8_t previousOutputHash[Crypto::BLAKE2B_HASH_LENGTH];
-		if(blake2b(previousOutputHash, sizeof(previousOutputHash), serializedPreviousOutput.data(), serializedPreviousOutput.size(), nullptr, 0)) {
-		
-			// Throw exception
-			throw runtime_error("Creating previous output's hash failed");
-		}
-		
 		// Check if outputs aren't sorted and/or aren't unique
-		if(memcmp(outputHash, previousOutputHash, sizeof(previousOutputHash)) <= 0) {
+		if(i && memcmp(outputHash, previousHash, sizeof(previousHash)) <= 0) {
 		
 			// Return false
 			return false;
 		}
+		
+		// Set previous hash to the output's hash so that it's only created once
+		memcpy(previousHash, outputHash, sizeof(outputHash));
 	}
 	
 	// Go through all kernels
-	for(list<Kernel>::const_iterator i = next(kernels.cbegin()); i != kernels.cend(); ++i) {
+	for(vector<Kernel>::size_type i = 0; i < kernels.size(); ++i) {
 	
 		// Get serialized kernel
-		const vector serializedKernel = i->serialize();
+		const vector serializedKernel = kernels[i].serialize();
 		
 		// Check if creating kernel's hash failed
 		uint8_t kernelHash[Crypto::BLAKE2B_HASH_LENGTH];
@@ -191,23 +178,15 @@ bool Block::isSortedAndUnique() const {
 			throw runtime_error("Creating kernel's hash failed");
 		}
 		
-		// Get serialized previous kernel
-		const vector serializedPreviousKernel = prev(i)->serialize();
-		
-		// Check if creating previous kernel's hash failed
-		uint8_t previousKernelHash[Crypto::BLAKE2B_HASH_LENGTH];
-		if(blake2b(previousKernelHash, sizeof(previousKernelHash), serializedPreviousKernel.data(), serializedPreviousKernel.size(), nullptr, 0)) {
-		
-			// Throw exception
-			throw runtime_error("Creating previous kernel's hash failed");
-		}
-		
 		// Check if kernels aren't sorted and/or aren't unique
-		if(memcmp(kernelHash, previousKernelHash, sizeof(previousKernelHash)) <= 0) {
+		if(i && memcmp(kernelHash, previousHash, sizeof(previousHash)) <= 0) {
 		
 			// Return false
 			return false;
 		}
+		
+		// Set previous hash to the kernel's hash so that it's only created once
+		memcpy(previousHash, kernelHash, sizeof(kernelHash));
 	}
 	
 	// Return true
@@ -235,7 +214,8 @@ bool Block::hasValidWeight(const bool isTransaction) const {
 bool Block::hasUniqueNoRecentDuplicateKernelExcesses() const {
 
 	// Initialize serialized kernel excesses
-	set<array<uint8_t, Crypto::COMMITMENT_LENGTH>> serializedKernelExcesses;
+	vector<array<uint8_t, Crypto::COMMITMENT_LENGTH>> serializedKernelExcesses;
+	serializedKernelExcesses.reserve(kernels.size());
 	
 	// Go through all kernels
 	for(const Kernel &kernel : kernels) {
@@ -251,18 +231,21 @@ bool Block::hasUniqueNoRecentDuplicateKernelExcesses() const {
 				throw runtime_error("Serializing kernel's excess failed");
 			}
 			
-			// Check if serialized kernel excess already exists
-			if(serializedKernelExcesses.contains(serializedKernelExcess)) {
-			
-				// Return false
-				return false;
-			}
-			
 			// Add serialized kernel excess to list
-			serializedKernelExcesses.insert(move(serializedKernelExcess));
+			serializedKernelExcesses.push_back(move(serializedKernelExcess));
 		}
 	}
 	
+	// Sort serialized kernel excesses
+	sort(serializedKernelExcesses.begin(), serializedKernelExcesses.end());
+	
+	// Check if a serialized kernel excess exists more than once
+	if(adjacent_find(serializedKernelExcesses.cbegin(), serializedKernelExcesses.cend()) != serializedKernelExcesses.cend()) {
+	
+		// Return false
+		return false;
+	}
+	
 	// Return true
 	return true;
 }
@@ -271,7 +254,8 @@ bool Block::hasUniqueNoRecentDuplicateKernelExcesses() const {
 bool Block::hasValidCutThrough() const {
 
 	// Initialize serialized commitments
-	set<array<uint8_t, Crypto::COMMITMENT_LENGTH>> serializedCommitments;
+	vector<array<uint8_t, Crypto::COMMITMENT_LENGTH>> serializedCommitments;
+	serializedCommitments.reserve(inputs.size() + outputs.size());
 	
 	// Go through all inputs
 	for(const Input &input : inputs) {
@@ -284,15 +268,8 @@ bool Block::hasValidCutThrough() const {
 			throw runtime_error("Serializing input's commitment failed");
 		}
 		
-		// Check if serialized input commitment already exists
-		if(serializedCommitments.contains(serializedInputCommitment)) {
-		
-			// Return false
-			return false;
-		}
-		
 		// Add serialized input commitment to list
-		serializedCommitments.insert(move(serializedInputCommitment));
+		serializedCommitments.push_back(move(serializedInputCommitment));
 	}
 	
 	// Go through all outputs
@@ -306,15 +283,18 @@ bool Block::hasValidCutThrough() const {
 			throw runtime_error("Serializing output's commitment failed");
 		}
 		
-		// Check if serialized output commitment already exists
-		if(serializedCommitments.contains(serializedOutputCommitment)) {
-		
-			// Return false
-			return false;
-		}
-		
 		// Add serialized output commitment to list
-		serializedCommitments.insert(move(serializedOutputCommitment));
+		serializedCommitments.push_back(move(serializedOutputCommitment));
+	}
+	
+	// Sort serialized commitments
+	sort(serializedCommitments.begin(), serializedCommitments.end());
+	
+	// Check if a serialized commitment exists more than once
+	if(adjacent_find(serializedCommitments.cbegin(), serializedCommitments.cend()) != serializedCommitments.cend()) {
+	
+		// Return false
+		return false;
 	}
 	
 	// Return true
@@ -5,7 +5,7 @@
 
 // Header files
 #include "./common.h"
-#include <list>
+#include <vector>
 #include "./input.h"
 #include "./kernel.h"
 #include "./output.h"
@@ -33,19 +33,19 @@ class Block final {
 	public:
 	
 		// Constructor
-		explicit Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels);
+		explicit Block(vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels);
 		
 		// Get inputs
-		const list<Input> &getInputs() const;
+		const vector<Input> &getInputs() const;
 		
 		// Get outputs
-		const list<Output> &getOutputs() const;
+		const vector<Output> &getOutputs() const;
 		
 		// Get rangeproofs
-		const list<Rangeproof> &getRangeproofs() const;
+		const vector<Rangeproof> &getRangeproofs() const;
 		
 		// Get kernels
-		const list<Kernel> &getKernels() const;
+		const vector<Kernel> &getKernels() const;
 		
 	// Public for transaction class
 	private:
@@ -54,7 +54,7 @@ class Block final {
 		friend class Transaction;
 	
 		// Get inputs
-		list<Input> &getInputs();
+		vector<Input> &getInputs();
 		
 	// Public for node class
 	private:
@@ -63,7 +63,7 @@ class Block final {
 		friend class Node;
 		
 		// Constructor
-		explicit Block(list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels, const bool isTransaction, const bool verify = true);
+		explicit Block(vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels, const bool isTransaction, const bool verify = true);
 		
 	// Private
 	private:
@@ -81,16 +81,16 @@ class Block final {
 		bool hasValidCutThrough() const;
 	
 		// Inputs
-		list<Input> inputs;
+		vector<Input> inputs;
 		
 		// Outputs
-		list<Output> outputs;
+		vector<Output> outputs;
 		
 		// Rangeproofs
-		list<Rangeproof> rangeproofs;
+		vector<Rangeproof> rangeproofs;
 		
 		// Kernels
-		list<Kernel> kernels;
+		vector<Kernel> kernels;
 };
 
 
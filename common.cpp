@@ -1,6 +1,7 @@
 // Header files
 #include "./common.h"
 #include <iomanip>
+#include <random>
 #include <signal.h>
 #include <sstream>
 #include "./saturate_math.h"
@@ -58,6 +59,9 @@ const uint16_t Common::HTTP_PORT = 80;
 // Tor address length
 const size_t Common::TOR_ADDRESS_LENGTH = 56;
 
+// Uint8 array hash seed
+const uint64_t Common::Uint8ArrayHash::SEED = (static_cast<uint64_t>(random_device()()) << (sizeof(uint32_t) * BITS_IN_A_BYTE)) | random_device()();
+
 
 // Global variables
 
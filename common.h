@@ -18,7 +18,11 @@
 
 
 // Header files
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <cstring>
 #include <mutex>
 #include <stdexcept>
 #include <string>
@@ -60,8 +64,11 @@ class Node;
 // Peer class forward declaration
 class Peer;
 
+// Merkle mountain range hashes class forward declaration
+class MerkleMountainRangeHashes;
+
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass = MerkleMountainRangeHashes> class MerkleMountainRange;
 
 // Header class forward declaration
 class Header;
@@ -184,6 +191,22 @@ class Common final {
 				size_t operator()(const vector<uint8_t> &uint8Vector) const;
 		};
 		
+		// Uint8 array hash
+		class Uint8ArrayHash {
+
+			// Public
+			public:
+			
+				// Operator
+				template<size_t length> size_t operator()(const array<uint8_t, length> &uint8Array) const;
+			
+			// Private
+			private:
+			
+				// Seed
+				static const uint64_t SEED;
+		};
+		
 		// Read uint8
 		template<typename StorageClass> static uint8_t readUint8(const StorageClass &buffer, const typename StorageClass::size_type offset);
 		
@@ -252,6 +275,32 @@ template<typename StorageClass> string Common::toHexString(const StorageClass &d
 	return toHexString(data.data(), data.size());
 }
 
+// Uint8 array hash operator
+template<size_t length> size_t Common::Uint8ArrayHash::operator()(const array<uint8_t, length> &uint8Array) const {
+
+	// Set hash to the seed
+	uint64_t hash = SEED;
+	
+	// Go through all words in the uint8 array
+	for(size_t i = 0; i < length; i += sizeof(uint64_t)) {
+	
+		// Get word from the uint8 array
+		uint64_t word = 0;
+		memcpy(&word, &uint8Array[i], min(sizeof(word), length - i));
+		
+		// Mix word into the hash
+		hash = rotl(hash ^ (word * 0x87C37B91114253D5), 31) * 0x4CF5AD432745937F;
+	}
+	
+	// Finalize hash
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCD;
+	hash ^= hash >> 33;
+	
+	// Return hash
+	return hash;
+}
+
 // Read uint8
 template<typename StorageClass> uint8_t Common::readUint8(const StorageClass &buffer, const typename StorageClass::size_type offset) {
 
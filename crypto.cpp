@@ -7,6 +7,7 @@
 #include "./kernel.h"
 #include "./merkle_mountain_range.h"
 #include "./output.h"
+#include "secp256k1_schnorrsig.h"
 
 using namespace std;
 
@@ -17,6 +18,32 @@ using namespace MwcValidationNode;
 
 // Constants
 
+// Check if bulletproofs batch size is set
+#ifdef SET_BULLETPROOFS_BATCH_SIZE
+
+	// Bulletproofs batch size
+	const size_t Crypto::BULLETPROOFS_BATCH_SIZE = SET_BULLETPROOFS_BATCH_SIZE;
+	
+// Otherwise
+#else
+
+	// Bulletproofs batch size
+	const size_t Crypto::BULLETPROOFS_BATCH_SIZE = 64;
+#endif
+
+// Check if single-signer signatures batch size is set
+#ifdef SET_SINGLE_SIGNER_SIGNATURES_BATCH_SIZE
+
+	// Single-signer signatures batch size
+	const size_t Crypto::SINGLE_SIGNER_SIGNATURES_BATCH_SIZE = SET_SINGLE_SIGNER_SIGNATURES_BATCH_SIZE;
+	
+// Otherwise
+#else
+
+	// Single-signer signatures batch size
+	const size_t Crypto::SINGLE_SIGNER_SIGNATURES_BATCH_SIZE = 64;
+#endif
+
 // Secp256k1 scratch space length
 const size_t Crypto::SECP256K1_SCRATCH_SPACE_LENGTH = 30 * Common::BYTES_IN_A_KILOBYTE;
 
@@ -27,7 +54,10 @@ const size_t Crypto::SECP256k1_NUMBER_OF_GENERATORS = 256;
 const unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> Crypto::secp256k1Context(secp256k1_context_create(SECP256K1_CONTEXT_VERIFY), secp256k1_context_destroy);
 
 // Secp256k1 scratch space
-thread_local const unique_ptr<secp256k1_scratch_space, decltype(&secp256k1_scratch_space_destroy)> Crypto::secp256k1ScratchSpace(secp256k1_scratch_space_create(secp256k1Context.get(), SECP256K1_SCRATCH_SPACE_LENGTH), secp256k1_scratch_space_destroy);
+thread_local unique_ptr<secp256k1_scratch_space, decltype(&secp256k1_scratch_space_destroy)> Crypto::secp256k1ScratchSpace(secp256k1_scratch_space_create(secp256k1Context.get(), SECP256K1_SCRATCH_SPACE_LENGTH), secp256k1_scratch_space_destroy);
+
+// Secp256k1 scratch space length
+thread_local size_t Crypto::secp256k1ScratchSpaceLength = SECP256K1_SCRATCH_SPACE_LENGTH;
 
 // Secp256k1 generators
 const unique_ptr<secp256k1_bulletproof_generators, void(*)(secp256k1_bulletproof_generators *)> Crypto::secp256k1Generators(secp256k1_bulletproof_generators_create(secp256k1Context.get(), &secp256k1_generator_const_g, SECP256k1_NUMBER_OF_GENERATORS), [](secp256k1_bulletproof_generators *secp256k1Generators) {
@@ -170,3 +200,87 @@ bool Crypto::verifyKernelSums(const Header &header, const MerkleMountainRange<Ke
 	// Return true
 	return true;
 }
+
+// Verify bulletproof
+bool Crypto::verifyBulletproof(const secp256k1_pedersen_commitment &commitment, const uint8_t proof[BULLETPROOF_LENGTH]) {
+
+	// Return if bulletproof is valid
+	return secp256k1_bulletproof_rangeproof_verify(secp256k1Context.get(), secp256k1ScratchSpace.get(), secp256k1Generators.get(), proof, BULLETPROOF_LENGTH, nullptr, &commitment, 1, sizeof(uint64_t) * Common::BITS_IN_A_BYTE, &secp256k1_generator_const_h, nullptr, 0);
+}
+
+// Verify bulletproofs
+bool Crypto::verifyBulletproofs(const secp256k1_pedersen_commitment *const commitments[], const uint8_t *const proofs[], const size_t numberOfBulletproofs) {
+
+	// Check if there's no bulletproofs
+	if(!numberOfBulletproofs) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if there's only one bulletproof
+	if(numberOfBulletproofs == 1) {
+	
+		// Return verifying bulletproof
+		return verifyBulletproof(*commitments[0], proofs[0]);
+	}
+	
+	// Check if getting scratch space large enough for all the bulletproofs failed
+	secp256k1_scratch_space *scratchSpace = getSecp256k1ScratchSpace(SECP256K1_SCRATCH_SPACE_LENGTH * numberOfBulletproofs);
+	if(!scratchSpace) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Set value generators
+	const vector<secp256k1_generator> valueGenerators(numberOfBulletproofs, secp256k1_generator_const_h);
+	
+	// Return if bulletproofs are valid
+	return secp256k1_bulletproof_rangeproof_verify_multi(secp256k1Context.get(), scratchSpace, secp256k1Generators.get(), proofs, numberOfBulletproofs, BULLETPROOF_LENGTH, nullptr, commitments, 1, sizeof(uint64_t) * Common::BITS_IN_A_BYTE, valueGenerators.data(), nullptr, nullptr);
+}
+
+// Verify single-signer signatures
+bool Crypto::verifySingleSignerSignatures(const uint8_t *const signatures[], const uint8_t *const messages[], const secp256k1_pubkey *const publicKeys[], const size_t numberOfSignatures) {
+
+	// Check if there's no signatures
+	if(!numberOfSignatures) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if getting scratch space large enough for all the signatures failed
+	secp256k1_scratch_space *scratchSpace = getSecp256k1ScratchSpace(SECP256K1_SCRATCH_SPACE_LENGTH * numberOfSignatures);
+	if(!scratchSpace) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Return if signatures are valid
+	return secp256k1_schnorrsig_verify_batch(secp256k1Context.get(), scratchSpace, reinterpret_cast<const secp256k1_schnorrsig *const *>(signatures), messages, publicKeys, numberOfSignatures);
+}
+
+// Get secp256k1 scratch space with length
+secp256k1_scratch_space *Crypto::getSecp256k1ScratchSpace(const size_t length) {
+
+	// Check if secp256k1 scratch space isn't large enough
+	if(!secp256k1ScratchSpace || secp256k1ScratchSpaceLength < length) {
+	
+		// Check if creating secp256k1 scratch space with the length failed
+		unique_ptr<secp256k1_scratch_space, decltype(&secp256k1_scratch_space_destroy)> newSecp256k1ScratchSpace(secp256k1_scratch_space_create(secp256k1Context.get(), length), secp256k1_scratch_space_destroy);
+		if(!newSecp256k1ScratchSpace) {
+		
+			// Return null
+			return nullptr;
+		}
+		
+		// Replace secp256k1 scratch space with the new secp256k1 scratch space
+		secp256k1ScratchSpace = move(newSecp256k1ScratchSpace);
+		secp256k1ScratchSpaceLength = length;
+	}
+	
+	// Return secp256k1 scratch space
+	return secp256k1ScratchSpace.get();
+}
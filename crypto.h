@@ -21,7 +21,7 @@ namespace MwcValidationNode {
 class Header;
 
 // Merkle mountain range forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Kernel class forward declaration
 class Kernel;
@@ -56,6 +56,12 @@ class Crypto final {
 		// Single-signer signature length
 		static const size_t SINGLE_SIGNER_SIGNATURE_LENGTH = 64;
 		
+		// Bulletproofs batch size
+		static const size_t BULLETPROOFS_BATCH_SIZE;
+		
+		// Single-signer signatures batch size
+		static const size_t SINGLE_SIGNER_SIGNATURES_BATCH_SIZE;
+		
 		// Get secp256k1 context
 		static const secp256k1_context *getSecp256k1Context();
 		
@@ -67,6 +73,15 @@ class Crypto final {
 		
 		// Verify kernel sums
 		static bool verifyKernelSums(const Header &header, const MerkleMountainRange<Kernel> &kernels, const MerkleMountainRange<Output> &outputs);
+		
+		// Verify bulletproof
+		static bool verifyBulletproof(const secp256k1_pedersen_commitment &commitment, const uint8_t proof[BULLETPROOF_LENGTH]);
+		
+		// Verify bulletproofs
+		static bool verifyBulletproofs(const secp256k1_pedersen_commitment *const commitments[], const uint8_t *const proofs[], const size_t numberOfBulletproofs);
+		
+		// Verify single-signer signatures
+		static bool verifySingleSignerSignatures(const uint8_t *const signatures[], const uint8_t *const messages[], const secp256k1_pubkey *const publicKeys[], const size_t numberOfSignatures);
 	
 	// Private
 	private:
@@ -81,10 +96,16 @@ class Crypto final {
 		static const unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> secp256k1Context;
 		
 		// Secp256k1 scratch space
-		static thread_local const unique_ptr<secp256k1_scratch_space, decltype(&secp256k1_scratch_space_destroy)> secp256k1ScratchSpace;
+		static thread_local unique_ptr<secp256k1_scratch_space, decltype(&secp256k1_scratch_space_destroy)> secp256k1ScratchSpace;
+		
+		// Secp256k1 scratch space length
+		static thread_local size_t secp256k1ScratchSpaceLength;
 		
 		// Secp256k1 generators
 		static const unique_ptr<secp256k1_bulletproof_generators, void(*)(secp256k1_bulletproof_generators *)> secp256k1Generators;
+		
+		// Get secp256k1 scratch space with length
+		static secp256k1_scratch_space *getSecp256k1ScratchSpace(const size_t length);
 };
 
 
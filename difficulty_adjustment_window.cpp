@@ -0,0 +1,234 @@
+// Header files
+#include "./common.h"
+#include <cstring>
+#include "./consensus.h"
+#include "./difficulty_adjustment_window.h"
+#include "./saturate_math.h"
+
+using namespace std;
+
+
+// Namespace
+using namespace MwcValidationNode;
+
+
+// Supporting function implementation
+
+// Constructor
+DifficultyAdjustmentWindow::DifficultyAdjustmentWindow() :
+
+	// Set secondary scaling sum to zero
+	secondaryScalingSum(0),
+	
+	// Set difficulty sum to zero
+	difficultySum(0),
+	
+	// Set number of C29 headers to zero
+	numberOfC29Headers(0),
+	
+	// Set newest header height to zero
+	newestHeaderHeight(0),
+	
+	// Set newest header total difficulty to zero
+	newestHeaderTotalDifficulty(0),
+	
+	// Set newest header block hash to zero
+	newestHeaderBlockHash({})
+{
+}
+
+// Get target difficulty and secondary scaling
+pair<uint64_t, uint32_t> DifficultyAdjustmentWindow::getTargetDifficultyAndSecondaryScaling(const MerkleMountainRange<Header> &headers, const Header &previousHeader, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &previousBlockHash) {
+
+	// Update window to end at the previous header
+	update(headers, previousHeader, previousBlockHash);
+	
+	// Get next header height
+	const uint64_t nextHeaderHeight = SaturateMath::add(previousHeader.getHeight(), 1);
+	
+	// Get target C29 ratio
+	const uint64_t targetC29Ratio = Consensus::getC29ProofOfWorkRatio(nextHeaderHeight);
+	
+	// Get target number of C29 headers
+	const uint64_t targetNumberOfC29Headers = Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * targetC29Ratio;
+	
+	// Get C29 headers adjustment
+	const uint64_t c29HeadersAdjustment = Common::clamp(Common::damp(numberOfC29Headers * 100, targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_DAMP_FACTOR), targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_CLAMP_FACTOR);
+	
+	// Get target secondary scaling
+	const uint32_t targetSecondaryScaling = max(secondaryScalingSum * targetC29Ratio / max(static_cast<uint64_t>(1), c29HeadersAdjustment), static_cast<uint64_t>(Consensus::MINIMUM_SECONDARY_SCALING));
+	
+	// Set number of missing headers
+	const uint64_t numberOfMissingHeaders = (previousHeader.getHeight() < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW) ? Consensus::DIFFICULTY_ADJUSTMENT_WINDOW - previousHeader.getHeight() : 0;
+	
+	// Get last timestamp delta
+	const chrono::seconds lastTimestampDelta = (previousHeader.getHeight() != Consensus::GENESIS_BLOCK_HEADER.getHeight()) ? chrono::duration_cast<chrono::seconds>(previousHeader.getTimestamp() - headers.getLeaf(previousHeader.getHeight() - 1)->getTimestamp()) : Consensus::BLOCK_TIME;
+	
+	// Initialize window start timestamp
+	chrono::time_point<chrono::system_clock> windowStartTimestamp;
+	
+	// Check if headers are missing from the window
+	if(numberOfMissingHeaders) {
+	
+		// Check if window start timestamp won't underflow
+		if(lastTimestampDelta * numberOfMissingHeaders <= chrono::duration_cast<chrono::seconds>(Consensus::GENESIS_BLOCK_HEADER.getTimestamp().time_since_epoch())) {
+		
+			// Set window start timestamp to the timestamp of the first missing block in the window
+			windowStartTimestamp = Consensus::GENESIS_BLOCK_HEADER.getTimestamp() - lastTimestampDelta * numberOfMissingHeaders;
+		}
+		
+		// Otherwise
+		else {
+		
+			// Set window start timestamp to zero
+			windowStartTimestamp = chrono::time_point<chrono::system_clock>(chrono::seconds(0));
+		}
+	}
+	
+	// Otherwise
+	else {
+	
+		// Set window start timestamp to the timestamp of the first header in the window
+		windowStartTimestamp = headers.getLeaf(previousHeader.getHeight() - Consensus::DIFFICULTY_ADJUSTMENT_WINDOW)->getTimestamp();
+	}
+	
+	// Get window duration
+	const chrono::seconds windowDuration = chrono::duration_cast<chrono::seconds>(previousHeader.getTimestamp() - windowStartTimestamp);
+	
+	// Get window duration adjustment
+	const uint64_t windowDurationAdjustment = Common::clamp(Common::damp(windowDuration.count(), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_DAMP_FACTOR), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_CLAMP_FACTOR);
+	
+	// Get target difficulty
+	const uint64_t targetDifficulty = max(Consensus::MINIMUM_DIFFICULTY, difficultySum * Consensus::BLOCK_TIME.count() / windowDurationAdjustment);
+	
+	// Return target difficulty and target secondary scaling
+	return {targetDifficulty, targetSecondaryScaling};
+}
+
+// Clear
+void DifficultyAdjustmentWindow::clear() {
+
+	// Clear headers
+	headers.clear();
+	
+	// Set secondary scaling sum to zero
+	secondaryScalingSum = 0;
+	
+	// Set difficulty sum to zero
+	difficultySum = 0;
+	
+	// Set number of C29 headers to zero
+	numberOfC29Headers = 0;
+}
+
+// Update
+void DifficultyAdjustmentWindow::update(const MerkleMountainRange<Header> &headers, const Header &previousHeader, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &previousBlockHash) {
+
+	// Check if window already ends at the previous header
+	if(!this->headers.empty() && previousHeader.getHeight() == newestHeaderHeight && previousBlockHash == newestHeaderBlockHash) {
+	
+		// Return
+		return;
+	}
+	
+	// Check if the previous header directly follows the newest header in the window and the window doesn't contain any headers before the genesis block
+	if(!this->headers.empty() && previousHeader.getHeight() == SaturateMath::add(newestHeaderHeight, 1) && previousHeader.getHeight() >= Consensus::DIFFICULTY_ADJUSTMENT_WINDOW && !memcmp(previousHeader.getPreviousBlockHash(), newestHeaderBlockHash.data(), newestHeaderBlockHash.size())) {
+	
+		// Remove oldest header's secondary scaling from the secondary scaling sum
+		secondaryScalingSum -= get<0>(this->headers.front());
+		
+		// Remove oldest header's difficulty from the difficulty sum
+		difficultySum -= get<1>(this->headers.front());
+		
+		// Remove oldest header from the number of C29 headers
+		numberOfC29Headers -= get<2>(this->headers.front());
+		
+		// Remove oldest header from the window
+		this->headers.pop_front();
+		
+		// Add previous header to the window
+		this->headers.emplace_back(previousHeader.getSecondaryScaling(), previousHeader.getTotalDifficulty() - newestHeaderTotalDifficulty, previousHeader.getEdgeBits() == Consensus::C29_EDGE_BITS);
+		
+		// Add previous header's secondary scaling to the secondary scaling sum
+		secondaryScalingSum += get<0>(this->headers.back());
+		
+		// Add previous header's difficulty to the difficulty sum
+		difficultySum += get<1>(this->headers.back());
+		
+		// Add previous header to the number of C29 headers
+		numberOfC29Headers += get<2>(this->headers.back());
+	}
+	
+	// Otherwise
+	else {
+	
+		// Recalculate window from the headers
+		recalculate(headers, previousHeader);
+	}
+	
+	// Set newest header height to the previous header's height
+	newestHeaderHeight = previousHeader.getHeight();
+	
+	// Set newest header total difficulty to the previous header's total difficulty
+	newestHeaderTotalDifficulty = previousHeader.getTotalDifficulty();
+	
+	// Set newest header block hash to the previous block hash
+	newestHeaderBlockHash = previousBlockHash;
+}
+
+// Recalculate
+void DifficultyAdjustmentWindow::recalculate(const MerkleMountainRange<Header> &headers, const Header &previousHeader) {
+
+	// Clear window
+	clear();
+	
+	// Go through all previous headers in the difficulty adjustment window
+	for(uint64_t i = 0; i < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW; ++i) {
+	
+		// Get header's secondary scaling
+		const uint32_t secondaryScaling = (i <= previousHeader.getHeight()) ? headers.getLeaf(previousHeader.getHeight() - i)->getSecondaryScaling() : Consensus::GENESIS_BLOCK_HEADER.getSecondaryScaling();
+		
+		// Initialize difficulty
+		uint64_t difficulty;
+		
+		// Check if previous header exists
+		if(i <= previousHeader.getHeight()) {
+		
+			// Check if header before the previous header exists
+			if(i + 1 <= previousHeader.getHeight()) {
+			
+				// Set difficulty to the header's difficulty
+				difficulty = headers.getLeaf(previousHeader.getHeight() - i)->getTotalDifficulty() - headers.getLeaf(previousHeader.getHeight() - (i + 1))->getTotalDifficulty();
+			}
+			
+			// Otherwise
+			else {
+			
+				// Set difficulty to the header's difficulty
+				difficulty = headers.getLeaf(previousHeader.getHeight() - i)->getTotalDifficulty();
+			}
+		}
+		
+		// Otherwise
+		else {
+		
+			// Set difficulty to the previous header's difficulty
+			difficulty = previousHeader.getTotalDifficulty() - (previousHeader.getHeight() ? headers.getLeaf(previousHeader.getHeight() - 1)->getTotalDifficulty() : 0);
+		}
+		
+		// Get if header uses C29 proof of work
+		const bool isC29 = ((i <= previousHeader.getHeight()) ? headers.getLeaf(previousHeader.getHeight() - i)->getEdgeBits() : Consensus::GENESIS_BLOCK_HEADER.getEdgeBits()) == Consensus::C29_EDGE_BITS;
+		
+		// Add header to the start of the window
+		this->headers.emplace_front(secondaryScaling, difficulty, isC29);
+		
+		// Add header's secondary scaling to the secondary scaling sum
+		secondaryScalingSum += secondaryScaling;
+		
+		// Add header's difficulty to the difficulty sum
+		difficultySum += difficulty;
+		
+		// Add header to the number of C29 headers
+		numberOfC29Headers += isC29;
+	}
+}
@@ -0,0 +1,74 @@
+// Header guard
+#ifndef MWC_VALIDATION_NODE_DIFFICULTY_ADJUSTMENT_WINDOW_H
+#define MWC_VALIDATION_NODE_DIFFICULTY_ADJUSTMENT_WINDOW_H
+
+
+// Header files
+#include "./common.h"
+#include <array>
+#include "./crypto.h"
+#include <deque>
+#include "./header.h"
+#include "./merkle_mountain_range.h"
+#include <tuple>
+
+using namespace std;
+
+
+// Namespace
+namespace MwcValidationNode {
+
+
+// Classes
+
+// Difficulty adjustment window class
+class DifficultyAdjustmentWindow final {
+
+	// Public
+	public:
+	
+		// Constructor
+		DifficultyAdjustmentWindow();
+		
+		// Get target difficulty and secondary scaling
+		pair<uint64_t, uint32_t> getTargetDifficultyAndSecondaryScaling(const MerkleMountainRange<Header> &headers, const Header &previousHeader, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &previousBlockHash);
+		
+	// Private
+	private:
+	
+		// Clear
+		void clear();
+		
+		// Update
+		void update(const MerkleMountainRange<Header> &headers, const Header &previousHeader, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &previousBlockHash);
+		
+		// Recalculate
+		void recalculate(const MerkleMountainRange<Header> &headers, const Header &previousHeader);
+		
+		// Headers
+		deque<tuple<uint32_t, uint64_t, bool>> headers;
+		
+		// Secondary scaling sum
+		uint64_t secondaryScalingSum;
+		
+		// Difficulty sum
+		uint64_t difficultySum;
+		
+		// Number of C29 headers
+		uint64_t numberOfC29Headers;
+		
+		// Newest header height
+		uint64_t newestHeaderHeight;
+		
+		// Newest header total difficulty
+		uint64_t newestHeaderTotalDifficulty;
+		
+		// Newest header block hash
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> newestHeaderBlockHash;
+};
+
+
+}
+
+
+#endif
@@ -144,21 +144,8 @@ const uint64_t *Header::getProofNonces() const {
 }
 
 // Get block hash
-array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> Header::getBlockHash() const {
+const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &Header::getBlockHash() const {
 
-	// Initialize block hash
-	array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> blockHash;
-	
-	// Get proof nonces bytes
-	const vector<uint8_t> proofNoncesBytes = getProofNoncesBytes();
-	
-	// Check if getting block hash failed
-	if(blake2b(blockHash.data(), blockHash.size(), proofNoncesBytes.data(), proofNoncesBytes.size(), nullptr, 0)) {
-	
-		// Throw error
-		throw runtime_error("Getting block hash failed");
-	}
-	
 	// Return block hash
 	return blockHash;
 }
@@ -233,6 +220,9 @@ bool Header::setProofOfWork(const uint64_t nonce, const uint8_t edgeBits, const
 			// Set proof nonces to proof nonces
 			memcpy(this->proofNonces, proofNonces, sizeof(this->proofNonces));
 			
+			// Update block hash
+			updateBlockHash();
+			
 			// Return true
 			return true;
 		}
@@ -371,6 +361,14 @@ bool Header::operator!=(const Header &other) const {
 // Constructor
 Header::Header(const uint16_t version, const uint64_t height, const chrono::time_point<chrono::system_clock> &timestamp, const uint8_t previousBlockHash[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t previousHeaderRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t outputRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t rangeproofRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t kernelRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], const uint64_t outputMerkleMountainRangeSize, const uint64_t kernelMerkleMountainRangeSize, const uint64_t totalDifficulty, const uint32_t secondaryScaling, const uint64_t nonce, const uint8_t edgeBits, const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES], const bool verify) :
 
+	// Delegate constructor
+	Header(version, height, timestamp, previousBlockHash, previousHeaderRoot, outputRoot, rangeproofRoot, kernelRoot, totalKernelOffset, outputMerkleMountainRangeSize, kernelMerkleMountainRangeSize, totalDifficulty, secondaryScaling, nonce, edgeBits, proofNonces, verify, verify)
+{
+}
+
+// Constructor
+Header::Header(const uint16_t version, const uint64_t height, const chrono::time_point<chrono::system_clock> &timestamp, const uint8_t previousBlockHash[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t previousHeaderRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t outputRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t rangeproofRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t kernelRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], const uint64_t outputMerkleMountainRangeSize, const uint64_t kernelMerkleMountainRangeSize, const uint64_t totalDifficulty, const uint32_t secondaryScaling, const uint64_t nonce, const uint8_t edgeBits, const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES], const bool verify, const bool verifyProofOfWork) :
+
 	// Set version to version
 	version(version),
 	
@@ -488,11 +486,14 @@ Header::Header(const uint16_t version, const uint64_t height, const chrono::time
 	// Set proof nonces to proof nonces
 	memcpy(this->proofNonces, proofNonces, sizeof(this->proofNonces));
 	
+	// Update block hash
+	updateBlockHash();
+	
 	// Check if verifying
 	if(verify) {
 	
-		// Check if proof of work is invalid
-		if(height != Consensus::GENESIS_BLOCK_HEADER.height && !ProofOfWork::hasValidProofOfWork(*this)) {
+		// Check if verifying proof of work and proof of work is invalid
+		if(verifyProofOfWork && height != Consensus::GENESIS_BLOCK_HEADER.height && !ProofOfWork::hasValidProofOfWork(*this)) {
 		
 			// Throw exception
 			throw runtime_error("Proof of work is invalid");
@@ -517,12 +518,52 @@ Header::Header(const uint16_t version, const uint64_t height, const chrono::time
 // Serialize
 vector<uint8_t> Header::serialize() const {
 
+	// Initialize serialized header
+	vector<uint8_t> serializedHeader;
+	
+	// Serialize header into the serialized header
+	serialize(serializedHeader);
+	
 	// Return serialized header
-	return getProofNoncesBytes();
+	return serializedHeader;
+}
+
+// Serialize
+void Header::serialize(vector<uint8_t> &buffer) const {
+
+	// Set number of proof nonces bytes
+	const uint64_t numberOfProofNoncesBytes = Common::numberOfBytesRequired(edgeBits * (sizeof(proofNonces) / sizeof(proofNonces[0])));
+	
+	// Get proof nonces bytes offset in the buffer
+	const vector<uint8_t>::size_type proofNoncesBytesOffset = buffer.size();
+	
+	// Append zeroed proof nonces bytes to the buffer
+	buffer.resize(proofNoncesBytesOffset + numberOfProofNoncesBytes, 0);
+	
+	// Go through all proof nonces
+	for(size_t i = 0; i < sizeof(proofNonces) / sizeof(proofNonces[0]); ++i) {
+	
+		// Get proof nonce
+		const uint64_t &proofNonce = proofNonces[i];
+	
+		// Go through all edge bits
+		for(uint8_t j = 0; j < edgeBits; ++j) {
+		
+			// Check if bit is set in the proof nonce
+			if(proofNonce & (static_cast<uint64_t>(1) << j)) {
+			
+				// Set bit position
+				const uint64_t bitPosition = i * edgeBits + j;
+				
+				// Set bit in the proof nonces bytes
+				buffer[proofNoncesBytesOffset + bitPosition / Common::BITS_IN_A_BYTE] |= 1 << (bitPosition % Common::BITS_IN_A_BYTE);
+			}
+		}
+	}
 }
 
 // Save
-void Header::save(ofstream &file) const {
+void Header::save(ostream &file) const {
 
 	// Write version to file
 	const uint16_t serializedVersion = htons(version);
@@ -588,24 +629,24 @@ void Header::save(ofstream &file) const {
 }
 
 // Restore
-Header Header::restore(ifstream &file) {
+Header Header::restore(istream &file) {
 
 	// Return header created from file
 	return Header(file);
 }
 
 // Save sum
-void Header::saveSum(const int &sum, ofstream &file) {
+void Header::saveSum(const int &sum, ostream &file) {
 
 }
 
 // Restore sum
-void Header::restoreSum(int &sum, ifstream &file) {
+void Header::restoreSum(int &sum, istream &file) {
 
 }
 
 // Constructor
-Header::Header(ifstream &file) {
+Header::Header(istream &file) {
 
 	// Read version from file
 	uint16_t serializedVersion;
@@ -677,38 +718,21 @@ Header::Header(ifstream &file) {
 		file.read(reinterpret_cast<char *>(&serializedProofNonce), sizeof(serializedProofNonce));
 		proofNonces[i] = Common::bigEndianToHostByteOrder(serializedProofNonce);
 	}
+	
+	// Update block hash
+	updateBlockHash();
 }
 
-// Get proof nonces bytes
-vector<uint8_t> Header::getProofNoncesBytes() const {
+// Update block hash
+void Header::updateBlockHash() {
 
-	// Set number of proof nonces bytes
-	const uint64_t numberOfProofNoncesBytes = Common::numberOfBytesRequired(edgeBits * (sizeof(proofNonces) / sizeof(proofNonces[0])));
-	
-	// Initialize proof nonces bytes
-	vector<uint8_t> proofNoncesBytes(numberOfProofNoncesBytes);
+	// Get serialized header
+	const vector<uint8_t> serializedHeader = serialize();
 	
-	// Go through all proof nonces
-	for(size_t i = 0; i < sizeof(proofNonces) / sizeof(proofNonces[0]); ++i) {
-	
-		// Get proof nonce
-		const uint64_t &proofNonce = proofNonces[i];
+	// Check if getting block hash failed
+	if(blake2b(blockHash.data(), blockHash.size(), serializedHeader.data(), serializedHeader.size(), nullptr, 0)) {
 	
-		// Go through all edge bits
-		for(uint8_t j = 0; j < edgeBits; ++j) {
-		
-			// Check if bit is set in the proof nonce
-			if(proofNonce & (static_cast<uint64_t>(1) << j)) {
-			
-				// Set bit position
-				const uint64_t bitPosition = i * edgeBits + j;
-				
-				// Set bit in the proof nonces bytes
-				proofNoncesBytes[bitPosition / Common::BITS_IN_A_BYTE] |= 1 << (bitPosition % Common::BITS_IN_A_BYTE);
-			}
-		}
+		// Throw error
+		throw runtime_error("Getting block hash failed");
 	}
-	
-	// Return proof nonces bytes
-	return proofNoncesBytes;
 }
@@ -21,8 +21,11 @@ namespace MwcValidationNode {
 // Node class forward declaration
 class Node;
 
+// Message class forward declaration
+class Message;
+
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Header structure
 class Header final : public MerkleMountainRangeLeaf<Header> {
@@ -82,7 +85,7 @@ class Header final : public MerkleMountainRangeLeaf<Header> {
 		const uint64_t *getProofNonces() const;
 		
 		// Get block hash
-		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> getBlockHash() const;
+		const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &getBlockHash() const;
 		
 		// Get pre-proof of work
 		vector<uint8_t> getPreProofOfWork() const;
@@ -105,26 +108,38 @@ class Header final : public MerkleMountainRangeLeaf<Header> {
 		// Constructor
 		explicit Header(const uint16_t version, const uint64_t height, const chrono::time_point<chrono::system_clock> &timestamp, const uint8_t previousBlockHash[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t previousHeaderRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t outputRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t rangeproofRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t kernelRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], const uint64_t outputMerkleMountainRangeSize, const uint64_t kernelMerkleMountainRangeSize, const uint64_t totalDifficulty, const uint32_t secondaryScaling, const uint64_t nonce, const uint8_t edgeBits, const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES], const bool verify);
 		
+	// Public for message class
+	private:
+	
+		// Message friend class
+		friend class Message;
+		
+		// Constructor
+		explicit Header(const uint16_t version, const uint64_t height, const chrono::time_point<chrono::system_clock> &timestamp, const uint8_t previousBlockHash[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t previousHeaderRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t outputRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t rangeproofRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t kernelRoot[Crypto::BLAKE2B_HASH_LENGTH], const uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], const uint64_t outputMerkleMountainRangeSize, const uint64_t kernelMerkleMountainRangeSize, const uint64_t totalDifficulty, const uint32_t secondaryScaling, const uint64_t nonce, const uint8_t edgeBits, const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES], const bool verify, const bool verifyProofOfWork);
+		
 	// Public for Merkle mountain range class
 	private:
 	
 		// Merkle mountain range friend class
-		friend class MerkleMountainRange<Header>;
+		template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> friend class MerkleMountainRange;
 		
 		// Serialize
 		virtual vector<uint8_t> serialize() const override final;
 		
+		// Serialize
+		void serialize(vector<uint8_t> &buffer) const;
+		
 		// Save
-		virtual void save(ofstream &file) const override final;
+		virtual void save(ostream &file) const override final;
 		
 		// Restore
-		static Header restore(ifstream &file);
+		static Header restore(istream &file);
 		
 		// Save sum
-		static void saveSum(const int &sum, ofstream &file);
+		static void saveSum(const int &sum, ostream &file);
 		
 		// Restore sum
-		static void restoreSum(int &sum, ifstream &file);
+		static void restoreSum(int &sum, istream &file);
 		
 	// Private
 	private:
@@ -133,10 +148,10 @@ class Header final : public MerkleMountainRangeLeaf<Header> {
 		static const uint64_t FUTURE_NUMBER_OF_BLOCKS_THRESHOLD;
 		
 		// Constructor
-		explicit Header(ifstream &file);
+		explicit Header(istream &file);
 		
-		// Get proof nonces bytes
-		vector<uint8_t> getProofNoncesBytes() const;
+		// Update block hash
+		void updateBlockHash();
 
 		// Version
 		uint16_t version;
@@ -185,6 +200,9 @@ class Header final : public MerkleMountainRangeLeaf<Header> {
 		
 		// Proof nonces
 		uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES];
+		
+		// Block hash
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> blockHash;
 };
 
 
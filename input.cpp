@@ -49,10 +49,10 @@ const secp256k1_pedersen_commitment &Input::getCommitment() const {
 }
 
 // Get lookup value
-vector<uint8_t> Input::getLookupValue() const {
+array<uint8_t, Crypto::COMMITMENT_LENGTH> Input::getLookupValue() const {
 
 	// Check if serializing commitment failed
-	vector<uint8_t> serializedCommitment(Crypto::COMMITMENT_LENGTH);
+	array<uint8_t, Crypto::COMMITMENT_LENGTH> serializedCommitment;
 	if(!secp256k1_pedersen_commitment_serialize(secp256k1_context_no_precomp, serializedCommitment.data(), &commitment)) {
 	
 		// Throw exception
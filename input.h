@@ -61,7 +61,7 @@ class Input final {
 		const secp256k1_pedersen_commitment &getCommitment() const;
 		
 		// Get lookup value
-		vector<uint8_t> getLookupValue() const;
+		array<uint8_t, Crypto::COMMITMENT_LENGTH> getLookupValue() const;
 		
 	// Public for node class
 	private:
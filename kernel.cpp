@@ -4,6 +4,7 @@
 #include "blake2.h"
 #include "./consensus.h"
 #include "./kernel.h"
+#include "./merkle_mountain_range.h"
 #include "secp256k1_aggsig.h"
 #include "secp256k1_commitment.h"
 
@@ -145,10 +146,10 @@ bool Kernel::operator!=(const Kernel &other) const {
 }
 
 // Get lookup value
-optional<vector<uint8_t>> Kernel::getLookupValue() const {
+optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> Kernel::getLookupValue() const {
 
 	// Check if serializing excess failed
-	vector<uint8_t> serializedExcess(Crypto::COMMITMENT_LENGTH);
+	array<uint8_t, Crypto::COMMITMENT_LENGTH> serializedExcess;
 	if(!secp256k1_pedersen_commitment_serialize(secp256k1_context_no_precomp, serializedExcess.data(), &excess)) {
 	
 		// Throw exception
@@ -293,7 +294,7 @@ void Kernel::subtractFromSum(secp256k1_pedersen_commitment &sum, const Subtracti
 }
 
 // Save
-void Kernel::save(ofstream &file) const {
+void Kernel::save(ostream &file) const {
 
 	// Write features to file
 	file.write(reinterpret_cast<const char *>(&features), sizeof(features));
@@ -326,14 +327,14 @@ void Kernel::save(ofstream &file) const {
 }
 
 // Restore
-Kernel Kernel::restore(ifstream &file) {
+Kernel Kernel::restore(istream &file) {
 
 	// Return kernel created from file
 	return Kernel(file);
 }
 
 // Save sum
-void Kernel::saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file) {
+void Kernel::saveSum(const secp256k1_pedersen_commitment &sum, ostream &file) {
 
 	// Check if sum isn't zero
 	uint8_t serializedSum[Crypto::COMMITMENT_LENGTH] = {};
@@ -356,7 +357,7 @@ void Kernel::saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file) {
 }
 
 // Restore sum
-void Kernel::restoreSum(secp256k1_pedersen_commitment &sum, ifstream &file) {
+void Kernel::restoreSum(secp256k1_pedersen_commitment &sum, istream &file) {
 
 	// Read sum from file
 	uint8_t serializedSum[Crypto::COMMITMENT_LENGTH];
@@ -619,7 +620,28 @@ pair<Kernel, array<uint8_t, Kernel::MAXIMUM_SERIALIZED_LENGTH>::size_type> Kerne
 	const uint8_t *signature = &serializedKernel[sizeof(features) + featuresSize + Crypto::COMMITMENT_LENGTH];
 	
 	// Return kernel
-	return {Kernel(features, fee, lockHeight, relativeHeight, excess, signature, isGenesisBlockKernel), sizeof(features) + featuresSize + Crypto::COMMITMENT_LENGTH + Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH};
+	return {Kernel(features, fee, lockHeight, relativeHeight, excess, signature, isGenesisBlockKernel, false), sizeof(features) + featuresSize + Crypto::COMMITMENT_LENGTH + Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH};
+}
+
+// Verify unserialized
+bool Kernel::verifyUnserialized(const MerkleMountainRange<Kernel> &kernels) {
+
+	// Initialize unverified kernels
+	vector<const Kernel *> unverifiedKernels;
+	
+	// Go through all kernels
+	for(MerkleMountainRange<Kernel>::const_iterator i = kernels.cbegin(); i != kernels.cend(); ++i) {
+	
+		// Check if kernel isn't the genesis block kernel
+		if(i->first || i->second != Consensus::GENESIS_BLOCK_KERNEL) {
+		
+			// Append kernel to list
+			unverifiedKernels.push_back(&i->second);
+		}
+	}
+	
+	// Return if kernels' signatures are valid
+	return verifySignatures(unverifiedKernels);
 }
 
 // Serialize
@@ -683,7 +705,7 @@ vector<uint8_t> Kernel::serialize() const {
 }
 
 // Constructor
-Kernel::Kernel(const Features features, const uint64_t fee, const uint64_t lockHeight, const uint64_t relativeHeight, const uint8_t excess[Crypto::COMMITMENT_LENGTH], const uint8_t signature[Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH], const bool isGenesisBlockKernel) :
+Kernel::Kernel(const Features features, const uint64_t fee, const uint64_t lockHeight, const uint64_t relativeHeight, const uint8_t excess[Crypto::COMMITMENT_LENGTH], const uint8_t signature[Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH], const bool isGenesisBlockKernel, const bool verifySignature) :
 
 	// Set features to features
 	features(features),
@@ -815,7 +837,7 @@ Kernel::Kernel(const Features features, const uint64_t fee, const uint64_t lockH
 	}
 	
 	// Check if signature isn't for the kernel
-	if(!isGenesisBlockKernel && !secp256k1_aggsig_verify_single(Crypto::getSecp256k1Context(), signature, getMessageToSign().data(), nullptr, &publicKey, &publicKey, nullptr, false)) {
+	if(!isGenesisBlockKernel && verifySignature && !secp256k1_aggsig_verify_single(Crypto::getSecp256k1Context(), signature, getMessageToSign().data(), nullptr, &publicKey, &publicKey, nullptr, false)) {
 	
 		// Throw exception
 		throw runtime_error("Signature isn't for the kernel");
@@ -832,8 +854,66 @@ Kernel::Kernel(const Features features, const uint64_t fee, const uint64_t lockH
 	}
 }
 
+// Verify signatures
+bool Kernel::verifySignatures(const vector<const Kernel *> &kernels) {
+
+	// Go through all batches of kernels
+	for(vector<const Kernel *>::size_type i = 0; i < kernels.size(); i += Crypto::SINGLE_SIGNER_SIGNATURES_BATCH_SIZE) {
+	
+		// Get number of kernels in the batch
+		const vector<const Kernel *>::size_type batchSize = min(kernels.size() - i, Crypto::SINGLE_SIGNER_SIGNATURES_BATCH_SIZE);
+		
+		// Initialize batch's messages, public keys, and signatures
+		vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> messages(batchSize);
+		vector<secp256k1_pubkey> publicKeys(batchSize);
+		vector<const uint8_t *> messagesPointers(batchSize);
+		vector<const secp256k1_pubkey *> publicKeysPointers(batchSize);
+		vector<const uint8_t *> signatures(batchSize);
+		
+		// Go through all kernels in the batch
+		for(vector<const Kernel *>::size_type j = 0; j < batchSize; ++j) {
+		
+			// Get kernel
+			const Kernel &kernel = *kernels[i + j];
+			
+			// Check if excess isn't a valid public key
+			if(!secp256k1_pedersen_commitment_to_pubkey(secp256k1_context_no_precomp, &publicKeys[j], &kernel.excess)) {
+			
+				// Return false
+				return false;
+			}
+			
+			// Set message to the kernel's message to sign
+			messages[j] = kernel.getMessageToSign();
+			
+			// Set pointers to the message, public key, and signature
+			messagesPointers[j] = messages[j].data();
+			publicKeysPointers[j] = &publicKeys[j];
+			signatures[j] = kernel.signature;
+		}
+		
+		// Check if the batch's signatures aren't for the kernels
+		if(!Crypto::verifySingleSignerSignatures(signatures.data(), messagesPointers.data(), publicKeysPointers.data(), batchSize)) {
+		
+			// Go through all kernels in the batch
+			for(vector<const Kernel *>::size_type j = 0; j < batchSize; ++j) {
+			
+				// Check if signature isn't for the kernel
+				if(!secp256k1_aggsig_verify_single(Crypto::getSecp256k1Context(), signatures[j], messagesPointers[j], nullptr, &publicKeys[j], &publicKeys[j], nullptr, false)) {
+				
+					// Return false
+					return false;
+				}
+			}
+		}
+	}
+	
+	// Return true
+	return true;
+}
+
 // Constructor
-Kernel::Kernel(ifstream &file) {
+Kernel::Kernel(istream &file) {
 
 	// Read features from file
 	file.read(reinterpret_cast<char *>(&features), sizeof(features));
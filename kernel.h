@@ -18,7 +18,7 @@ namespace MwcValidationNode {
 // Classes
 
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Node class forward declaration
 class Node;
@@ -32,6 +32,9 @@ class Transaction;
 // Consensus class forward declaration
 class Consensus;
 
+// Message class forward declaration
+class Message;
+
 // Kernel class
 class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint64_t) + Crypto::COMMITMENT_LENGTH + Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH, secp256k1_pedersen_commitment, true> {
 
@@ -88,13 +91,13 @@ class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + si
 		bool operator!=(const Kernel &other) const;
 		
 		// Get lookup value
-		virtual optional<vector<uint8_t>> getLookupValue() const override final;
+		virtual optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> getLookupValue() const override final;
 	
 	// Public for Merkle mountain range class
 	private:
 	
 		// Merkle mountain range friend class
-		friend class MerkleMountainRange<Kernel>;
+		template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> friend class MerkleMountainRange;
 		
 		// Add to sum
 		virtual void addToSum(secp256k1_pedersen_commitment &sum, const AdditionReason additionReason) const override final;
@@ -103,16 +106,16 @@ class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + si
 		virtual void subtractFromSum(secp256k1_pedersen_commitment &sum, const SubtractionReason subtractionReason) const override final;
 		
 		// Save
-		virtual void save(ofstream &file) const override final;
+		virtual void save(ostream &file) const override final;
 		
 		// Restore
-		static Kernel restore(ifstream &file);
+		static Kernel restore(istream &file);
 		
 		// Save sum
-		static void saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file);
+		static void saveSum(const secp256k1_pedersen_commitment &sum, ostream &file);
 		
 		// Restore sum
-		static void restoreSum(secp256k1_pedersen_commitment &sum, ifstream &file);
+		static void restoreSum(secp256k1_pedersen_commitment &sum, istream &file);
 		
 		// Get serialized protocol version
 		static uint32_t getSerializedProtocolVersion(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedKernel, const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedKernelLength, const uint32_t protocolVersion);
@@ -120,6 +123,9 @@ class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + si
 		// Unserialize
 		static pair<Kernel, array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type> unserialize(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedKernel, const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedKernelLength, const uint32_t protocolVersion, const bool isGenesisBlockKernel);
 		
+		// Verify unserialized
+		static bool verifyUnserialized(const MerkleMountainRange<Kernel> &kernels);
+		
 	// Public for node, block, and transaction classes
 	private:
 	
@@ -131,14 +137,18 @@ class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + si
 		// Serialize
 		virtual vector<uint8_t> serialize() const override final;
 		
-	// Public for consensus class
+	// Public for consensus and message classes
 	private:
 	
-		// Consensus friend class
+		// Consensus and message friend classes
 		friend class Consensus;
+		friend class Message;
 		
 		// Constructor
-		explicit Kernel(const Features features, const uint64_t fee, const uint64_t lockHeight, const uint64_t relativeHeight, const uint8_t excess[Crypto::COMMITMENT_LENGTH], const uint8_t signature[Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH], const bool isGenesisBlockKernel);
+		explicit Kernel(const Features features, const uint64_t fee, const uint64_t lockHeight, const uint64_t relativeHeight, const uint8_t excess[Crypto::COMMITMENT_LENGTH], const uint8_t signature[Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH], const bool isGenesisBlockKernel, const bool verifySignature = true);
+		
+		// Verify signatures
+		static bool verifySignatures(const vector<const Kernel *> &kernels);
 			
 	// Private
 	private:
@@ -147,7 +157,7 @@ class Kernel final : public MerkleMountainRangeLeaf<Kernel, sizeof(uint8_t) + si
 		static const uint64_t MAXIMUM_RELATIVE_HEIGHT;
 		
 		// Constructor
-		explicit Kernel(ifstream &file);
+		explicit Kernel(istream &file);
 		
 		// Get message to sign
 		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> getMessageToSign() const;
@@ -66,21 +66,14 @@ int main() {
 		// Create node
 		MwcValidationNode::Node node;
 		
+		// Set node's checkpoint file to the state file
+		node.setCheckpointFile(STATE_FILE_NAME);
+		
 		// Try
 		try {
 		
-			// Set state file to throw exception on error
-			ifstream stateFile;
-			stateFile.exceptions(ios::badbit | ios::failbit);
-			
-			// Open state file
-			stateFile.open(STATE_FILE_NAME, ios::binary);
-			
-			// Restore node from state file
-			node.restore(stateFile);
-			
-			// Close state file
-			stateFile.close();
+			// Restore node from state file and its checkpoints
+			node.restoreCheckpoint();
 		}
 		
 		// Catch errors
@@ -169,18 +162,8 @@ int main() {
 		// Try
 		try {
 		
-			// Set state file to throw exception on error
-			ofstream stateFile;
-			stateFile.exceptions(ios::badbit | ios::failbit);
-			
-			// Open state file
-			stateFile.open(STATE_FILE_NAME, ios::binary | ios::trunc);
-			
 			// Save node to state file
-			node.save(stateFile);
-			
-			// Close state file
-			stateFile.close();
+			node.saveCheckpoint();
 		}
 		
 		// Catch errors
@@ -0,0 +1,117 @@
+// Header guard
+#ifndef MWC_VALIDATION_NODE_MEMORY_MAPPED_ALLOCATOR_H
+#define MWC_VALIDATION_NODE_MEMORY_MAPPED_ALLOCATOR_H
+
+
+// Header files
+#include "./common.h"
+#include <memory>
+#include "./memory_mapped_slots.h"
+
+using namespace std;
+
+
+// Namespace
+namespace MwcValidationNode {
+
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+// Classes
+
+// Memory mapped allocator class
+template<typename Type> class MemoryMappedAllocator {
+
+	// Public
+	public:
+	
+		// Value type
+		typedef Type value_type;
+		
+		// Constructor
+		MemoryMappedAllocator() = default;
+		
+		// Copy constructor
+		template<typename OtherType> MemoryMappedAllocator(const MemoryMappedAllocator<OtherType> &other);
+		
+		// Allocate
+		Type *allocate(const size_t number);
+		
+		// Deallocate
+		void deallocate(Type *value, const size_t number);
+		
+		// Equality operator
+		template<typename OtherType> bool operator==(const MemoryMappedAllocator<OtherType> &other) const;
+		
+	// Private
+	private:
+	
+		// Get slots
+		static MemoryMappedSlots &getSlots();
+};
+
+
+// Supporting function implementation
+
+// Copy constructor
+template<typename Type> template<typename OtherType> MemoryMappedAllocator<Type>::MemoryMappedAllocator(const MemoryMappedAllocator<OtherType> &other) {
+
+}
+
+// Allocate
+template<typename Type> Type *MemoryMappedAllocator<Type>::allocate(const size_t number) {
+
+	// Check if allocating a single value
+	if(number == 1) {
+	
+		// Return value in a slot in the file
+		return static_cast<Type *>(getSlots().allocate());
+	}
+	
+	// Return values on the heap since containers only allocate multiple values for their bucket arrays
+	return allocator<Type>().allocate(number);
+}
+
+// Deallocate
+template<typename Type> void MemoryMappedAllocator<Type>::deallocate(Type *value, const size_t number) {
+
+	// Check if deallocating a single value
+	if(number == 1) {
+	
+		// Free value's slot in the file
+		getSlots().deallocate(value);
+	}
+	
+	// Otherwise
+	else {
+	
+		// Free values on the heap
+		allocator<Type>().deallocate(value, number);
+	}
+}
+
+// Equality operator
+template<typename Type> template<typename OtherType> bool MemoryMappedAllocator<Type>::operator==(const MemoryMappedAllocator<OtherType> &other) const {
+
+	// Return true since all allocators share the same slots
+	return true;
+}
+
+// Get slots
+template<typename Type> MemoryMappedSlots &MemoryMappedAllocator<Type>::getSlots() {
+
+	// Get slots that fit the type
+	static MemoryMappedSlots &slots = MemoryMappedSlots::getSlots(sizeof(Type));
+	
+	// Return slots
+	return slots;
+}
+
+#endif
+
+
+}
+
+
+#endif
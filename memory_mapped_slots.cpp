@@ -0,0 +1,238 @@
+// Header files
+#include "./common.h"
+#include <map>
+#include <memory>
+#include "./memory_mapped_slots.h"
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+	// Header files
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+// Namespace
+using namespace MwcValidationNode;
+
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+// Constants
+
+// Mapping length
+const size_t MemoryMappedSlots::MAPPING_LENGTH = 1024 * 1024;
+
+// Check if number of hot mappings is set
+#ifdef SET_NUMBER_OF_HOT_MEMORY_MAPPED_SLOTS_MAPPINGS
+
+	// Number of hot mappings
+	const size_t MemoryMappedSlots::NUMBER_OF_HOT_MAPPINGS = SET_NUMBER_OF_HOT_MEMORY_MAPPED_SLOTS_MAPPINGS;
+	
+// Otherwise
+#else
+
+	// Number of hot mappings
+	const size_t MemoryMappedSlots::NUMBER_OF_HOT_MAPPINGS = 16;
+#endif
+
+// Check if directory is set
+#ifdef SET_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES_DIRECTORY
+
+	// File name template
+	const char MemoryMappedSlots::FILE_NAME_TEMPLATE[] = SET_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES_DIRECTORY "/merkle_mountain_ranges.XXXXXX";
+	
+// Otherwise
+#else
+
+	// File name template
+	const char MemoryMappedSlots::FILE_NAME_TEMPLATE[] = "./merkle_mountain_ranges.XXXXXX";
+#endif
+
+
+// Global variables
+
+// File
+int MemoryMappedSlots::file = -1;
+
+// File length
+uint64_t MemoryMappedSlots::fileLength = 0;
+
+// File lock
+mutex MemoryMappedSlots::fileLock;
+
+
+// Supporting function implementation
+
+// Constructor
+MemoryMappedSlots::MemoryMappedSlots(const size_t slotLength) :
+
+	// Set slot length to slot length
+	slotLength(slotLength),
+	
+	// Set slots per mapping to the number of slots that fit in a mapping or one if the slot is longer than a mapping
+	slotsPerMapping(max(MAPPING_LENGTH / slotLength, static_cast<size_t>(1))),
+	
+	// Set mapping length to the length of the slots per mapping rounded up to the system page size
+	mappingLength((slotsPerMapping * slotLength + getSystemPageSize() - 1) / getSystemPageSize() * getSystemPageSize()),
+	
+	// Set number of used slots to zero
+	numberOfUsedSlots(0)
+{
+}
+
+// Get slots
+MemoryMappedSlots &MemoryMappedSlots::getSlots(const size_t slotLength) {
+
+	// Lock file
+	lock_guard lock(fileLock);
+	
+	// Get all slots and never destroy them since leaves and hashes in static objects may be freed after other static objects are destroyed
+	static map<size_t, unique_ptr<MemoryMappedSlots>> &allSlots = *new map<size_t, unique_ptr<MemoryMappedSlots>>();
+	
+	// Check if slots with the slot length don't exist
+	map<size_t, unique_ptr<MemoryMappedSlots>>::iterator slots = allSlots.find(slotLength);
+	if(slots == allSlots.end()) {
+	
+		// Create slots with the slot length
+		slots = allSlots.emplace(slotLength, unique_ptr<MemoryMappedSlots>(new MemoryMappedSlots(slotLength))).first;
+	}
+	
+	// Return slots
+	return *slots->second;
+}
+
+// Evict
+void MemoryMappedSlots::evict(void *address, const size_t length) {
+
+	// Check if Linux
+	#ifdef __linux__
+	
+		// Remove address from the resident memory since its contents are kept in the file
+		madvise(address, length, MADV_DONTNEED);
+		
+	// Otherwise
+	#else
+	
+		// Advise that the address won't be needed soon
+		posix_madvise(address, length, POSIX_MADV_DONTNEED);
+	#endif
+}
+
+// Allocate
+void *MemoryMappedSlots::allocate() {
+
+	// Lock
+	lock_guard guard(lock);
+	
+	// Check if a free slot exists
+	if(!freeSlots.empty()) {
+	
+		// Get the free slot
+		void *slot = freeSlots.back();
+		freeSlots.pop_back();
+		
+		// Return slot
+		return slot;
+	}
+	
+	// Check if all mappings are used
+	if(numberOfUsedSlots == mappings.size() * slotsPerMapping) {
+	
+		// Grow file by a mapping
+		const uint64_t offset = growFile(mappingLength);
+		
+		// Check if mapping the new part of the file failed
+		void *mapping = mmap(nullptr, mappingLength, PROT_READ | PROT_WRITE, MAP_SHARED, file, offset);
+		if(mapping == MAP_FAILED) {
+		
+			// Throw exception
+			throw runtime_error("Mapping the new part of the file failed");
+		}
+		
+		// Append mapping to list
+		mappings.push_back(static_cast<uint8_t *>(mapping));
+		
+		// Check if a mapping is no longer hot
+		if(mappings.size() > NUMBER_OF_HOT_MAPPINGS) {
+		
+			// Evict the mapping that's no longer hot from memory
+			evict(mappings[mappings.size() - 1 - NUMBER_OF_HOT_MAPPINGS], mappingLength);
+		}
+	}
+	
+	// Get the next unused slot
+	void *slot = mappings[numberOfUsedSlots / slotsPerMapping] + (numberOfUsedSlots % slotsPerMapping) * slotLength;
+	
+	// Increment number of used slots
+	++numberOfUsedSlots;
+	
+	// Return slot
+	return slot;
+}
+
+// Deallocate
+void MemoryMappedSlots::deallocate(void *slot) {
+
+	// Lock
+	lock_guard guard(lock);
+	
+	// Append slot to free slots
+	freeSlots.push_back(slot);
+}
+
+// Get system page size
+size_t MemoryMappedSlots::getSystemPageSize() {
+
+	// Get system page size
+	static const size_t systemPageSize = sysconf(_SC_PAGESIZE);
+	
+	// Return system page size
+	return systemPageSize;
+}
+
+// Grow file
+uint64_t MemoryMappedSlots::growFile(const size_t length) {
+
+	// Lock file
+	lock_guard lock(fileLock);
+	
+	// Check if file isn't open
+	if(file == -1) {
+	
+		// Check if creating file failed
+		char fileName[sizeof(FILE_NAME_TEMPLATE)];
+		memcpy(fileName, FILE_NAME_TEMPLATE, sizeof(FILE_NAME_TEMPLATE));
+		file = mkstemp(fileName);
+		if(file == -1) {
+		
+			// Throw exception
+			throw runtime_error("Creating file failed");
+		}
+		
+		// Remove file's name so that it's deleted when closed
+		unlink(fileName);
+	}
+	
+	// Check if growing file failed
+	if(ftruncate(file, fileLength + length)) {
+	
+		// Throw exception
+		throw runtime_error("Growing file failed");
+	}
+	
+	// Get offset of the new part of the file
+	const uint64_t offset = fileLength;
+	
+	// Update file length
+	fileLength += length;
+	
+	// Return offset
+	return offset;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Header guard
+#ifndef MWC_VALIDATION_NODE_MEMORY_MAPPED_SLOTS_H
+#define MWC_VALIDATION_NODE_MEMORY_MAPPED_SLOTS_H
+
+
+// Header files
+#include "./common.h"
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+
+// Namespace
+namespace MwcValidationNode {
+
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+// Classes
+
+// Memory mapped slots class
+class MemoryMappedSlots final {
+
+	// Public
+	public:
+	
+		// Copy constructor
+		MemoryMappedSlots(const MemoryMappedSlots &other) = delete;
+		
+		// Copy assignment operator
+		MemoryMappedSlots &operator=(const MemoryMappedSlots &other) = delete;
+		
+		// Get slots
+		static MemoryMappedSlots &getSlots(const size_t slotLength);
+		
+		// Evict
+		static void evict(void *address, const size_t length);
+		
+		// Allocate
+		void *allocate();
+		
+		// Deallocate
+		void deallocate(void *slot);
+		
+	// Private
+	private:
+	
+		// Constructor
+		explicit MemoryMappedSlots(const size_t slotLength);
+		
+		// Mapping length
+		static const size_t MAPPING_LENGTH;
+		
+		// Number of hot mappings
+		static const size_t NUMBER_OF_HOT_MAPPINGS;
+		
+		// File name template
+		static const char FILE_NAME_TEMPLATE[];
+		
+		// Get system page size
+		static size_t getSystemPageSize();
+		
+		// Grow file
+		static uint64_t growFile(const size_t length);
+		
+		// File
+		static int file;
+		
+		// File length
+		static uint64_t fileLength;
+		
+		// File lock
+		static mutex fileLock;
+		
+		// Slot length
+		const size_t slotLength;
+		
+		// Slots per mapping
+		const size_t slotsPerMapping;
+		
+		// Mapping length
+		const size_t mappingLength;
+		
+		// Lock
+		mutex lock;
+		
+		// Mappings
+		vector<uint8_t *> mappings;
+		
+		// Number of used slots
+		uint64_t numberOfUsedSlots;
+		
+		// Free slots
+		vector<void *> freeSlots;
+};
+
+#endif
+
+
+}
+
+
+#endif
@@ -1,6 +1,8 @@
 // Header files
 #include "./common.h"
+#include "./consensus.h"
 #include "./mempool.h"
+#include "./saturate_math.h"
 
 using namespace std;
 
@@ -9,20 +11,109 @@ using namespace std;
 using namespace MwcValidationNode;
 
 
+// Constants
+
+// Check if maximum mempool size is set
+#ifdef SET_MAXIMUM_MEMPOOL_SIZE
+
+	// Maximum size
+	const uint64_t Mempool::MAXIMUM_SIZE = SET_MAXIMUM_MEMPOOL_SIZE;
+	
+// Otherwise
+#else
+
+	// Maximum size
+	const uint64_t Mempool::MAXIMUM_SIZE = 100 * 1024 * 1024;
+#endif
+
+// Check if maximum mempool weight is set
+#ifdef SET_MAXIMUM_MEMPOOL_WEIGHT
+
+	// Maximum weight
+	const uint64_t Mempool::MAXIMUM_WEIGHT = SET_MAXIMUM_MEMPOOL_WEIGHT;
+	
+// Otherwise
+#else
+
+	// Maximum weight (one hundred maximum weight blocks)
+	const uint64_t Mempool::MAXIMUM_WEIGHT = 4000000;
+#endif
+
+// Maximum number of ancestors
+const uint64_t Mempool::MAXIMUM_NUMBER_OF_ANCESTORS = 24;
+
+// Maximum number of descendants
+const uint64_t Mempool::MAXIMUM_NUMBER_OF_DESCENDANTS = 24;
+
+
 // Supporting function implementation
 
 // Transaction hash operator
 size_t Mempool::TransactionHash::operator()(const Transaction &transaction) const {
 	
-	// Return hash of the serialized transaction
-	return hash<string>()(Common::toHexString(transaction.serialize()));
+	// Return hash of the transaction's ID
+	return Common::Uint8ArrayHash()(transaction.getId());
+}
+
+// Package fee rate compare operator
+bool Mempool::PackageFeeRateCompare::operator()(const tuple<uint64_t, uint64_t, const Transaction *> &firstPackageFeeRate, const tuple<uint64_t, uint64_t, const Transaction *> &secondPackageFeeRate) const {
+
+	// Get each package's fees multiplied by the other package's weight so that their fee rates can be compared without dividing
+	// TODO __int128 doesn't exist for 32 bit targets
+	const unsigned __int128 firstFeeRate = static_cast<unsigned __int128>(get<0>(firstPackageFeeRate)) * get<1>(secondPackageFeeRate);
+	const unsigned __int128 secondFeeRate = static_cast<unsigned __int128>(get<0>(secondPackageFeeRate)) * get<1>(firstPackageFeeRate);
+	
+	// Check if packages' fee rates are different
+	if(firstFeeRate != secondFeeRate) {
+	
+		// Return if the first package's fee rate is greater than the second package's fee rate
+		return firstFeeRate > secondFeeRate;
+	}
+	
+	// Return comparing the packages' transactions
+	return less<const Transaction *>()(get<2>(firstPackageFeeRate), get<2>(secondPackageFeeRate));
+}
+
+// Constructor
+Mempool::Mempool() :
+
+	// Set size to zero
+	size(0),
+	
+	// Set weight to zero
+	weight(0),
+	
+	// Set version to zero
+	version(0)
+{
 }
 
 // Clear
 void Mempool::clear() {
 
-	// Clear fees
-	fees.clear();
+	// Increment version
+	++version;
+	
+	// Set size to zero
+	size = 0;
+	
+	// Set weight to zero
+	weight = 0;
+	
+	// Clear descendant package fee rates
+	descendantPackageFeeRates.clear();
+	
+	// Clear descendant packages
+	descendantPackages.clear();
+	
+	// Clear package fee rates
+	packageFeeRates.clear();
+	
+	// Clear packages
+	packages.clear();
+	
+	// Clear spending transactions
+	spendingTransactions.clear();
 	
 	// Clear outputs
 	outputs.clear();
@@ -40,10 +131,30 @@ bool Mempool::contains(const Transaction &transaction) const {
 
 // Insert
 void Mempool::insert(Transaction &&transaction) {
+
+	// Go through all of the transaction's outputs
+	for(const Output &output : transaction.getOutputs()) {
+	
+		// Check if transactions in the mempool spend the output
+		if(spendingTransactions.contains(output.getLookupValue().value())) {
+		
+			// Throw exception
+			throw runtime_error("Transaction has descendants in the mempool");
+		}
+	}
+	
+	// Increment version
+	++version;
 	
 	// Add transaction to transactions
 	const unordered_set<Transaction, TransactionHash>::const_iterator value = transactions.insert(move(transaction)).first;
 	
+	// Add transaction's serialized length to the size
+	size += value->getSerializedLength();
+	
+	// Add transaction's weight to the weight
+	weight += getWeight(*value);
+	
 	// Go through all of the transaction's outputs
 	for(const Output &output : value->getOutputs()) {
 	
@@ -51,23 +162,105 @@ void Mempool::insert(Transaction &&transaction) {
 		outputs.emplace(output.getLookupValue().value(), make_pair(&output, &*value));
 	}
 	
-	// Add transaction's fees to fees
-	fees[value->getFees()].insert(&*value);
+	// Go through all of the transaction's inputs
+	for(const Input &input : value->getInputs()) {
+	
+		// Add transaction to the transactions that spend the input's output
+		spendingTransactions[input.getLookupValue()].insert(&*value);
+	}
+	
+	// Set transaction's package
+	setPackage(&*value, getAncestorPackage(&*value, {}));
+	
+	// Set transaction's descendant package to only the transaction since it doesn't have descendants
+	setDescendantPackage(&*value, {value->getFees(), value->getInputs().size(), value->getOutputs().size(), value->getKernels().size(), 1});
+	
+	// Go through all of the transaction's ancestors
+	for(const pair<const Transaction *const, uint64_t> &ancestor : getNumberOfInputsSpendingAncestors(&*value)) {
+	
+		// Add transaction to the ancestor's descendant package with the inputs that spend outputs in it cut through
+		Package descendantPackage = descendantPackages.at(ancestor.first);
+		descendantPackage.fees = SaturateMath::add(descendantPackage.fees, value->getFees());
+		descendantPackage.numberOfInputs = descendantPackage.numberOfInputs + value->getInputs().size() - ancestor.second;
+		descendantPackage.numberOfOutputs = descendantPackage.numberOfOutputs + value->getOutputs().size() - ancestor.second;
+		descendantPackage.numberOfKernels += value->getKernels().size();
+		++descendantPackage.numberOfTransactions;
+		
+		// Set ancestor's descendant package
+		setDescendantPackage(ancestor.first, descendantPackage);
+	}
 }
 
 // Erase
 Mempool::const_iterator Mempool::erase(const const_iterator &transaction) {
 
-	// Erase transaction's fees from fees
-	fees.at(transaction->getFees()).erase(&*transaction);
+	// Increment version
+	++version;
+	
+	// Remove transaction's serialized length from the size
+	size -= transaction->getSerializedLength();
+	
+	// Remove transaction's weight from the weight
+	weight -= getWeight(*transaction);
+	
+	// Get transaction's ancestors
+	const unordered_set ancestors = getAncestors(&*transaction);
+	
+	// Get transaction's descendants
+	const unordered_set descendants = getDescendants(&*transaction);
 	
-	// Check if no other transactions have the same fees
-	if(fees.at(transaction->getFees()).empty()) {
+	// Check if transaction doesn't have descendants
+	if(descendants.empty()) {
 	
-		// Erase fee
-		fees.erase(transaction->getFees());
+		// Go through all of the transaction's ancestors
+		for(const pair<const Transaction *const, uint64_t> &ancestor : getNumberOfInputsSpendingAncestors(&*transaction)) {
+		
+			// Remove transaction from the ancestor's descendant package and restore the outputs that its inputs cut through
+			Package descendantPackage = descendantPackages.at(ancestor.first);
+			descendantPackage.fees = SaturateMath::subtract(descendantPackage.fees, transaction->getFees());
+			descendantPackage.numberOfInputs = descendantPackage.numberOfInputs + ancestor.second - transaction->getInputs().size();
+			descendantPackage.numberOfOutputs = descendantPackage.numberOfOutputs + ancestor.second - transaction->getOutputs().size();
+			descendantPackage.numberOfKernels -= transaction->getKernels().size();
+			--descendantPackage.numberOfTransactions;
+			
+			// Set ancestor's descendant package
+			setDescendantPackage(ancestor.first, descendantPackage);
+		}
 	}
 	
+	// Otherwise check if transaction doesn't have ancestors
+	else if(ancestors.empty()) {
+	
+		// Go through all of the transaction's descendants
+		for(const pair<const Transaction *const, uint64_t> &descendant : getNumberOfOutputsSpentByDescendants(&*transaction)) {
+		
+			// Remove transaction from the descendant's package and restore the inputs that spent its outputs
+			Package package = packages.at(descendant.first);
+			package.fees = SaturateMath::subtract(package.fees, transaction->getFees());
+			package.numberOfInputs = package.numberOfInputs + descendant.second - transaction->getInputs().size();
+			package.numberOfOutputs = package.numberOfOutputs + descendant.second - transaction->getOutputs().size();
+			package.numberOfKernels -= transaction->getKernels().size();
+			--package.numberOfTransactions;
+			
+			// Set descendant's package
+			setPackage(descendant.first, package);
+		}
+	}
+	
+	// Erase transaction's package fee rate from package fee rates
+	const Package &package = packages.at(&*transaction);
+	packageFeeRates.erase({package.fees, getPackageWeight(package), &*transaction});
+	
+	// Erase transaction's package
+	packages.erase(&*transaction);
+	
+	// Erase transaction's descendant package fee rate from descendant package fee rates
+	const Package &descendantPackage = descendantPackages.at(&*transaction);
+	descendantPackageFeeRates.erase({descendantPackage.fees, getPackageWeight(descendantPackage), &*transaction});
+	
+	// Erase transaction's descendant package
+	descendantPackages.erase(&*transaction);
+	
 	// Go through all of the transaction's outputs
 	for(const Output &output : transaction->getOutputs()) {
 	
@@ -75,8 +268,44 @@ Mempool::const_iterator Mempool::erase(const const_iterator &transaction) {
 		outputs.erase(output.getLookupValue().value());
 	}
 	
-	// Return erasing transaction
-	return transactions.erase(transaction);
+	// Go through all of the transaction's inputs
+	for(const Input &input : transaction->getInputs()) {
+	
+		// Erase transaction from the transactions that spend the input's output
+		const array inputLookupValue = input.getLookupValue();
+		spendingTransactions.at(inputLookupValue).erase(&*transaction);
+		
+		// Check if no other transactions spend the input's output
+		if(spendingTransactions.at(inputLookupValue).empty()) {
+		
+			// Erase input's output
+			spendingTransactions.erase(inputLookupValue);
+		}
+	}
+	
+	// Erase transaction
+	const const_iterator next = transactions.erase(transaction);
+	
+	// Check if transaction had ancestors and descendants
+	if(!ancestors.empty() && !descendants.empty()) {
+	
+		// Go through all of the transaction's ancestors
+		for(const Transaction *ancestor : ancestors) {
+		
+			// Set ancestor's descendant package from its remaining descendants since the transaction may have been their only connection to it
+			setDescendantPackage(ancestor, getDescendantPackage(ancestor));
+		}
+		
+		// Go through all of the transaction's descendants
+		for(const Transaction *descendant : descendants) {
+		
+			// Set descendant's package from its remaining ancestors since the transaction may have been their only connection to it
+			setPackage(descendant, getAncestorPackage(descendant, {}));
+		}
+	}
+	
+	// Return next transaction
+	return next;
 }
 
 // Erase
@@ -101,7 +330,7 @@ Mempool::const_iterator Mempool::cend() const {
 }
 
 // Get output
-const Output *Mempool::getOutput(const vector<uint8_t> &outputLookupValue) const {
+const Output *Mempool::getOutput(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const {
 
 	// Check if output doesn't exist
 	if(!outputs.contains(outputLookupValue)) {
@@ -115,7 +344,7 @@ const Output *Mempool::getOutput(const vector<uint8_t> &outputLookupValue) const
 }
 
 // Get transaction
-const Transaction *Mempool::getTransaction(const vector<uint8_t> &outputLookupValue) const {
+const Transaction *Mempool::getTransaction(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const {
 
 	// Check if output doesn't exist
 	if(!outputs.contains(outputLookupValue)) {
@@ -128,9 +357,474 @@ const Transaction *Mempool::getTransaction(const vector<uint8_t> &outputLookupVa
 	return outputs.at(outputLookupValue).second;
 }
 
-// Get fees
-const map<uint64_t, unordered_set<const Transaction *>> &Mempool::getFees() const {
+// Get spending transactions
+const unordered_set<const Transaction *> *Mempool::getSpendingTransactions(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const {
+
+	// Check if no transactions spend the output
+	if(!spendingTransactions.contains(outputLookupValue)) {
+	
+		// Return null
+		return nullptr;
+	}
+	
+	// Return spending transactions
+	return &spendingTransactions.at(outputLookupValue);
+}
+
+// Get package fee rates
+const Mempool::PackageFeeRates &Mempool::getPackageFeeRates() const {
+
+	// Return package fee rates
+	return packageFeeRates;
+}
+
+// Get package fee rate
+tuple<uint64_t, uint64_t, const Transaction *> Mempool::getPackageFeeRate(const Transaction *transaction, const unordered_set<const Transaction *> &excludedTransactions) const {
+
+	// Get transaction's package without the excluded transactions
+	const Package package = getAncestorPackage(transaction, excludedTransactions);
+	
+	// Return package's fee rate
+	return {package.fees, getPackageWeight(package), transaction};
+}
+
+// Get ancestors
+unordered_set<const Transaction *> Mempool::getAncestors(const Transaction *transaction) const {
+
+	// Initialize ancestors
+	unordered_set<const Transaction *> ancestors;
+	
+	// Go through all pending transactions starting with the transaction
+	vector<const Transaction *> pendingTransactions = {transaction};
+	while(!pendingTransactions.empty()) {
+	
+		// Get pending transaction
+		const Transaction *pendingTransaction = pendingTransactions.back();
+		pendingTransactions.pop_back();
+		
+		// Go through all of the pending transaction's inputs
+		for(const Input &input : pendingTransaction->getInputs()) {
+		
+			// Check if input is spending an output in the mempool and the output's transaction isn't already an ancestor
+			const unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash>::const_iterator output = outputs.find(input.getLookupValue());
+			if(output != outputs.cend() && ancestors.insert(output->second.second).second) {
+			
+				// Add output's transaction to list of pending transactions
+				pendingTransactions.push_back(output->second.second);
+			}
+		}
+	}
+	
+	// Return ancestors
+	return ancestors;
+}
+
+// Get number of ancestors
+uint64_t Mempool::getNumberOfAncestors(const Transaction *transaction) const {
+
+	// Return number of transactions in the transaction's package without the transaction
+	return packages.at(transaction).numberOfTransactions - 1;
+}
+
+// Get descendant package fee rates
+const Mempool::PackageFeeRates &Mempool::getDescendantPackageFeeRates() const {
+
+	// Return descendant package fee rates
+	return descendantPackageFeeRates;
+}
+
+// Get version
+uint64_t Mempool::getVersion() const {
+
+	// Return version
+	return version;
+}
+
+// Is full
+bool Mempool::isFull() const {
+
+	// Return if size or weight is greater than the maximum
+	return size > MAXIMUM_SIZE || weight > MAXIMUM_WEIGHT;
+}
+
+// Is fee rate too low
+bool Mempool::isFeeRateTooLow(const Transaction &transaction, const unordered_set<const Transaction *> &replacedTransactions) const {
 
-	// Return fees
-	return fees;
+	// Initialize size and weight without the replaced transactions
+	uint64_t sizeWithoutReplacedTransactions = size;
+	uint64_t weightWithoutReplacedTransactions = weight;
+	
+	// Go through all replaced transactions
+	for(const Transaction *replacedTransaction : replacedTransactions) {
+	
+		// Remove replaced transaction's serialized length and weight from the size and weight without the replaced transactions
+		sizeWithoutReplacedTransactions -= replacedTransaction->getSerializedLength();
+		weightWithoutReplacedTransactions -= getWeight(*replacedTransaction);
+	}
+	
+	// Check if mempool won't be full with the transaction once the replaced transactions are removed
+	if(sizeWithoutReplacedTransactions + transaction.getSerializedLength() <= MAXIMUM_SIZE && weightWithoutReplacedTransactions + getWeight(transaction) <= MAXIMUM_WEIGHT) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Go through all descendant package fee rates in ascending order while they're for replaced transactions
+	PackageFeeRates::const_reverse_iterator lowestDescendantPackageFeeRate = descendantPackageFeeRates.crbegin();
+	while(lowestDescendantPackageFeeRate != descendantPackageFeeRates.crend() && replacedTransactions.contains(get<2>(*lowestDescendantPackageFeeRate))) {
+	
+		// Go to next descendant package fee rate
+		++lowestDescendantPackageFeeRate;
+	}
+	
+	// Check if mempool will be empty once the replaced transactions are removed
+	if(lowestDescendantPackageFeeRate == descendantPackageFeeRates.crend()) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Return if the transaction's fee rate isn't greater than the lowest descendant package fee rate
+	// TODO __int128 doesn't exist for 32 bit targets
+	return static_cast<unsigned __int128>(transaction.getFees()) * get<1>(*lowestDescendantPackageFeeRate) <= static_cast<unsigned __int128>(get<0>(*lowestDescendantPackageFeeRate)) * getWeight(transaction);
+}
+
+// Exceeds package limits
+bool Mempool::exceedsPackageLimits(const Transaction &transaction, const unordered_set<const Transaction *> &replacedTransactions) const {
+
+	// Initialize ancestors
+	unordered_set<const Transaction *> ancestors;
+	
+	// Go through all pending transactions starting with the transaction
+	vector<const Transaction *> pendingTransactions = {&transaction};
+	while(!pendingTransactions.empty()) {
+	
+		// Get pending transaction
+		const Transaction *pendingTransaction = pendingTransactions.back();
+		pendingTransactions.pop_back();
+		
+		// Go through all of the pending transaction's inputs
+		for(const Input &input : pendingTransaction->getInputs()) {
+		
+			// Check if input is spending an output in the mempool and the output's transaction isn't already an ancestor
+			const unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash>::const_iterator output = outputs.find(input.getLookupValue());
+			if(output != outputs.cend() && ancestors.insert(output->second.second).second) {
+			
+				// Check if transaction has too many ancestors
+				if(ancestors.size() > MAXIMUM_NUMBER_OF_ANCESTORS) {
+				
+					// Return true
+					return true;
+				}
+				
+				// Add output's transaction to list of pending transactions
+				pendingTransactions.push_back(output->second.second);
+			}
+		}
+	}
+	
+	// Initialize number of replaced descendants
+	unordered_map<const Transaction *, uint64_t> numberOfReplacedDescendants;
+	
+	// Go through all replaced transactions
+	for(const Transaction *replacedTransaction : replacedTransactions) {
+	
+		// Go through all of the replaced transaction's ancestors
+		for(const Transaction *ancestor : getAncestors(replacedTransaction)) {
+		
+			// Check if ancestor is one of the transaction's ancestors
+			if(ancestors.contains(ancestor)) {
+			
+				// Increment ancestor's number of replaced descendants
+				++numberOfReplacedDescendants[ancestor];
+			}
+		}
+	}
+	
+	// Go through all of the transaction's ancestors
+	for(const Transaction *ancestor : ancestors) {
+	
+		// Check if ancestor will have too many descendants with the transaction once the replaced transactions are removed
+		if(getNumberOfDescendants(ancestor) - numberOfReplacedDescendants[ancestor] + 1 > MAXIMUM_NUMBER_OF_DESCENDANTS) {
+		
+			// Return true
+			return true;
+		}
+	}
+	
+	// Return false
+	return false;
+}
+
+// Get descendants
+unordered_set<const Transaction *> Mempool::getDescendants(const Transaction *transaction) const {
+
+	// Initialize descendants
+	unordered_set<const Transaction *> descendants;
+	
+	// Go through all pending transactions starting with the transaction
+	vector<const Transaction *> pendingTransactions = {transaction};
+	while(!pendingTransactions.empty()) {
+	
+		// Get pending transaction
+		const Transaction *pendingTransaction = pendingTransactions.back();
+		pendingTransactions.pop_back();
+		
+		// Go through all of the pending transaction's outputs
+		for(const Output &output : pendingTransaction->getOutputs()) {
+		
+			// Check if transactions spend the output
+			const unordered_set<const Transaction *> *outputSpendingTransactions = getSpendingTransactions(output.getLookupValue().value());
+			if(outputSpendingTransactions) {
+			
+				// Go through all transactions that spend the output
+				for(const Transaction *spendingTransaction : *outputSpendingTransactions) {
+				
+					// Check if spending transaction isn't already a descendant
+					if(descendants.insert(spendingTransaction).second) {
+					
+						// Add spending transaction to list of pending transactions
+						pendingTransactions.push_back(spendingTransaction);
+					}
+				}
+			}
+		}
+	}
+	
+	// Return descendants
+	return descendants;
+}
+
+// Get weight
+uint64_t Mempool::getWeight(const Transaction &transaction) {
+
+	// Return weight of the transaction's inputs, outputs, and kernels
+	return Consensus::getBlockWeight(transaction.getInputs().size(), transaction.getOutputs().size(), transaction.getKernels().size());
+}
+
+// Get number of descendants
+uint64_t Mempool::getNumberOfDescendants(const Transaction *transaction) const {
+
+	// Return number of transactions in the transaction's descendant package without the transaction
+	return descendantPackages.at(transaction).numberOfTransactions - 1;
+}
+
+// Get package weight
+uint64_t Mempool::getPackageWeight(const Package &package) {
+
+	// Return weight of the package's inputs, outputs, and kernels
+	return Consensus::getBlockWeight(package.numberOfInputs, package.numberOfOutputs, package.numberOfKernels);
+}
+
+// Get ancestor package
+Mempool::Package Mempool::getAncestorPackage(const Transaction *transaction, const unordered_set<const Transaction *> &excludedTransactions) const {
+
+	// Initialize package
+	Package package = {};
+	
+	// Initialize package transactions
+	unordered_set<const Transaction *> packageTransactions = {transaction};
+	
+	// Go through all pending transactions starting with the transaction
+	vector<const Transaction *> pendingTransactions = {transaction};
+	while(!pendingTransactions.empty()) {
+	
+		// Get pending transaction
+		const Transaction *pendingTransaction = pendingTransactions.back();
+		pendingTransactions.pop_back();
+		
+		// Add pending transaction's fees to the package's fees
+		package.fees = SaturateMath::add(package.fees, pendingTransaction->getFees());
+		
+		// Add pending transaction's inputs, outputs, and kernels to the package's number of inputs, outputs, and kernels
+		package.numberOfInputs += pendingTransaction->getInputs().size();
+		package.numberOfOutputs += pendingTransaction->getOutputs().size();
+		package.numberOfKernels += pendingTransaction->getKernels().size();
+		
+		// Increment package's number of transactions
+		++package.numberOfTransactions;
+		
+		// Go through all of the pending transaction's inputs
+		for(const Input &input : pendingTransaction->getInputs()) {
+		
+			// Check if input is spending an output in the mempool that isn't from an excluded transaction
+			const unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash>::const_iterator output = outputs.find(input.getLookupValue());
+			if(output != outputs.cend() && !excludedTransactions.contains(output->second.second)) {
+			
+				// Remove input and output from the package's number of inputs and outputs since they will be cut through in a block containing the package
+				--package.numberOfInputs;
+				--package.numberOfOutputs;
+				
+				// Check if output's transaction isn't already in the package
+				if(packageTransactions.insert(output->second.second).second) {
+				
+					// Add output's transaction to list of pending transactions
+					pendingTransactions.push_back(output->second.second);
+				}
+			}
+		}
+	}
+	
+	// Return package
+	return package;
+}
+
+// Get descendant package
+Mempool::Package Mempool::getDescendantPackage(const Transaction *transaction) const {
+
+	// Get transaction's descendants and include the transaction in them
+	unordered_set<const Transaction *> descendants = getDescendants(transaction);
+	descendants.insert(transaction);
+	
+	// Initialize descendant package
+	Package descendantPackage = {};
+	
+	// Set descendant package's number of transactions
+	descendantPackage.numberOfTransactions = descendants.size();
+	
+	// Go through all descendants
+	for(const Transaction *descendant : descendants) {
+	
+		// Add descendant's fees to the descendant package's fees
+		descendantPackage.fees = SaturateMath::add(descendantPackage.fees, descendant->getFees());
+		
+		// Add descendant's inputs, outputs, and kernels to the descendant package's number of inputs, outputs, and kernels
+		descendantPackage.numberOfInputs += descendant->getInputs().size();
+		descendantPackage.numberOfOutputs += descendant->getOutputs().size();
+		descendantPackage.numberOfKernels += descendant->getKernels().size();
+		
+		// Go through all of the descendant's inputs
+		for(const Input &input : descendant->getInputs()) {
+		
+			// Check if input is spending an output from another descendant
+			const unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash>::const_iterator output = outputs.find(input.getLookupValue());
+			if(output != outputs.cend() && descendants.contains(output->second.second)) {
+			
+				// Remove input and output from the descendant package's number of inputs and outputs since they will be cut through
+				--descendantPackage.numberOfInputs;
+				--descendantPackage.numberOfOutputs;
+			}
+		}
+	}
+	
+	// Return descendant package
+	return descendantPackage;
+}
+
+// Get number of inputs spending ancestors
+unordered_map<const Transaction *, uint64_t> Mempool::getNumberOfInputsSpendingAncestors(const Transaction *transaction) const {
+
+	// Initialize number of inputs spending parents
+	unordered_map<const Transaction *, uint64_t> numberOfInputsSpendingParents;
+	
+	// Go through all of the transaction's inputs
+	for(const Input &input : transaction->getInputs()) {
+	
+		// Check if input is spending an output in the mempool
+		const unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash>::const_iterator output = outputs.find(input.getLookupValue());
+		if(output != outputs.cend()) {
+		
+			// Increment output's transaction's number of inputs spending it
+			++numberOfInputsSpendingParents[output->second.second];
+		}
+	}
+	
+	// Initialize number of inputs spending ancestors
+	unordered_map<const Transaction *, uint64_t> numberOfInputsSpendingAncestors;
+	
+	// Go through all of the transaction's parents
+	for(const pair<const Transaction *const, uint64_t> &parent : numberOfInputsSpendingParents) {
+	
+		// Add the inputs spending the parent to the parent since they spend outputs in its descendant package
+		numberOfInputsSpendingAncestors[parent.first] += parent.second;
+		
+		// Go through all of the parent's ancestors
+		for(const Transaction *ancestor : getAncestors(parent.first)) {
+		
+			// Add the inputs spending the parent to the ancestor since they spend outputs in its descendant package
+			numberOfInputsSpendingAncestors[ancestor] += parent.second;
+		}
+	}
+	
+	// Return number of inputs spending ancestors
+	return numberOfInputsSpendingAncestors;
+}
+
+// Get number of outputs spent by descendants
+unordered_map<const Transaction *, uint64_t> Mempool::getNumberOfOutputsSpentByDescendants(const Transaction *transaction) const {
+
+	// Initialize number of outputs spent by children
+	unordered_map<const Transaction *, uint64_t> numberOfOutputsSpentByChildren;
+	
+	// Go through all of the transaction's outputs
+	for(const Output &output : transaction->getOutputs()) {
+	
+		// Check if transactions spend the output
+		const unordered_set<const Transaction *> *outputSpendingTransactions = getSpendingTransactions(output.getLookupValue().value());
+		if(outputSpendingTransactions) {
+		
+			// Go through all transactions that spend the output
+			for(const Transaction *spendingTransaction : *outputSpendingTransactions) {
+			
+				// Increment spending transaction's number of outputs spent
+				++numberOfOutputsSpentByChildren[spendingTransaction];
+			}
+		}
+	}
+	
+	// Initialize number of outputs spent by descendants
+	unordered_map<const Transaction *, uint64_t> numberOfOutputsSpentByDescendants;
+	
+	// Go through all of the transaction's children
+	for(const pair<const Transaction *const, uint64_t> &child : numberOfOutputsSpentByChildren) {
+	
+		// Add the outputs spent by the child to the child since they're cut through in its package
+		numberOfOutputsSpentByDescendants[child.first] += child.second;
+		
+		// Go through all of the child's descendants
+		for(const Transaction *descendant : getDescendants(child.first)) {
+		
+			// Add the outputs spent by the child to the descendant since they're cut through in its package
+			numberOfOutputsSpentByDescendants[descendant] += child.second;
+		}
+	}
+	
+	// Return number of outputs spent by descendants
+	return numberOfOutputsSpentByDescendants;
+}
+
+// Set package
+void Mempool::setPackage(const Transaction *transaction, const Package &package) {
+
+	// Check if transaction already has a package
+	const unordered_map<const Transaction *, Package>::const_iterator oldPackage = packages.find(transaction);
+	if(oldPackage != packages.cend()) {
+	
+		// Erase transaction's old package fee rate from package fee rates
+		packageFeeRates.erase({oldPackage->second.fees, getPackageWeight(oldPackage->second), transaction});
+	}
+	
+	// Add transaction's package fee rate to package fee rates
+	packageFeeRates.emplace(package.fees, getPackageWeight(package), transaction);
+	
+	// Set transaction's package
+	packages[transaction] = package;
+}
+
+// Set descendant package
+void Mempool::setDescendantPackage(const Transaction *transaction, const Package &package) {
+
+	// Check if transaction already has a descendant package
+	const unordered_map<const Transaction *, Package>::const_iterator oldDescendantPackage = descendantPackages.find(transaction);
+	if(oldDescendantPackage != descendantPackages.cend()) {
+	
+		// Erase transaction's old descendant package fee rate from descendant package fee rates
+		descendantPackageFeeRates.erase({oldDescendantPackage->second.fees, getPackageWeight(oldDescendantPackage->second), transaction});
+	}
+	
+	// Add transaction's descendant package fee rate to descendant package fee rates
+	descendantPackageFeeRates.emplace(package.fees, getPackageWeight(package), transaction);
+	
+	// Set transaction's descendant package
+	descendantPackages[transaction] = package;
 }
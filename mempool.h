@@ -5,7 +5,8 @@
 
 // Header files
 #include "./common.h"
-#include <map>
+#include <set>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include "./transaction.h"
@@ -35,12 +36,59 @@ class Mempool final {
 				size_t operator()(const Transaction &transaction) const;
 		};
 		
+		// Package fee rate compare
+		class PackageFeeRateCompare {
+
+			// Public
+			public:
+			
+				// Operator
+				bool operator()(const tuple<uint64_t, uint64_t, const Transaction *> &firstPackageFeeRate, const tuple<uint64_t, uint64_t, const Transaction *> &secondPackageFeeRate) const;
+		};
+		
+		// Package structure
+		struct Package final {
+		
+			// Fees
+			uint64_t fees;
+			
+			// Number of inputs
+			uint64_t numberOfInputs;
+			
+			// Number of outputs
+			uint64_t numberOfOutputs;
+			
+			// Number of kernels
+			uint64_t numberOfKernels;
+			
+			// Number of transactions
+			uint64_t numberOfTransactions;
+		};
+		
 	// Public
 	public:
 	
 		// Constant iterator
 		typedef unordered_set<Transaction, TransactionHash>::const_iterator const_iterator;
 		
+		// Package fee rates
+		typedef set<tuple<uint64_t, uint64_t, const Transaction *>, PackageFeeRateCompare> PackageFeeRates;
+		
+		// Maximum size
+		static const uint64_t MAXIMUM_SIZE;
+		
+		// Maximum weight
+		static const uint64_t MAXIMUM_WEIGHT;
+		
+		// Maximum number of ancestors
+		static const uint64_t MAXIMUM_NUMBER_OF_ANCESTORS;
+		
+		// Maximum number of descendants
+		static const uint64_t MAXIMUM_NUMBER_OF_DESCENDANTS;
+		
+		// Constructor
+		Mempool();
+		
 		// Clear
 		void clear();
 		
@@ -63,25 +111,103 @@ class Mempool final {
 		const_iterator cend() const;
 		
 		// Get output
-		const Output *getOutput(const vector<uint8_t> &outputLookupValue) const;
+		const Output *getOutput(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const;
 		
 		// Get transaction
-		const Transaction *getTransaction(const vector<uint8_t> &outputLookupValue) const;
+		const Transaction *getTransaction(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const;
+		
+		// Get spending transactions
+		const unordered_set<const Transaction *> *getSpendingTransactions(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &outputLookupValue) const;
+		
+		// Get package fee rates
+		const PackageFeeRates &getPackageFeeRates() const;
+		
+		// Get package fee rate
+		tuple<uint64_t, uint64_t, const Transaction *> getPackageFeeRate(const Transaction *transaction, const unordered_set<const Transaction *> &excludedTransactions) const;
 		
-		// Get fees
-		const map<uint64_t, unordered_set<const Transaction *>> &getFees() const;
+		// Get ancestors
+		unordered_set<const Transaction *> getAncestors(const Transaction *transaction) const;
+		
+		// Get number of ancestors
+		uint64_t getNumberOfAncestors(const Transaction *transaction) const;
+		
+		// Get descendants
+		unordered_set<const Transaction *> getDescendants(const Transaction *transaction) const;
+		
+		// Get number of descendants
+		uint64_t getNumberOfDescendants(const Transaction *transaction) const;
+		
+		// Get descendant package fee rates
+		const PackageFeeRates &getDescendantPackageFeeRates() const;
+		
+		// Get version
+		uint64_t getVersion() const;
+		
+		// Is full
+		bool isFull() const;
+		
+		// Is fee rate too low
+		bool isFeeRateTooLow(const Transaction &transaction, const unordered_set<const Transaction *> &replacedTransactions) const;
+		
+		// Exceeds package limits
+		bool exceedsPackageLimits(const Transaction &transaction, const unordered_set<const Transaction *> &replacedTransactions) const;
 		
 	// Private
 	private:
+	
+		// Get weight
+		static uint64_t getWeight(const Transaction &transaction);
+		
+		// Get package weight
+		static uint64_t getPackageWeight(const Package &package);
+		
+		// Get ancestor package
+		Package getAncestorPackage(const Transaction *transaction, const unordered_set<const Transaction *> &excludedTransactions) const;
+		
+		// Get descendant package
+		Package getDescendantPackage(const Transaction *transaction) const;
+		
+		// Get number of inputs spending ancestors
+		unordered_map<const Transaction *, uint64_t> getNumberOfInputsSpendingAncestors(const Transaction *transaction) const;
+		
+		// Get number of outputs spent by descendants
+		unordered_map<const Transaction *, uint64_t> getNumberOfOutputsSpentByDescendants(const Transaction *transaction) const;
+		
+		// Set package
+		void setPackage(const Transaction *transaction, const Package &package);
+		
+		// Set descendant package
+		void setDescendantPackage(const Transaction *transaction, const Package &package);
 		
 		// Transactions
 		unordered_set<Transaction, TransactionHash> transactions;
 		
 		// Outputs
-		unordered_map<vector<uint8_t>, pair<const Output *, const Transaction *>, Common::Uint8VectorHash> outputs;
+		unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Transaction *>, Common::Uint8ArrayHash> outputs;
+		
+		// Spending transactions
+		unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, unordered_set<const Transaction *>, Common::Uint8ArrayHash> spendingTransactions;
+		
+		// Packages
+		unordered_map<const Transaction *, Package> packages;
+		
+		// Package fee rates
+		PackageFeeRates packageFeeRates;
+		
+		// Descendant packages
+		unordered_map<const Transaction *, Package> descendantPackages;
+		
+		// Descendant package fee rates
+		PackageFeeRates descendantPackageFeeRates;
+		
+		// Size
+		uint64_t size;
+		
+		// Weight
+		uint64_t weight;
 		
-		// Fees
-		map<uint64_t, unordered_set<const Transaction *>> fees;
+		// Version
+		uint64_t version;
 };
 
 
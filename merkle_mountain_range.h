@@ -6,17 +6,24 @@
 // Header files
 #include "./common.h"
 #include <array>
+#include "./crypto.h"
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
+#include <sstream>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include "blake2.h"
 #include "roaring/roaring64map.hh"
+#include "./memory_mapped_allocator.h"
+#include "./merkle_mountain_range_hashes.h"
 #include "./saturate_math.h"
 #include "zip.h"
+#include "zlib.h"
 
 using namespace std;
 
@@ -28,16 +35,64 @@ namespace MwcValidationNode {
 // Classes
 
 // Merkle mountain range class
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange final {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange final {
 
 	// Public
 	public:
 	
+		// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+		#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+		
+			// Leaves
+			typedef map<uint64_t, MerkleMountainRangeLeafDerivedClass, less<uint64_t>, MemoryMappedAllocator<pair<const uint64_t, MerkleMountainRangeLeafDerivedClass>>> Leaves;
+			
+		// Otherwise
+		#else
+		
+			// Leaves
+			typedef map<uint64_t, MerkleMountainRangeLeafDerivedClass> Leaves;
+		#endif
+		
 		// Constant iterator
-		typedef typename map<uint64_t, MerkleMountainRangeLeafDerivedClass>::const_iterator const_iterator;
+		typedef typename Leaves::const_iterator const_iterator;
 		
 		// Constant reverse iterator
-		typedef typename map<uint64_t, MerkleMountainRangeLeafDerivedClass>::const_reverse_iterator const_reverse_iterator;
+		typedef typename Leaves::const_reverse_iterator const_reverse_iterator;
+		
+		// Journal operation
+		enum class JournalOperation : uint8_t {
+		
+			// Append leaf
+			APPEND_LEAF,
+			
+			// Prune leaf
+			PRUNE_LEAF,
+			
+			// Permanently prune leaf
+			PERMANENTLY_PRUNE_LEAF,
+			
+			// Rewind to size
+			REWIND_TO_SIZE,
+			
+			// Set minimum size
+			SET_MINIMUM_SIZE,
+			
+			// Clear
+			CLEAR
+		};
+		
+		// Journal entry
+		struct JournalEntry final {
+		
+			// Operation
+			JournalOperation operation;
+			
+			// Value
+			uint64_t value;
+			
+			// Leaf
+			optional<MerkleMountainRangeLeafDerivedClass> leaf;
+		};
 		
 		// Constructor
 		MerkleMountainRange();
@@ -45,6 +100,18 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		// Initializer list constructor
 		explicit MerkleMountainRange(const initializer_list<MerkleMountainRangeLeafDerivedClass> &leaves);
 		
+		// Copy constructor
+		MerkleMountainRange(const MerkleMountainRange &other);
+		
+		// Move constructor
+		MerkleMountainRange(MerkleMountainRange &&other) = default;
+		
+		// Copy assignment operator
+		MerkleMountainRange &operator=(const MerkleMountainRange &other);
+		
+		// Move assignment operator
+		MerkleMountainRange &operator=(MerkleMountainRange &&other) = default;
+		
 		// Append leaf
 		void appendLeaf(const MerkleMountainRangeLeafDerivedClass &leaf);
 		
@@ -64,16 +131,16 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		const MerkleMountainRangeLeafDerivedClass *getLeaf(const uint64_t leafIndex) const;
 		
 		// Leaf with lookup value exists
-		bool leafWithLookupValueExists(const vector<uint8_t> &lookupValue) const;
+		bool leafWithLookupValueExists(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const;
 		
 		// Get leaf by lookup value
-		const MerkleMountainRangeLeafDerivedClass *getLeafByLookupValue(const vector<uint8_t> &lookupValue) const;
+		const MerkleMountainRangeLeafDerivedClass *getLeafByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const;
 		
 		// Get leaf indices by lookup value
-		const unordered_set<uint64_t> &getLeafIndicesByLookupValue(const vector<uint8_t> &lookupValue) const;
+		unordered_set<uint64_t> getLeafIndicesByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const;
 		
 		// Get leaf index by lookup value
-		uint64_t getLeafIndexByLookupValue(const vector<uint8_t> &lookupValue) const;
+		uint64_t getLeafIndexByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const;
 		
 		// Rewind to size
 		void rewindToSize(const uint64_t size);
@@ -84,12 +151,18 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		// Clear
 		void clear();
 		
+		// Replace
+		void replace(MerkleMountainRange &&other);
+		
 		// Get root at size
 		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> getRootAtSize(const uint64_t size) const;
 		
 		// Get root at number of leaves
 		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> getRootAtNumberOfLeaves(const uint64_t numberOfLeaves) const;
 		
+		// Get roots at sizes
+		vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> getRootsAtSizes(const vector<uint64_t> &sizes) const;
+		
 		// Iterator constant begin
 		const_iterator cbegin() const;
 		
@@ -126,6 +199,24 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		// Restore
 		static MerkleMountainRange restore(ifstream &file);
 		
+		// Restore legacy
+		static MerkleMountainRange restoreLegacy(ifstream &file);
+		
+		// Start journal
+		void startJournal();
+		
+		// Is journal started
+		bool isJournalStarted() const;
+		
+		// Take journal
+		vector<JournalEntry> takeJournal();
+		
+		// Apply journal
+		void applyJournal(ifstream &file);
+		
+		// Save journal
+		static void saveJournal(const vector<JournalEntry> &journal, ofstream &file);
+		
 		// Create from ZIP
 		static MerkleMountainRange createFromZip(zip_t *zip, uint32_t protocolVersion, const char *dataPath, const char *hashesPath, const char *pruneListPath = nullptr, const char *leafSetPath = nullptr);
 		
@@ -144,8 +235,51 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 	// Private
 	private:
 	
+		// Section buffer class
+		class SectionBuffer final : public streambuf {
+		
+			// Public
+			public:
+			
+				// Constructor
+				explicit SectionBuffer(streambuf *file);
+				
+				// Get length
+				uint64_t getLength() const;
+				
+				// Get checksum
+				uint32_t getChecksum() const;
+				
+			// Private
+			private:
+			
+				// Overflow
+				virtual int_type overflow(const int_type character) override final;
+				
+				// Put characters
+				virtual streamsize xsputn(const char_type *characters, const streamsize numberOfCharacters) override final;
+				
+				// File
+				streambuf *file;
+				
+				// Length
+				uint64_t length;
+				
+				// Checksum
+				uLong checksum;
+		};
+		
+		// Save section
+		static void saveSection(ofstream &file, const function<void(ostream &section)> &writeSection);
+		
+		// Restore section
+		static istringstream restoreSection(ifstream &file);
+		
 		// Append leaf or pruned leaf
 		void appendLeafOrPrunedLeaf(optional<MerkleMountainRangeLeafDerivedClass> &&leafOrPrunedLeaf);
+		
+		// Get replacement journal
+		optional<vector<JournalEntry>> getReplacementJournal(MerkleMountainRange &other) const;
 	
 		// Set hash at index
 		void setHashAtIndex(const uint64_t index, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &&hash);
@@ -153,8 +287,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		// Prune hash
 		void pruneHash(const uint64_t leafIndex);
 		
+		// Remove from lookup table
+		void removeFromLookupTable(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue, const uint64_t leafIndex);
+		
 		// Get peak indices at size
 		static vector<uint64_t> getPeakIndicesAtSize(const uint64_t size);
+		
+		// Bag peaks
+		static array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> bagPeaks(const uint64_t size, const vector<const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> *> &peakHashes);
 	
 		// Get height at index
 		static uint64_t getHeightAtIndex(const uint64_t index);
@@ -178,16 +318,16 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		static uint64_t getNextPeakIndex(const uint64_t index);
 		
 		// Lookup table
-		unordered_map<vector<uint8_t>, unordered_set<uint64_t>, Common::Uint8VectorHash> lookupTable;
+		conditional_t<MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES, unordered_multimap<array<uint8_t, Crypto::COMMITMENT_LENGTH>, uint64_t, Common::Uint8ArrayHash>, unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, uint64_t, Common::Uint8ArrayHash>> lookupTable;
 		
 		// Unpruned leaves
-		map<uint64_t, MerkleMountainRangeLeafDerivedClass> unprunedLeaves;
+		Leaves unprunedLeaves;
 		
 		// Number of leaves
 		uint64_t numberOfLeaves;
 		
 		// Unpruned hashes
-		map<uint64_t, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> unprunedHashes;
+		HashesClass unprunedHashes;
 		
 		// Number of hashes
 		uint64_t numberOfHashes;
@@ -203,13 +343,19 @@ template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange
 		
 		// Prune list
 		unordered_map<uint64_t, MerkleMountainRangeLeafDerivedClass> pruneList;
+		
+		// Journal
+		vector<JournalEntry> journal;
+		
+		// Journal started
+		bool journalStarted;
 };
 
 
 // Supporting function implementation
 
 // Constructor
-template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::MerkleMountainRange() :
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::MerkleMountainRange() :
 
 	// Set number of leaves to zero
 	numberOfLeaves(0),
@@ -218,7 +364,10 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 	numberOfHashes(0),
 	
 	// Set minimum size to zero
-	minimumSize(0)
+	minimumSize(0),
+	
+	// Set journal started to false
+	journalStarted(false)
 {
 
 	// Set sum to zero
@@ -226,7 +375,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 }
 
 // Initializer list constructor
-template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::MerkleMountainRange(const initializer_list<MerkleMountainRangeLeafDerivedClass> &leaves) :
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::MerkleMountainRange(const initializer_list<MerkleMountainRangeLeafDerivedClass> &leaves) :
 
 	// Set number of leaves to zero
 	numberOfLeaves(0),
@@ -235,7 +384,10 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 	numberOfHashes(0),
 	
 	// Set minimum size to zero
-	minimumSize(0)
+	minimumSize(0),
+	
+	// Set journal started to false
+	journalStarted(false)
 {
 
 	// Set sum to zero
@@ -249,22 +401,85 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 	}
 }
 
+// Copy constructor
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::MerkleMountainRange(const MerkleMountainRange &other) :
+
+	// Set lookup table to other's lookup table
+	lookupTable(other.lookupTable),
+	
+	// Set unpruned leaves to other's unpruned leaves
+	unprunedLeaves(other.unprunedLeaves),
+	
+	// Set number of leaves to other's number of leaves
+	numberOfLeaves(other.numberOfLeaves),
+	
+	// Set unpruned hashes to other's unpruned hashes
+	unprunedHashes(other.unprunedHashes),
+	
+	// Set number of hashes to other's number of hashes
+	numberOfHashes(other.numberOfHashes),
+	
+	// Set minimum size to other's minimum size
+	minimumSize(other.minimumSize),
+	
+	// Set sum to other's sum
+	sum(other.sum),
+	
+	// Set prune history to other's prune history
+	pruneHistory(other.pruneHistory),
+	
+	// Set prune list to other's prune list
+	pruneList(other.pruneList),
+	
+	// Set journal started to false since the other's journal doesn't describe how the copy changes
+	journalStarted(false)
+{
+}
+
+// Copy assignment operator
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass> &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::operator=(const MerkleMountainRange &other) {
+
+	// Check if not self
+	if(this != &other) {
+	
+		// Set self to a copy of other
+		*this = MerkleMountainRange(other);
+	}
+	
+	// Return self
+	return *this;
+}
+
 // Append leaf
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::appendLeaf(const MerkleMountainRangeLeafDerivedClass &leaf) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::appendLeaf(const MerkleMountainRangeLeafDerivedClass &leaf) {
 
 	// Append leaf
 	appendLeafOrPrunedLeaf(optional<MerkleMountainRangeLeafDerivedClass>(leaf));
+	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add append leaf event to the journal now that the leaf was appended
+		journal.push_back({JournalOperation::APPEND_LEAF, numberOfLeaves - 1, unprunedLeaves.at(numberOfLeaves - 1)});
+	}
 }
 
 // Append leaf
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::appendLeaf(MerkleMountainRangeLeafDerivedClass &&leaf) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::appendLeaf(MerkleMountainRangeLeafDerivedClass &&leaf) {
 
 	// Append leaf
 	appendLeafOrPrunedLeaf(optional<MerkleMountainRangeLeafDerivedClass>(move(leaf)));
+	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add append leaf event to the journal now that the leaf was appended
+		journal.push_back({JournalOperation::APPEND_LEAF, numberOfLeaves - 1, unprunedLeaves.at(numberOfLeaves - 1)});
+	}
 }
 
 // Prune leaf
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::pruneLeaf(const uint64_t leafIndex, const bool permanent) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::pruneLeaf(const uint64_t leafIndex, const bool permanent) {
 
 	// Check if leaf index is invalid
 	if(leafIndex >= numberOfLeaves) {
@@ -281,18 +496,11 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	}
 	
 	// Check if leaf has a lookup value
-	const optional<vector<uint8_t>> lookupValue = unprunedLeaves.at(leafIndex).getLookupValue();
+	const optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> lookupValue = unprunedLeaves.at(leafIndex).getLookupValue();
 	if(lookupValue.has_value()) {
 	
 		// Remove leaf from lookup value from the lookup table
-		lookupTable.at(lookupValue.value()).erase(leafIndex);
-		
-		// Check if no more leaves have the lookup value
-		if(lookupTable.at(lookupValue.value()).empty()) {
-		
-			// Remove lookup value from the lookup table
-			lookupTable.erase(lookupValue.value());
-		}
+		removeFromLookupTable(lookupValue.value(), leafIndex);
 	}
 	
 	// Subtract from sum
@@ -317,24 +525,31 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 		// Move leaf to the prune list
 		pruneList.emplace(leafIndex, move(unprunedLeaves.extract(leafIndex).mapped()));
 	}
+	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add prune leaf event to the journal
+		journal.push_back({permanent ? JournalOperation::PERMANENTLY_PRUNE_LEAF : JournalOperation::PRUNE_LEAF, leafIndex, nullopt});
+	}
 }
 
 // Get size
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getSize() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getSize() const {
 
 	// Return number of hashes
 	return numberOfHashes;
 }
 
 // Get number of leaves
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getNumberOfLeaves() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getNumberOfLeaves() const {
 
 	// Return number of leaves
 	return numberOfLeaves;
 }
 
 // Get leaf
-template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRangeLeafDerivedClass *MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeaf(const uint64_t leafIndex) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> const MerkleMountainRangeLeafDerivedClass *MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeaf(const uint64_t leafIndex) const {
 
 	// Check if leaf doesn't exist or is pruned
 	if(!unprunedLeaves.contains(leafIndex)) {
@@ -348,14 +563,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRange
 }
 
 // Leaf with lookup value exists
-template<typename MerkleMountainRangeLeafDerivedClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::leafWithLookupValueExists(const vector<uint8_t> &lookupValue) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::leafWithLookupValueExists(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const {
 
 	// Return if lookup value exists in the lookup table
 	return lookupTable.contains(lookupValue);
 }
 
 // Get leaf by lookup value
-template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRangeLeafDerivedClass *MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeafByLookupValue(const vector<uint8_t> &lookupValue) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> const MerkleMountainRangeLeafDerivedClass *MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeafByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const {
 
 	// Check if duplicate lookup values are allowed
 	if(MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES) {
@@ -365,32 +580,42 @@ template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRange
 	}
 	
 	// Check if lookup value doesn't exist in the lookup table
-	if(!lookupTable.contains(lookupValue)) {
+	const typename decltype(lookupTable)::const_iterator leafIndex = lookupTable.find(lookupValue);
+	if(leafIndex == lookupTable.cend()) {
 	
 		// Return null
 		return nullptr;
 	}
 	
-	// Return first leaf with the lookup value
-	return getLeaf(*lookupTable.at(lookupValue).cbegin());
+	// Return leaf with the lookup value
+	return getLeaf(leafIndex->second);
 }
 
 // Get leaf indices by lookup value
-template<typename MerkleMountainRangeLeafDerivedClass> const unordered_set<uint64_t> &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeafIndicesByLookupValue(const vector<uint8_t> &lookupValue) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> unordered_set<uint64_t> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeafIndicesByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const {
 
 	// Check if lookup value doesn't exist in the lookup table
-	if(!lookupTable.contains(lookupValue)) {
+	const pair leafIndices = lookupTable.equal_range(lookupValue);
+	if(leafIndices.first == leafIndices.second) {
 	
 		// Throw exception
 		throw runtime_error("Lookup value doesn't exist in the lookup table");
 	}
 	
+	// Go through all leaf indices with the lookup value
+	unordered_set<uint64_t> leafIndicesWithLookupValue;
+	for(typename decltype(lookupTable)::const_iterator i = leafIndices.first; i != leafIndices.second; ++i) {
+	
+		// Append leaf index to list
+		leafIndicesWithLookupValue.insert(i->second);
+	}
+	
 	// Return leaf indices with the lookup value
-	return lookupTable.at(lookupValue);
+	return leafIndicesWithLookupValue;
 }
 
 // Get leaf index by lookup value
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeafIndexByLookupValue(const vector<uint8_t> &lookupValue) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeafIndexByLookupValue(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue) const {
 
 	// Check if duplicate lookup values are allowed
 	if(MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES) {
@@ -399,12 +624,20 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 		throw runtime_error("Lookup value can be more than one leaf");
 	}
 	
-	// Return first leaf index with the lookup value
-	return *getLeafIndicesByLookupValue(lookupValue).cbegin();
+	// Check if lookup value doesn't exist in the lookup table
+	const typename decltype(lookupTable)::const_iterator leafIndex = lookupTable.find(lookupValue);
+	if(leafIndex == lookupTable.cend()) {
+	
+		// Throw exception
+		throw runtime_error("Lookup value doesn't exist in the lookup table");
+	}
+	
+	// Return leaf index with the lookup value
+	return leafIndex->second;
 }
 
 // Rewind to size
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::rewindToSize(const uint64_t size) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::rewindToSize(const uint64_t size) {
 
 	// Check if size is invalid
 	if(size > numberOfHashes || !isSizeValid(size) || size < minimumSize) {
@@ -419,13 +652,8 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	// Check if hashes exist
 	if(numberOfHashes) {
 	
-		// Check if unpruned hashes can be removed
-		const map<uint64_t, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>>::const_iterator start = unprunedHashes.upper_bound(numberOfHashes - 1);
-		if(start != unprunedHashes.cend()) {
-	
-			// Remove trailing unpruned hashes
-			unprunedHashes.erase(start, unprunedHashes.cend());
-		}
+		// Remove trailing unpruned hashes
+		unprunedHashes.eraseFromIndex(numberOfHashes);
 	}
 	
 	// Otherwise
@@ -442,28 +670,21 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	if(numberOfLeaves) {
 	
 		// Check if unpruned leaves can be removed
-		const typename map<uint64_t, MerkleMountainRangeLeafDerivedClass>::const_iterator start = unprunedLeaves.upper_bound(numberOfLeaves - 1);
+		const const_iterator start = unprunedLeaves.upper_bound(numberOfLeaves - 1);
 		if(start != unprunedLeaves.cend()) {
 		
 			// Go through all leaves that will be removed
-			for(typename map<uint64_t, MerkleMountainRangeLeafDerivedClass>::const_iterator i = start; i != unprunedLeaves.cend(); ++i) {
+			for(const_iterator i = start; i != unprunedLeaves.cend(); ++i) {
 			
 				// Get leaf
 				const MerkleMountainRangeLeafDerivedClass &leaf = i->second;
 				
 				// Check if leaf has a lookup value
-				const optional<vector<uint8_t>> lookupValue = leaf.getLookupValue();
+				const optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> lookupValue = leaf.getLookupValue();
 				if(lookupValue.has_value()) {
 				
 					// Remove leaf from lookup value from the lookup table
-					lookupTable.at(lookupValue.value()).erase(i->first);
-					
-					// Check if no more leaves have the lookup value
-					if(lookupTable.at(lookupValue.value()).empty()) {
-					
-						// Remove lookup value from the lookup table
-						lookupTable.erase(lookupValue.value());
-					}
+					removeFromLookupTable(lookupValue.value(), i->first);
 				}
 				
 				// Subtract from sum
@@ -493,22 +714,11 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 						unprunedLeaves.emplace(prunedLeafIndex, move(pruneList.extract(prunedLeafIndex).mapped()));
 						
 						// Check if pruned leaf has a lookup value
-						optional<vector<uint8_t>> lookupValue = unprunedLeaves.at(prunedLeafIndex).getLookupValue();
+						const optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> lookupValue = unprunedLeaves.at(prunedLeafIndex).getLookupValue();
 						if(lookupValue.has_value()) {
 						
-							// Check if lookup value exists in the lookup table
-							if(lookupTable.contains(lookupValue.value())) {
-							
-								// Add leaf to lookup value in the lookup table
-								lookupTable.at(lookupValue.value()).insert(prunedLeafIndex);
-							}
-							
-							// Otherwise
-							else {
-						
-								// Append lookup value to the lookup table
-								lookupTable.emplace(move(lookupValue.value()), unordered_set<uint64_t>({prunedLeafIndex}));
-							}
+							// Add leaf to lookup value in the lookup table
+							lookupTable.emplace(lookupValue.value(), prunedLeafIndex);
 						}
 						
 						// Add to sum
@@ -571,24 +781,31 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 		// Clear prune list
 		pruneList.clear();
 	}
+	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add rewind to size event to the journal
+		journal.push_back({JournalOperation::REWIND_TO_SIZE, size, nullopt});
+	}
 }
 
 // Rewind to number of leaves
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::rewindToNumberOfLeaves(const uint64_t numberOfLeaves) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::rewindToNumberOfLeaves(const uint64_t numberOfLeaves) {
 
 	// Rewind to size at the number of leaves
 	rewindToSize(getSizeAtNumberOfLeaves(numberOfLeaves));
 }
 
 // Get leaf's index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeafsIndex(const uint64_t leafIndex) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeafsIndex(const uint64_t leafIndex) {
 
 	// Return leaf's index
 	return 2 * leafIndex - Common::numberOfOnes(leafIndex);
 }
 
 // Clear
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::clear() {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::clear() {
 
 	// Set number of leaves to zero
 	numberOfLeaves = 0;
@@ -617,12 +834,57 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	// Clear prune list
 	pruneList.clear();
 	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add clear event to the journal
+		journal.push_back({JournalOperation::CLEAR, 0, nullopt});
+	}
+	
 	// Free memory
 	Common::freeMemory();
 }
 
+// Replace
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::replace(MerkleMountainRange &&other) {
+
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Check if the changes from self to other can be journaled
+		optional<vector<JournalEntry>> replacementJournal = getReplacementJournal(other);
+		if(replacementJournal.has_value()) {
+		
+			// Get journal with the changes from self to other appended to it
+			vector<JournalEntry> currentJournal = move(journal);
+			currentJournal.insert(currentJournal.cend(), make_move_iterator(replacementJournal.value().begin()), make_move_iterator(replacementJournal.value().end()));
+			
+			// Set self to other
+			*this = move(other);
+			
+			// Set journal to the current journal
+			journal = move(currentJournal);
+			
+			// Set journal started to true
+			journalStarted = true;
+			
+			// Return
+			return;
+		}
+	}
+	
+	// Set self to other
+	*this = move(other);
+	
+	// Clear journal
+	journal.clear();
+	
+	// Set journal started to false since the journal doesn't describe how self changed
+	journalStarted = false;
+}
+
 // Get root at size
-template<typename MerkleMountainRangeLeafDerivedClass> array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getRootAtSize(const uint64_t size) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getRootAtSize(const uint64_t size) const {
 
 	// Check if size is invalid
 	if(size > numberOfHashes || !isSizeValid(size) || size < minimumSize) {
@@ -630,96 +892,121 @@ template<typename MerkleMountainRangeLeafDerivedClass> array<uint8_t, Crypto::BL
 		// Throw exception
 		throw runtime_error("Size is invalid");
 	}
-
-	// Initialize root
-	array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> root;
 	
 	// Get peak indices at size
 	const vector peakIndices = getPeakIndicesAtSize(size);
 	
-	// Check if peak indices exist
-	if(!peakIndices.empty()) {
+	// Go through all peaks
+	vector<const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> *> peakHashes;
+	peakHashes.reserve(peakIndices.size());
 	
-		// Set root to the last peak's hash
-		memcpy(root.data(), unprunedHashes.at(*peakIndices.crbegin()).data(), root.size());
-		
-		// Go through all remaining peaks in reverse
-		for(vector<uint64_t>::const_reverse_iterator i = peakIndices.crbegin() + 1; i != peakIndices.crend(); ++i) {
-		
-			// Get peak hash
-			const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &peakHash = unprunedHashes.at(*i);
-			
-			// Create index and hashes
-			const uint64_t indexBigEndian = Common::hostByteOrderToBigEndian(size);
-			uint8_t indexAndHashes[sizeof(indexBigEndian) + peakHash.size() + root.size()];
-			memcpy(indexAndHashes, &indexBigEndian, sizeof(indexBigEndian));
-			memcpy(&indexAndHashes[sizeof(indexBigEndian)], peakHash.data(), peakHash.size());
-			memcpy(&indexAndHashes[sizeof(indexBigEndian) + peakHash.size()], root.data(), root.size());
-			
-			// Check if updating root failed
-			if(blake2b(root.data(), root.size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
-			
-				// Throw exception
-				throw runtime_error("Updating root failed");
-			}
-		}
-	}
+	for(const uint64_t peakIndex : peakIndices) {
 	
-	// Otherwise
-	else {
-	
-		// Set root to zero hash
-		root.fill(0);
+		// Append peak hash to list
+		peakHashes.push_back(&unprunedHashes.at(peakIndex));
 	}
 	
-	// Return root
-	return root;
+	// Return bagged peaks
+	return bagPeaks(size, peakHashes);
 }
 
 // Get root at number of leaves
-template<typename MerkleMountainRangeLeafDerivedClass> array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getRootAtNumberOfLeaves(const uint64_t numberOfLeaves) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getRootAtNumberOfLeaves(const uint64_t numberOfLeaves) const {
 
 	// Get root at size at the number of leaves
 	return getRootAtSize(getSizeAtNumberOfLeaves(numberOfLeaves));
 }
 
+// Get roots at sizes
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getRootsAtSizes(const vector<uint64_t> &sizes) const {
+
+	// Initialize roots
+	vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> roots;
+	roots.reserve(sizes.size());
+	
+	// Initialize peak indices and hashes
+	vector<uint64_t> peakIndices;
+	vector<const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> *> peakHashes;
+	
+	// Go through all sizes
+	for(const uint64_t size : sizes) {
+	
+		// Check if size is invalid
+		if(size > numberOfHashes || !isSizeValid(size) || size < minimumSize) {
+		
+			// Throw exception
+			throw runtime_error("Size is invalid");
+		}
+		
+		// Get peak indices at size
+		vector currentPeakIndices = getPeakIndicesAtSize(size);
+		
+		// Get number of peaks that didn't change since the previous size since peaks only change from the right as the size changes
+		vector<uint64_t>::size_type numberOfUnchangedPeaks = 0;
+		while(numberOfUnchangedPeaks < peakIndices.size() && numberOfUnchangedPeaks < currentPeakIndices.size() && peakIndices[numberOfUnchangedPeaks] == currentPeakIndices[numberOfUnchangedPeaks]) {
+		
+			// Increment number of unchanged peaks
+			++numberOfUnchangedPeaks;
+		}
+		
+		// Remove changed peaks' hashes
+		peakHashes.resize(numberOfUnchangedPeaks);
+		
+		// Go through all changed peaks
+		for(vector<uint64_t>::size_type i = numberOfUnchangedPeaks; i < currentPeakIndices.size(); ++i) {
+		
+			// Append peak hash to list
+			peakHashes.push_back(&unprunedHashes.at(currentPeakIndices[i]));
+		}
+		
+		// Set peak indices to the current peak indices
+		peakIndices = move(currentPeakIndices);
+		
+		// Append bagged peaks to list
+		roots.push_back(bagPeaks(size, peakHashes));
+	}
+	
+	// Return roots
+	return roots;
+}
+
 // Iterator constant begin
-template<typename MerkleMountainRangeLeafDerivedClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::const_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::cbegin() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::const_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::cbegin() const {
 
 	// Return unpruned leaves constant begin
 	return unprunedLeaves.cbegin();
 }
 
 // Iterator constant end
-template<typename MerkleMountainRangeLeafDerivedClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::const_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::cend() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::const_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::cend() const {
 
 	// Return unpruned leaves constant end
 	return unprunedLeaves.cend();
 }
 
 // Iterator constant reverse begin
-template<typename MerkleMountainRangeLeafDerivedClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::const_reverse_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::crbegin() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::const_reverse_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::crbegin() const {
 
 	// Return unpruned leaves constant reverse begin
 	return unprunedLeaves.crbegin();
 }
 
 // Iterator constant reverse end
-template<typename MerkleMountainRangeLeafDerivedClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::const_reverse_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::crend() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::const_reverse_iterator MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::crend() const {
 
 	// Return unpruned leaves constant reverse end
 	return unprunedLeaves.crend();
 }
 
 // Empty
-template<typename MerkleMountainRangeLeafDerivedClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::empty() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::empty() const {
 
 	// Return if unpruned leaves is empty
 	return unprunedLeaves.empty();
 }
 
 // Front
-template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRangeLeafDerivedClass &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::front() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> const MerkleMountainRangeLeafDerivedClass &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::front() const {
 
 	// Check if no unpruned leaves exist
 	if(unprunedLeaves.empty()) {
@@ -733,7 +1020,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRange
 }
 
 // Back
-template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRangeLeafDerivedClass &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::back() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> const MerkleMountainRangeLeafDerivedClass &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::back() const {
 
 	// Check if no unpruned leaves exist
 	if(unprunedLeaves.empty()) {
@@ -747,14 +1034,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> const MerkleMountainRange
 }
 
 // Get sum
-template<typename MerkleMountainRangeLeafDerivedClass> const typename MerkleMountainRangeLeafDerivedClass::Sum &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getSum() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> const typename MerkleMountainRangeLeafDerivedClass::Sum &MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getSum() const {
 
 	// Return sum
 	return sum;
 }
 
 // Set minimum size
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::setMinimumSize(const uint64_t minimumSize) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::setMinimumSize(const uint64_t minimumSize) {
 
 	// Check if minimum size is invalid
 	if(!isSizeValid(minimumSize) || minimumSize < this->minimumSize) {
@@ -797,144 +1084,320 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 			pruneHistory.erase(pruneHistory.cbegin(), start);
 		}
 	}
+	
+	// Check if journal is started
+	if(journalStarted) {
+	
+		// Add set minimum size event to the journal
+		journal.push_back({JournalOperation::SET_MINIMUM_SIZE, minimumSize, nullopt});
+	}
 }
 
 // Get minimum size
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getMinimumSize() const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getMinimumSize() const {
 
 	// Return minimum size
 	return minimumSize;
 }
 
 // Save
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::save(ofstream &file) const {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::save(ofstream &file) const {
 
-	// Write lookup table size to file
-	const uint64_t serializedLookupTableSize = Common::hostByteOrderToBigEndian(lookupTable.size());
-	file.write(reinterpret_cast<const char *>(&serializedLookupTableSize), sizeof(serializedLookupTableSize));
+	// Write metadata section to file
+	saveSection(file, [&](ostream &section) -> void {
 	
-	// Go through all lookup values in the lookup table
-	for(const pair<const vector<uint8_t>, unordered_set<uint64_t>> &lookupValue : lookupTable) {
-	
-		// Write lookup value size to file
-		const uint64_t serializedLookupValueSize = Common::hostByteOrderToBigEndian(lookupValue.first.size());
-		file.write(reinterpret_cast<const char *>(&serializedLookupValueSize), sizeof(serializedLookupValueSize));
+		// Write number of leaves to section
+		const uint64_t serializedNumberOfLeaves = Common::hostByteOrderToBigEndian(numberOfLeaves);
+		section.write(reinterpret_cast<const char *>(&serializedNumberOfLeaves), sizeof(serializedNumberOfLeaves));
 		
-		// Write lookup value to file
-		file.write(reinterpret_cast<const char *>(lookupValue.first.data()), lookupValue.first.size());
+		// Write number of hashes to section
+		const uint64_t serializedNumberOfHashes = Common::hostByteOrderToBigEndian(numberOfHashes);
+		section.write(reinterpret_cast<const char *>(&serializedNumberOfHashes), sizeof(serializedNumberOfHashes));
 		
-		// Check if duplicate lookup values are allowed
-		if(MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES) {
+		// Write minimum size to section
+		const uint64_t serializedMinimumSize = Common::hostByteOrderToBigEndian(minimumSize);
+		section.write(reinterpret_cast<const char *>(&serializedMinimumSize), sizeof(serializedMinimumSize));
+		
+		// Write unpruned leaves size to section
+		const uint64_t serializedUnprunedLeavesSize = Common::hostByteOrderToBigEndian(unprunedLeaves.size());
+		section.write(reinterpret_cast<const char *>(&serializedUnprunedLeavesSize), sizeof(serializedUnprunedLeavesSize));
+		
+		// Write unpruned hashes size to section
+		const uint64_t serializedUnprunedHashesSize = Common::hostByteOrderToBigEndian(unprunedHashes.size());
+		section.write(reinterpret_cast<const char *>(&serializedUnprunedHashesSize), sizeof(serializedUnprunedHashesSize));
 		
-			// Write lookup value number of leaves to file
-			const uint64_t serializedLookupValueNumberOfLeaves = Common::hostByteOrderToBigEndian(lookupValue.second.size());
-			file.write(reinterpret_cast<const char *>(&serializedLookupValueNumberOfLeaves), sizeof(serializedLookupValueNumberOfLeaves));
+		// Write prune list size to section
+		const uint64_t serializedPruneListSize = Common::hostByteOrderToBigEndian(pruneList.size());
+		section.write(reinterpret_cast<const char *>(&serializedPruneListSize), sizeof(serializedPruneListSize));
+		
+		// Write prune history size to section
+		const uint64_t serializedPruneHistorySize = Common::hostByteOrderToBigEndian(pruneHistory.size());
+		section.write(reinterpret_cast<const char *>(&serializedPruneHistorySize), sizeof(serializedPruneHistorySize));
+		
+		// Write sum to section
+		MerkleMountainRangeLeafDerivedClass::saveSum(sum, section);
+	});
+	
+	// Write unpruned leaves section to file
+	saveSection(file, [&](ostream &section) -> void {
+	
+		// Go through all unpruned leaves
+		for(const pair<const uint64_t, MerkleMountainRangeLeafDerivedClass> &unprunedLeaf : unprunedLeaves) {
+		
+			// Write leaf index to section
+			const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(unprunedLeaf.first);
+			section.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
 			
-			// Go through all leaves in the lookup value
-			for(const uint64_t leafIndex : lookupValue.second) {
+			// Write leaf to section
+			unprunedLeaf.second.save(section);
+		}
+	});
+	
+	// Write unpruned hashes section to file
+	saveSection(file, [&](ostream &section) -> void {
+	
+		// Go through all unpruned hashes
+		for(typename HashesClass::ConstIterator i = unprunedHashes.cbegin(); i != unprunedHashes.cend(); ++i) {
+		
+			// Write index to section
+			const uint64_t serializedIndex = Common::hostByteOrderToBigEndian(i.getIndex());
+			section.write(reinterpret_cast<const char *>(&serializedIndex), sizeof(serializedIndex));
 			
-				// Write leaf index to file
-				const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(leafIndex);
-				file.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
-			}
+			// Write hash to section
+			section.write(reinterpret_cast<const char *>(i.getHash().data()), i.getHash().size());
 		}
+	});
+	
+	// Write prune list section to file
+	saveSection(file, [&](ostream &section) -> void {
+	
+		// Go through all leaves in the prune list
+		for(const pair<const uint64_t, MerkleMountainRangeLeafDerivedClass> &leaf : pruneList) {
 		
-		// Otherwise
-		else {
+			// Write leaf index to section
+			const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(leaf.first);
+			section.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+			
+			// Write leaf to section
+			leaf.second.save(section);
+		}
+	});
+	
+	// Write prune history section to file
+	saveSection(file, [&](ostream &section) -> void {
+	
+		// Go through all prune history events
+		for(const pair<const uint64_t, unordered_set<uint64_t>> &pruneHistoryEvent : pruneHistory) {
 		
-			// Write lookup value first leaf index to file
-			const uint64_t serializedFirstLeafIndex = Common::hostByteOrderToBigEndian(*lookupValue.second.cbegin());
-			file.write(reinterpret_cast<const char *>(&serializedFirstLeafIndex), sizeof(serializedFirstLeafIndex));
+			// Write prune history event number of leaves to section
+			const uint64_t serializedPruneHistoryEventNumberOfLeaves = Common::hostByteOrderToBigEndian(pruneHistoryEvent.first);
+			section.write(reinterpret_cast<const char *>(&serializedPruneHistoryEventNumberOfLeaves), sizeof(serializedPruneHistoryEventNumberOfLeaves));
+			
+			// Write prune history event size to section
+			const uint64_t serializedPruneHistoryEventSize = Common::hostByteOrderToBigEndian(pruneHistoryEvent.second.size());
+			section.write(reinterpret_cast<const char *>(&serializedPruneHistoryEventSize), sizeof(serializedPruneHistoryEventSize));
+			
+			// Go through all leaves pruned in the event
+			for(const uint64_t leafIndex : pruneHistoryEvent.second) {
+			
+				// Write leaf index to section
+				const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(leafIndex);
+				section.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+			}
 		}
-	}
+	});
+}
+
+// Restore
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::restore(ifstream &file) {
+
+	// Initialize Merkle mountain range
+	MerkleMountainRange merkleMountainRange;
 	
-	// Write unpruned leaves size to file
-	const uint64_t serializedUnprunedLeavesSize = Common::hostByteOrderToBigEndian(unprunedLeaves.size());
-	file.write(reinterpret_cast<const char *>(&serializedUnprunedLeavesSize), sizeof(serializedUnprunedLeavesSize));
+	// Read sections from file
+	istringstream metadataSection = restoreSection(file);
+	istringstream unprunedLeavesSection = restoreSection(file);
+	istringstream unprunedHashesSection = restoreSection(file);
+	istringstream pruneListSection = restoreSection(file);
+	istringstream pruneHistorySection = restoreSection(file);
 	
-	// Go through all unpruned leaves
-	for(const pair<const uint64_t, MerkleMountainRangeLeafDerivedClass> &unprunedLeaf : unprunedLeaves) {
+	// Read number of leaves from metadata section
+	uint64_t serializedNumberOfLeaves;
+	metadataSection.read(reinterpret_cast<char *>(&serializedNumberOfLeaves), sizeof(serializedNumberOfLeaves));
+	merkleMountainRange.numberOfLeaves = Common::bigEndianToHostByteOrder(serializedNumberOfLeaves);
 	
-		// Write leaf index to file
-		const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(unprunedLeaf.first);
-		file.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
-		
-		// Write leaf to file
-		unprunedLeaf.second.save(file);
-	}
+	// Read number of hashes from metadata section
+	uint64_t serializedNumberOfHashes;
+	metadataSection.read(reinterpret_cast<char *>(&serializedNumberOfHashes), sizeof(serializedNumberOfHashes));
+	merkleMountainRange.numberOfHashes = Common::bigEndianToHostByteOrder(serializedNumberOfHashes);
 	
-	// Write number of leaves to file
-	const uint64_t serializedNumberOfLeaves = Common::hostByteOrderToBigEndian(numberOfLeaves);
-	file.write(reinterpret_cast<const char *>(&serializedNumberOfLeaves), sizeof(serializedNumberOfLeaves));
+	// Read minimum size from metadata section
+	uint64_t serializedMinimumSize;
+	metadataSection.read(reinterpret_cast<char *>(&serializedMinimumSize), sizeof(serializedMinimumSize));
+	merkleMountainRange.minimumSize = Common::bigEndianToHostByteOrder(serializedMinimumSize);
 	
-	// Write unpruned hashes size to file
-	const uint64_t serializedUnprunedHashesSize = Common::hostByteOrderToBigEndian(unprunedHashes.size());
-	file.write(reinterpret_cast<const char *>(&serializedUnprunedHashesSize), sizeof(serializedUnprunedHashesSize));
+	// Read unpruned leaves size from metadata section
+	uint64_t serializedUnprunedLeavesSize;
+	metadataSection.read(reinterpret_cast<char *>(&serializedUnprunedLeavesSize), sizeof(serializedUnprunedLeavesSize));
+	const uint64_t unprunedLeavesSize = Common::bigEndianToHostByteOrder(serializedUnprunedLeavesSize);
 	
-	// Go through all unpruned hashes
-	for(const pair<const uint64_t, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> &unprunedHash : unprunedHashes) {
+	// Read unpruned hashes size from metadata section
+	uint64_t serializedUnprunedHashesSize;
+	metadataSection.read(reinterpret_cast<char *>(&serializedUnprunedHashesSize), sizeof(serializedUnprunedHashesSize));
+	const uint64_t unprunedHashesSize = Common::bigEndianToHostByteOrder(serializedUnprunedHashesSize);
 	
-		// Write index to file
-		const uint64_t serializedIndex = Common::hostByteOrderToBigEndian(unprunedHash.first);
-		file.write(reinterpret_cast<const char *>(&serializedIndex), sizeof(serializedIndex));
+	// Read prune list size from metadata section
+	uint64_t serializedPruneListSize;
+	metadataSection.read(reinterpret_cast<char *>(&serializedPruneListSize), sizeof(serializedPruneListSize));
+	const uint64_t pruneListSize = Common::bigEndianToHostByteOrder(serializedPruneListSize);
+	
+	// Read prune history size from metadata section
+	uint64_t serializedPruneHistorySize;
+	metadataSection.read(reinterpret_cast<char *>(&serializedPruneHistorySize), sizeof(serializedPruneHistorySize));
+	const uint64_t pruneHistorySize = Common::bigEndianToHostByteOrder(serializedPruneHistorySize);
+	
+	// Read sum from metadata section
+	MerkleMountainRangeLeafDerivedClass::restoreSum(merkleMountainRange.sum, metadataSection);
+	
+	// Go through all unpruned leaves
+	merkleMountainRange.lookupTable.reserve(unprunedLeavesSize);
+	for(uint64_t i = 0; i < unprunedLeavesSize; ++i) {
+	
+		// Read leaf index from unpruned leaves section
+		uint64_t serializedLeafIndex;
+		unprunedLeavesSection.read(reinterpret_cast<char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+		const uint64_t leafIndex = Common::bigEndianToHostByteOrder(serializedLeafIndex);
+		
+		// Check if leaf index is invalid
+		if(leafIndex >= merkleMountainRange.numberOfLeaves || (!merkleMountainRange.unprunedLeaves.empty() && leafIndex <= merkleMountainRange.unprunedLeaves.crbegin()->first)) {
+		
+			// Throw exception
+			throw runtime_error("Leaf index is invalid");
+		}
+		
+		// Read leaf from unpruned leaves section and append it to unpruned leaves
+		const const_iterator leaf = merkleMountainRange.unprunedLeaves.emplace_hint(merkleMountainRange.unprunedLeaves.cend(), leafIndex, MerkleMountainRangeLeafDerivedClass::restore(unprunedLeavesSection));
 		
-		// Write hash to file
-		file.write(reinterpret_cast<const char *>(unprunedHash.second.data()), unprunedHash.second.size());
+		// Check if leaf has a lookup value
+		const optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> lookupValue = leaf->second.getLookupValue();
+		if(lookupValue.has_value()) {
+		
+			// Check if duplicate lookup values aren't allowed and the lookup value exists in the lookup table
+			if(!MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES && merkleMountainRange.lookupTable.contains(lookupValue.value())) {
+			
+				// Throw exception
+				throw runtime_error("Lookup value already exists in the lookup table");
+			}
+			
+			// Add leaf to lookup value in the lookup table
+			merkleMountainRange.lookupTable.emplace(lookupValue.value(), leafIndex);
+		}
 	}
 	
-	// Write number of hashes to file
-	const uint64_t serializedNumberOfHashes = Common::hostByteOrderToBigEndian(numberOfHashes);
-	file.write(reinterpret_cast<const char *>(&serializedNumberOfHashes), sizeof(serializedNumberOfHashes));
+	// Go through all unpruned hashes
+	for(uint64_t i = 0; i < unprunedHashesSize; ++i) {
 	
-	// Write minimum size to file
-	const uint64_t serializedMinimumSize = Common::hostByteOrderToBigEndian(minimumSize);
-	file.write(reinterpret_cast<const char *>(&serializedMinimumSize), sizeof(serializedMinimumSize));
+		// Read index from unpruned hashes section
+		uint64_t serializedIndex;
+		unprunedHashesSection.read(reinterpret_cast<char *>(&serializedIndex), sizeof(serializedIndex));
+		const uint64_t index = Common::bigEndianToHostByteOrder(serializedIndex);
+		
+		// Check if index is invalid
+		if(index >= merkleMountainRange.numberOfHashes) {
+		
+			// Throw exception
+			throw runtime_error("Index is invalid");
+		}
+		
+		// Read hash from unpruned hashes section
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> hash;
+		unprunedHashesSection.read(reinterpret_cast<char *>(hash.data()), hash.size());
+		
+		// Add hash to unpruned hashes
+		merkleMountainRange.unprunedHashes.emplace(index, hash);
+	}
 	
-	// Write sum to file
-	MerkleMountainRangeLeafDerivedClass::saveSum(sum, file);
+	// Go through all leaves in the prune list
+	merkleMountainRange.pruneList.reserve(pruneListSize);
+	for(uint64_t i = 0; i < pruneListSize; ++i) {
 	
-	// Write prune history size to file
-	const uint64_t serializedPruneHistorySize = Common::hostByteOrderToBigEndian(pruneHistory.size());
-	file.write(reinterpret_cast<const char *>(&serializedPruneHistorySize), sizeof(serializedPruneHistorySize));
+		// Read leaf index from prune list section
+		uint64_t serializedLeafIndex;
+		pruneListSection.read(reinterpret_cast<char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+		const uint64_t leafIndex = Common::bigEndianToHostByteOrder(serializedLeafIndex);
+		
+		// Check if leaf index is invalid
+		if(leafIndex >= merkleMountainRange.numberOfLeaves || merkleMountainRange.unprunedLeaves.contains(leafIndex)) {
+		
+			// Throw exception
+			throw runtime_error("Leaf index is invalid");
+		}
+		
+		// Check if reading leaf from prune list section and adding it to prune list failed
+		if(!merkleMountainRange.pruneList.emplace(leafIndex, MerkleMountainRangeLeafDerivedClass::restore(pruneListSection)).second) {
+		
+			// Throw exception
+			throw runtime_error("Leaf index is invalid");
+		}
+	}
 	
 	// Go through all prune history events
-	for(const pair<const uint64_t, unordered_set<uint64_t>> &pruneHistoryEvent : pruneHistory) {
+	for(uint64_t i = 0; i < pruneHistorySize; ++i) {
 	
-		// Write prune history event number of leaves to file
-		const uint64_t serializedPruneHistoryEventNumberOfLeaves = Common::hostByteOrderToBigEndian(pruneHistoryEvent.first);
-		file.write(reinterpret_cast<const char *>(&serializedPruneHistoryEventNumberOfLeaves), sizeof(serializedPruneHistoryEventNumberOfLeaves));
+		// Read prune history event number of leaves from prune history section
+		uint64_t serializedPruneHistoryEventNumberOfLeaves;
+		pruneHistorySection.read(reinterpret_cast<char *>(&serializedPruneHistoryEventNumberOfLeaves), sizeof(serializedPruneHistoryEventNumberOfLeaves));
+		const uint64_t pruneHistoryEventNumberOfLeaves = Common::bigEndianToHostByteOrder(serializedPruneHistoryEventNumberOfLeaves);
+		
+		// Check if prune history event number of leaves is invalid
+		if(pruneHistoryEventNumberOfLeaves > merkleMountainRange.numberOfLeaves || (!merkleMountainRange.pruneHistory.empty() && pruneHistoryEventNumberOfLeaves <= merkleMountainRange.pruneHistory.crbegin()->first)) {
+		
+			// Throw exception
+			throw runtime_error("Prune history event number of leaves is invalid");
+		}
 		
-		// Write prune history event size to file
-		const uint64_t serializedPruneHistoryEventSize = Common::hostByteOrderToBigEndian(pruneHistoryEvent.second.size());
-		file.write(reinterpret_cast<const char *>(&serializedPruneHistoryEventSize), sizeof(serializedPruneHistoryEventSize));
+		// Read prune history event size from prune history section
+		uint64_t serializedPruneHistoryEventSize;
+		pruneHistorySection.read(reinterpret_cast<char *>(&serializedPruneHistoryEventSize), sizeof(serializedPruneHistoryEventSize));
+		const uint64_t pruneHistoryEventSize = Common::bigEndianToHostByteOrder(serializedPruneHistoryEventSize);
 		
 		// Go through all leaves pruned in the event
-		for(const uint64_t leafIndex : pruneHistoryEvent.second) {
+		unordered_set<uint64_t> prunedLeaves;
+		for(uint64_t j = 0; j < pruneHistoryEventSize; ++j) {
 		
-			// Write leaf index to file
-			const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(leafIndex);
-			file.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+			// Read leaf index from prune history section
+			uint64_t serializedLeafIndex;
+			pruneHistorySection.read(reinterpret_cast<char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
+			const uint64_t leafIndex = Common::bigEndianToHostByteOrder(serializedLeafIndex);
+			
+			// Check if leaf index isn't in the prune list
+			if(!merkleMountainRange.pruneList.contains(leafIndex)) {
+			
+				// Throw exception
+				throw runtime_error("Leaf index is invalid");
+			}
+			
+			// Add leaf index to pruned leaves
+			prunedLeaves.insert(leafIndex);
 		}
+		
+		// Add prune history event to prune history events
+		merkleMountainRange.pruneHistory.emplace_hint(merkleMountainRange.pruneHistory.cend(), pruneHistoryEventNumberOfLeaves, move(prunedLeaves));
 	}
 	
-	// Write prune list size to file
-	const uint64_t serializedPruneListSize = Common::hostByteOrderToBigEndian(pruneList.size());
-	file.write(reinterpret_cast<const char *>(&serializedPruneListSize), sizeof(serializedPruneListSize));
-	
-	// Go through all leaves in the prune list
-	for(const pair<const uint64_t, MerkleMountainRangeLeafDerivedClass> &leaf : pruneList) {
+	// Check if sections contain more data than expected
+	if(metadataSection.peek() != istringstream::traits_type::eof() || unprunedLeavesSection.peek() != istringstream::traits_type::eof() || unprunedHashesSection.peek() != istringstream::traits_type::eof() || pruneListSection.peek() != istringstream::traits_type::eof() || pruneHistorySection.peek() != istringstream::traits_type::eof()) {
 	
-		// Write leaf index to file
-		const uint64_t serializedLeafIndex = Common::hostByteOrderToBigEndian(leaf.first);
-		file.write(reinterpret_cast<const char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
-		
-		// Write leaf to file
-		leaf.second.save(file);
+		// Throw exception
+		throw runtime_error("Sections are invalid");
 	}
+	
+	// Return Merkle mountain range
+	return merkleMountainRange;
 }
 
-// Restore
-template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::restore(ifstream &file) {
+// Restore legacy
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::restoreLegacy(ifstream &file) {
 
 	// Initialize Merkle mountain range
 	MerkleMountainRange merkleMountainRange;
@@ -951,8 +1414,15 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 		uint64_t serializedLookupValueSize;
 		file.read(reinterpret_cast<char *>(&serializedLookupValueSize), sizeof(serializedLookupValueSize));
 		
+		// Check if lookup value size is invalid
+		if(Common::bigEndianToHostByteOrder(serializedLookupValueSize) != Crypto::COMMITMENT_LENGTH) {
+		
+			// Throw exception
+			throw runtime_error("Lookup value size is invalid");
+		}
+		
 		// Read lookup value from file
-		vector<uint8_t> lookupValue(Common::bigEndianToHostByteOrder(serializedLookupValueSize));
+		array<uint8_t, Crypto::COMMITMENT_LENGTH> lookupValue;
 		file.read(reinterpret_cast<char *>(lookupValue.data()), lookupValue.size());
 		
 		// Check if duplicate lookup values are allowed
@@ -964,19 +1434,15 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 			const uint64_t lookupValueNumberOfLeaves = Common::bigEndianToHostByteOrder(serializedLookupValueNumberOfLeaves);
 			
 			// Go through all leaves in the lookup value
-			unordered_set<uint64_t> leaves;
 			for(uint64_t j = 0; j < lookupValueNumberOfLeaves; ++j) {
 			
 				// Read leaf index from file
 				uint64_t serializedLeafIndex;
 				file.read(reinterpret_cast<char *>(&serializedLeafIndex), sizeof(serializedLeafIndex));
 				
-				// Add leaf index to leaves
-				leaves.insert(Common::bigEndianToHostByteOrder(serializedLeafIndex));
+				// Add leaf to lookup value in the lookup table
+				merkleMountainRange.lookupTable.emplace(lookupValue, Common::bigEndianToHostByteOrder(serializedLeafIndex));
 			}
-			
-			// Add lookup value to lookup table
-			merkleMountainRange.lookupTable.emplace(move(lookupValue), move(leaves));
 		}
 		
 		// Otherwise
@@ -987,7 +1453,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 			file.read(reinterpret_cast<char *>(&serializedFirstLeafIndex), sizeof(serializedFirstLeafIndex));
 			
 			// Add lookup value to lookup table
-			merkleMountainRange.lookupTable.emplace(move(lookupValue), unordered_set<uint64_t>({Common::bigEndianToHostByteOrder(serializedFirstLeafIndex)}));
+			merkleMountainRange.lookupTable.emplace(lookupValue, Common::bigEndianToHostByteOrder(serializedFirstLeafIndex));
 		}
 	}
 	
@@ -1029,7 +1495,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 		file.read(reinterpret_cast<char *>(hash.data()), hash.size());
 		
 		// Add hash to unpruned hashes
-		merkleMountainRange.unprunedHashes.emplace(Common::bigEndianToHostByteOrder(serializedIndex), move(hash));
+		merkleMountainRange.unprunedHashes.emplace(Common::bigEndianToHostByteOrder(serializedIndex), hash);
 	}
 	
 	// Read number of hashes from file
@@ -1098,8 +1564,158 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 	return merkleMountainRange;
 }
 
+// Start journal
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::startJournal() {
+
+	// Clear journal
+	journal.clear();
+	
+	// Set journal started to true
+	journalStarted = true;
+}
+
+// Is journal started
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::isJournalStarted() const {
+
+	// Return if journal is started
+	return journalStarted;
+}
+
+// Take journal
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> vector<typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::JournalEntry> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::takeJournal() {
+
+	// Get journal
+	vector<JournalEntry> result = move(journal);
+	
+	// Clear journal
+	journal.clear();
+	
+	// Return result
+	return result;
+}
+
+// Apply journal
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::applyJournal(ifstream &file) {
+
+	// Read journal size from file
+	uint64_t serializedJournalSize;
+	file.read(reinterpret_cast<char *>(&serializedJournalSize), sizeof(serializedJournalSize));
+	const uint64_t journalSize = Common::bigEndianToHostByteOrder(serializedJournalSize);
+	
+	// Go through all events in the journal
+	for(uint64_t i = 0; i < journalSize; ++i) {
+	
+		// Read operation from file
+		underlying_type_t<JournalOperation> operation;
+		file.read(reinterpret_cast<char *>(&operation), sizeof(operation));
+		
+		// Read value from file
+		uint64_t serializedValue;
+		file.read(reinterpret_cast<char *>(&serializedValue), sizeof(serializedValue));
+		const uint64_t value = Common::bigEndianToHostByteOrder(serializedValue);
+		
+		// Check operation
+		switch(static_cast<JournalOperation>(operation)) {
+		
+			// Append leaf
+			case JournalOperation::APPEND_LEAF:
+			
+				// Check if leaf index is invalid
+				if(value != numberOfLeaves) {
+				
+					// Throw exception
+					throw runtime_error("Leaf index is invalid");
+				}
+				
+				// Read leaf from file and append it
+				appendLeaf(MerkleMountainRangeLeafDerivedClass::restore(file));
+				
+				// Break
+				break;
+				
+			// Prune leaf
+			case JournalOperation::PRUNE_LEAF:
+			
+				// Prune leaf
+				pruneLeaf(value);
+				
+				// Break
+				break;
+				
+			// Permanently prune leaf
+			case JournalOperation::PERMANENTLY_PRUNE_LEAF:
+			
+				// Permanently prune leaf
+				pruneLeaf(value, true);
+				
+				// Break
+				break;
+				
+			// Rewind to size
+			case JournalOperation::REWIND_TO_SIZE:
+			
+				// Rewind to size
+				rewindToSize(value);
+				
+				// Break
+				break;
+				
+			// Set minimum size
+			case JournalOperation::SET_MINIMUM_SIZE:
+			
+				// Set minimum size
+				setMinimumSize(value);
+				
+				// Break
+				break;
+				
+			// Clear
+			case JournalOperation::CLEAR:
+			
+				// Clear
+				clear();
+				
+				// Break
+				break;
+				
+			// Default
+			default:
+			
+				// Throw exception
+				throw runtime_error("Journal operation is invalid");
+		}
+	}
+}
+
+// Save journal
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::saveJournal(const vector<JournalEntry> &journal, ofstream &file) {
+
+	// Write journal size to file
+	const uint64_t serializedJournalSize = Common::hostByteOrderToBigEndian(journal.size());
+	file.write(reinterpret_cast<const char *>(&serializedJournalSize), sizeof(serializedJournalSize));
+	
+	// Go through all events in the journal
+	for(const JournalEntry &journalEntry : journal) {
+	
+		// Write operation to file
+		const underlying_type_t<JournalOperation> serializedOperation = static_cast<underlying_type_t<JournalOperation>>(journalEntry.operation);
+		file.write(reinterpret_cast<const char *>(&serializedOperation), sizeof(serializedOperation));
+		
+		// Write value to file
+		const uint64_t serializedValue = Common::hostByteOrderToBigEndian(journalEntry.value);
+		file.write(reinterpret_cast<const char *>(&serializedValue), sizeof(serializedValue));
+		
+		// Check if event has a leaf
+		if(journalEntry.leaf.has_value()) {
+		
+			// Write leaf to file
+			journalEntry.leaf.value().save(file);
+		}
+	}
+}
+
 // Create from ZIP
-template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::createFromZip(zip_t *zip, uint32_t protocolVersion, const char *dataPath, const char *hashesPath, const char *pruneListPath, const char *leafSetPath) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::createFromZip(zip_t *zip, uint32_t protocolVersion, const char *dataPath, const char *hashesPath, const char *pruneListPath, const char *leafSetPath) {
 
 	// Initialize prune list
 	roaring::Roaring pruneList;
@@ -1423,6 +2039,13 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 		
 		} while(bytesRead);
 		
+		// Check if the Merkle mountain range's leaves aren't valid
+		if(!MerkleMountainRangeLeafDerivedClass::verifyUnserialized(merkleMountainRange)) {
+		
+			// Throw exception
+			throw runtime_error("Merkle mountain range's leaves aren't valid");
+		}
+		
 		// Set expecting all hashes to if the prune list is empty and the leaf set doesn't exist
 		expectingAllHashes = pruneList.isEmpty() && !leafSetPath;
 	}
@@ -1491,7 +2114,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 		uint64_t readHashCount = 0;
 		
 		// Set all hashes index to the first unpruned hash index
-		map<uint64_t, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>>::const_iterator allHashesIndex = merkleMountainRange.unprunedHashes.cbegin();
+		typename HashesClass::ConstIterator allHashesIndex = merkleMountainRange.unprunedHashes.cbegin();
 		
 		// Set hashes index to the first hash index
 		set<uint64_t>::const_iterator hashesIndex = hashesIndices.cbegin();
@@ -1516,7 +2139,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 			if(expectingAllHashes) {
 			
 				// Get rank at node
-				rank = (allHashesIndex != merkleMountainRange.unprunedHashes.cend()) ? pruneList.rank(allHashesIndex->first + 1) : 0;
+				rank = (allHashesIndex != merkleMountainRange.unprunedHashes.cend()) ? pruneList.rank(allHashesIndex.getIndex() + 1) : 0;
 			}
 			
 			// Otherwise
@@ -1575,7 +2198,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 				if(expectingAllHashes) {
 				
 					// Check if no more hashes are expected or done reading the current hash
-					if(allHashesIndex == merkleMountainRange.unprunedHashes.cend() || ++readHashCount > allHashesIndex->first - hashShift) {
+					if(allHashesIndex == merkleMountainRange.unprunedHashes.cend() || ++readHashCount > allHashesIndex.getIndex() - hashShift) {
 					
 						// Break
 						break;
@@ -1618,7 +2241,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 				if(hashExpected) {
 				
 					// Set current hashes index to the current hashes index
-					const uint64_t currentHashesIndex = expectingAllHashes ? allHashesIndex->first : *hashesIndex;
+					const uint64_t currentHashesIndex = expectingAllHashes ? allHashesIndex.getIndex() : *hashesIndex;
 				
 					// Check if node at index doesn't have a hash
 					if(!merkleMountainRange.unprunedHashes.contains(currentHashesIndex)) {
@@ -1628,7 +2251,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 					}
 					
 					// Otherwise check if hash is invalid
-					else if(buffer != merkleMountainRange.unprunedHashes[currentHashesIndex]) {
+					else if(buffer != merkleMountainRange.unprunedHashes.at(currentHashesIndex)) {
 					
 						// Throw exception
 						throw runtime_error("Hash is invalid");
@@ -1687,7 +2310,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> MerkleMountainRange<Merkl
 }
 
 // Is size valid
-template<typename MerkleMountainRangeLeafDerivedClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::isSizeValid(const uint64_t size) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> bool MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::isSizeValid(const uint64_t size) {
 
 	// Set height to size
 	uint64_t height = size;
@@ -1712,7 +2335,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> bool MerkleMountainRange<
 }
 
 // Get number of leaves at size
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getNumberOfLeavesAtSize(const uint64_t size) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getNumberOfLeavesAtSize(const uint64_t size) {
 
 	// Check if size is invalid
 	if(!isSizeValid(size)) {
@@ -1750,7 +2373,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get size at number of leaves
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getSizeAtNumberOfLeaves(const uint64_t numberOfLeaves) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getSizeAtNumberOfLeaves(const uint64_t numberOfLeaves) {
 
 	// Check if no leaves exist
 	if(!numberOfLeaves) {
@@ -1773,40 +2396,142 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 	return index + 1;
 }
 
+// Constructor
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::SectionBuffer(streambuf *file) :
+
+	// Set file to file
+	file(file),
+	
+	// Set length to zero
+	length(0),
+	
+	// Set checksum to the initial checksum
+	checksum(crc32_z(0, nullptr, 0))
+{
+}
+
+// Get length
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::getLength() const {
+
+	// Return length
+	return length;
+}
+
+// Get checksum
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint32_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::getChecksum() const {
+
+	// Return checksum
+	return checksum;
+}
+
+// Overflow
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::int_type MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::overflow(const int_type character) {
+
+	// Check if character is the end of file
+	if(traits_type::eq_int_type(character, traits_type::eof())) {
+	
+		// Return not end of file
+		return traits_type::not_eof(character);
+	}
+	
+	// Return putting character
+	const char_type characterToPut = traits_type::to_char_type(character);
+	return (xsputn(&characterToPut, 1) == 1) ? character : traits_type::eof();
+}
+
+// Put characters
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> streamsize MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::SectionBuffer::xsputn(const char_type *characters, const streamsize numberOfCharacters) {
+
+	// Write characters to the file
+	const streamsize numberOfCharactersWritten = file->sputn(characters, numberOfCharacters);
+	
+	// Update length and checksum with the characters written
+	length += numberOfCharactersWritten;
+	checksum = crc32_z(checksum, reinterpret_cast<const Bytef *>(characters), numberOfCharactersWritten);
+	
+	// Return number of characters written
+	return numberOfCharactersWritten;
+}
+
+// Save section
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::saveSection(ofstream &file, const function<void(ostream &section)> &writeSection) {
+
+	// Write placeholder section length to file
+	const streampos sectionLengthPosition = file.tellp();
+	const uint64_t placeholderSectionLength = 0;
+	file.write(reinterpret_cast<const char *>(&placeholderSectionLength), sizeof(placeholderSectionLength));
+	
+	// Set section to write to the file through a section buffer that tracks its length and checksum
+	SectionBuffer sectionBuffer(file.rdbuf());
+	ostream section(&sectionBuffer);
+	section.exceptions(ios::badbit | ios::failbit);
+	
+	// Write section to file
+	writeSection(section);
+	
+	// Write section checksum to file
+	const uint32_t serializedSectionChecksum = htonl(sectionBuffer.getChecksum());
+	file.write(reinterpret_cast<const char *>(&serializedSectionChecksum), sizeof(serializedSectionChecksum));
+	
+	// Write section length to file before the section
+	const streampos sectionEndPosition = file.tellp();
+	file.seekp(sectionLengthPosition);
+	const uint64_t serializedSectionLength = Common::hostByteOrderToBigEndian(sectionBuffer.getLength());
+	file.write(reinterpret_cast<const char *>(&serializedSectionLength), sizeof(serializedSectionLength));
+	
+	// Go back to the end of the section in the file
+	file.seekp(sectionEndPosition);
+}
+
+// Restore section
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> istringstream MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::restoreSection(ifstream &file) {
+
+	// Read section length from file
+	uint64_t serializedSectionLength;
+	file.read(reinterpret_cast<char *>(&serializedSectionLength), sizeof(serializedSectionLength));
+	
+	// Read section from file
+	string contents(Common::bigEndianToHostByteOrder(serializedSectionLength), '\0');
+	file.read(contents.data(), contents.size());
+	
+	// Read section checksum from file
+	uint32_t serializedSectionChecksum;
+	file.read(reinterpret_cast<char *>(&serializedSectionChecksum), sizeof(serializedSectionChecksum));
+	
+	// Check if section is corrupt
+	if(ntohl(serializedSectionChecksum) != crc32_z(0, reinterpret_cast<const Bytef *>(contents.data()), contents.size())) {
+	
+		// Throw exception
+		throw runtime_error("Section is corrupt");
+	}
+	
+	// Set section to throw exception on error
+	istringstream section(move(contents));
+	section.exceptions(ios::badbit | ios::failbit);
+	
+	// Return section
+	return section;
+}
+
 // Append leaf or pruned leaf
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::appendLeafOrPrunedLeaf(optional<MerkleMountainRangeLeafDerivedClass> &&leafOrPrunedLeaf) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::appendLeafOrPrunedLeaf(optional<MerkleMountainRangeLeafDerivedClass> &&leafOrPrunedLeaf) {
 
 	// Check if leaf isn't pruned
 	if(leafOrPrunedLeaf.has_value()) {
 	
 		// Check if leaf has a lookup value
-		optional<vector<uint8_t>> lookupValue = leafOrPrunedLeaf.value().getLookupValue();
+		const optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> lookupValue = leafOrPrunedLeaf.value().getLookupValue();
 		if(lookupValue.has_value()) {
 		
-			// Check if lookup value exists in the lookup table
-			if(lookupTable.contains(lookupValue.value())) {
+			// Check if duplicate lookup values aren't allowed and the lookup value exists in the lookup table
+			if(!MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES && lookupTable.contains(lookupValue.value())) {
 			
-				// Check if duplicate lookup values are allowed
-				if(MerkleMountainRangeLeafDerivedClass::ALLOW_DUPLICATE_LOOKUP_VALUES) {
-				
-					// Add leaf to lookup value in the lookup table
-					lookupTable.at(lookupValue.value()).insert(numberOfLeaves);
-				}
-				
-				// Otherwise
-				else {
-				
-					// Throw exception
-					throw runtime_error("Lookup value already exists in the lookup table");
-				}
+				// Throw exception
+				throw runtime_error("Lookup value already exists in the lookup table");
 			}
 			
-			// Otherwise
-			else {
-			
-				// Append lookup value to the lookup table
-				lookupTable.emplace(move(lookupValue.value()), unordered_set<uint64_t>({numberOfLeaves}));
-			}
+			// Add leaf to lookup value in the lookup table
+			lookupTable.emplace(lookupValue.value(), numberOfLeaves);
 		}
 	
 		// Append leaf to list
@@ -1825,8 +2550,8 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 		memcpy(&indexAndLeaf[sizeof(indexBigEndian)], leafData.data(), leafData.size());
 		
 		// Check if creating leaf's hash failed
-		unprunedHashes.emplace(numberOfHashes, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
-		if(blake2b(unprunedHashes[numberOfHashes].data(), unprunedHashes[numberOfHashes].size(), indexAndLeaf, sizeof(indexAndLeaf), nullptr, 0)) {
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &leafHash = unprunedHashes.emplace(numberOfHashes, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
+		if(blake2b(leafHash.data(), leafHash.size(), indexAndLeaf, sizeof(indexAndLeaf), nullptr, 0)) {
 		
 			// Throw exception
 			throw runtime_error("Creating leaf's hash failed");
@@ -1850,14 +2575,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 		
 			// Create index and hashes
 			const uint64_t indexBigEndian = Common::hostByteOrderToBigEndian(i + 1);
-			uint8_t indexAndHashes[sizeof(indexBigEndian) + unprunedHashes[leftSiblingIndex].size() + unprunedHashes[i].size()];
+			uint8_t indexAndHashes[sizeof(indexBigEndian) + unprunedHashes.at(leftSiblingIndex).size() + unprunedHashes.at(i).size()];
 			memcpy(indexAndHashes, &indexBigEndian, sizeof(indexBigEndian));
-			memcpy(&indexAndHashes[sizeof(indexBigEndian)], unprunedHashes[leftSiblingIndex].data(), unprunedHashes[leftSiblingIndex].size());
-			memcpy(&indexAndHashes[sizeof(indexBigEndian) + unprunedHashes[leftSiblingIndex].size()], unprunedHashes[i].data(), unprunedHashes[i].size());
+			memcpy(&indexAndHashes[sizeof(indexBigEndian)], unprunedHashes.at(leftSiblingIndex).data(), unprunedHashes.at(leftSiblingIndex).size());
+			memcpy(&indexAndHashes[sizeof(indexBigEndian) + unprunedHashes.at(leftSiblingIndex).size()], unprunedHashes.at(i).data(), unprunedHashes.at(i).size());
 			
 			// Check if creating parent's hash failed
-			unprunedHashes.emplace(numberOfHashes, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
-			if(blake2b(unprunedHashes[numberOfHashes].data(), unprunedHashes[numberOfHashes].size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
+			array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &parentHash = unprunedHashes.emplace(numberOfHashes, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
+			if(blake2b(parentHash.data(), parentHash.size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
 			
 				// Throw exception
 				throw runtime_error("Creating parent's hash failed");
@@ -1869,8 +2594,127 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	}
 }
 
+// Get replacement journal
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> optional<vector<typename MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::JournalEntry>> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getReplacementJournal(MerkleMountainRange &other) const {
+
+	// Check if either has leaves that can be restored
+	if(!pruneList.empty() || !other.pruneList.empty()) {
+	
+		// Return nothing
+		return nullopt;
+	}
+	
+	// Get number of leaves that both have
+	const uint64_t commonNumberOfLeaves = min(numberOfLeaves, other.numberOfLeaves);
+	
+	// Go through all of the other's leading unpruned leaves that are pruned
+	for(const_iterator i = other.unprunedLeaves.cbegin(); i != other.unprunedLeaves.cend() && i->first < commonNumberOfLeaves && !unprunedLeaves.contains(i->first);) {
+	
+		// Get leaf index
+		const uint64_t leafIndex = i->first;
+		
+		// Go to next leaf
+		++i;
+		
+		// Permanently prune leaf in the other
+		other.pruneLeaf(leafIndex, true);
+	}
+	
+	// Check if other is smaller than the minimum size
+	if(other.numberOfHashes < minimumSize) {
+	
+		// Return nothing
+		return nullopt;
+	}
+	
+	// Check if other's minimum size is less than the minimum size
+	if(other.minimumSize < minimumSize) {
+	
+		// Set other's minimum size to the minimum size
+		other.setMinimumSize(minimumSize);
+	}
+	
+	// Check if the leaves at the other's minimum size aren't shared
+	uint64_t forkNumberOfLeaves = getNumberOfLeavesAtSize(other.minimumSize);
+	if(forkNumberOfLeaves > commonNumberOfLeaves || (forkNumberOfLeaves && getRootAtNumberOfLeaves(forkNumberOfLeaves) != other.getRootAtNumberOfLeaves(forkNumberOfLeaves))) {
+	
+		// Return nothing
+		return nullopt;
+	}
+	
+	// Go through all possible fork number of leaves
+	for(uint64_t maximumForkNumberOfLeaves = commonNumberOfLeaves; forkNumberOfLeaves < maximumForkNumberOfLeaves;) {
+	
+		// Get middle number of leaves between the fork number of leaves and the maximum fork number of leaves
+		const uint64_t middleNumberOfLeaves = forkNumberOfLeaves + (maximumForkNumberOfLeaves - forkNumberOfLeaves + 1) / 2;
+		
+		// Check if roots at the middle number of leaves are the same
+		if(getRootAtNumberOfLeaves(middleNumberOfLeaves) == other.getRootAtNumberOfLeaves(middleNumberOfLeaves)) {
+		
+			// Set fork number of leaves to the middle number of leaves
+			forkNumberOfLeaves = middleNumberOfLeaves;
+		}
+		
+		// Otherwise
+		else {
+		
+			// Set maximum fork number of leaves to before the middle number of leaves
+			maximumForkNumberOfLeaves = middleNumberOfLeaves - 1;
+		}
+	}
+	
+	// Check if more than half of the other's unpruned leaves would be appended
+	if(other.numberOfLeaves - forkNumberOfLeaves > other.unprunedLeaves.size() / 2) {
+	
+		// Return nothing since a snapshot is smaller than the journal
+		return nullopt;
+	}
+	
+	// Check if a different number of leaves before the fork are pruned since leaves are only permanently pruned from the front
+	if(unprunedLeaves.size() - distance(unprunedLeaves.lower_bound(forkNumberOfLeaves), unprunedLeaves.cend()) != other.unprunedLeaves.size() - distance(other.unprunedLeaves.lower_bound(forkNumberOfLeaves), other.unprunedLeaves.end())) {
+	
+		// Return nothing
+		return nullopt;
+	}
+	
+	// Initialize replacement journal
+	vector<JournalEntry> replacementJournal;
+	
+	// Check if leaves after the fork will be removed
+	if(forkNumberOfLeaves != numberOfLeaves) {
+	
+		// Add rewind to size event to the replacement journal
+		replacementJournal.push_back({JournalOperation::REWIND_TO_SIZE, getSizeAtNumberOfLeaves(forkNumberOfLeaves), nullopt});
+	}
+	
+	// Go through all of the other's leaves after the fork
+	for(uint64_t i = forkNumberOfLeaves; i < other.numberOfLeaves; ++i) {
+	
+		// Check if leaf is pruned
+		const MerkleMountainRangeLeafDerivedClass *leaf = other.getLeaf(i);
+		if(!leaf) {
+		
+			// Return nothing
+			return nullopt;
+		}
+		
+		// Add append leaf event to the replacement journal
+		replacementJournal.push_back({JournalOperation::APPEND_LEAF, i, *leaf});
+	}
+	
+	// Check if other's minimum size is greater than the minimum size
+	if(other.minimumSize != minimumSize) {
+	
+		// Add set minimum size event to the replacement journal
+		replacementJournal.push_back({JournalOperation::SET_MINIMUM_SIZE, other.minimumSize, nullopt});
+	}
+	
+	// Return replacement journal
+	return replacementJournal;
+}
+
 // Set hash at index
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::setHashAtIndex(const uint64_t index, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &&hash) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::setHashAtIndex(const uint64_t index, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &&hash) {
 
 	// Check if index is invalid
 	if(index >= numberOfHashes) {
@@ -1898,7 +2742,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	}
 	
 	// Set hash at index
-	unprunedHashes.emplace(index, move(hash));
+	unprunedHashes.emplace(index, hash);
 	
 	// Loop through all of the node's ancestors
 	for(uint64_t parentIndex = getParentIndex(index); parentIndex < numberOfHashes; parentIndex = getParentIndex(parentIndex)) {
@@ -1919,14 +2763,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 		
 			// Create index and hashes
 			const uint64_t indexBigEndian = Common::hostByteOrderToBigEndian(parentIndex);
-			uint8_t indexAndHashes[sizeof(indexBigEndian) + unprunedHashes[leftChildIndex].size() + unprunedHashes[rightChildIndex].size()];
+			uint8_t indexAndHashes[sizeof(indexBigEndian) + unprunedHashes.at(leftChildIndex).size() + unprunedHashes.at(rightChildIndex).size()];
 			memcpy(indexAndHashes, &indexBigEndian, sizeof(indexBigEndian));
-			memcpy(&indexAndHashes[sizeof(indexBigEndian)], unprunedHashes[leftChildIndex].data(), unprunedHashes[leftChildIndex].size());
-			memcpy(&indexAndHashes[sizeof(indexBigEndian) + unprunedHashes[leftChildIndex].size()], unprunedHashes[rightChildIndex].data(), unprunedHashes[rightChildIndex].size());
+			memcpy(&indexAndHashes[sizeof(indexBigEndian)], unprunedHashes.at(leftChildIndex).data(), unprunedHashes.at(leftChildIndex).size());
+			memcpy(&indexAndHashes[sizeof(indexBigEndian) + unprunedHashes.at(leftChildIndex).size()], unprunedHashes.at(rightChildIndex).data(), unprunedHashes.at(rightChildIndex).size());
 			
 			// Check if creating parent's hash failed
-			unprunedHashes.emplace(parentIndex, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
-			if(blake2b(unprunedHashes[parentIndex].data(), unprunedHashes[parentIndex].size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
+			array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &parentHash = unprunedHashes.emplace(parentIndex, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>());
+			if(blake2b(parentHash.data(), parentHash.size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
 			
 				// Throw exception
 				throw runtime_error("Creating parent's hash failed");
@@ -1943,7 +2787,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 }
 
 // Prune hash
-template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::pruneHash(const uint64_t leafIndex) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::pruneHash(const uint64_t leafIndex) {
 
 	// Get leaf's index
 	uint64_t index = getLeafsIndex(leafIndex);
@@ -2012,8 +2856,27 @@ template<typename MerkleMountainRangeLeafDerivedClass> void MerkleMountainRange<
 	}
 }
 
+// Remove from lookup table
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> void MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::removeFromLookupTable(const array<uint8_t, Crypto::COMMITMENT_LENGTH> &lookupValue, const uint64_t leafIndex) {
+
+	// Go through all leaf indices with the lookup value
+	const pair leafIndices = lookupTable.equal_range(lookupValue);
+	for(typename decltype(lookupTable)::const_iterator i = leafIndices.first; i != leafIndices.second; ++i) {
+	
+		// Check if leaf index is the leaf
+		if(i->second == leafIndex) {
+		
+			// Remove leaf from lookup value from the lookup table
+			lookupTable.erase(i);
+			
+			// Break
+			break;
+		}
+	}
+}
+
 // Get peak indices at size
-template<typename MerkleMountainRangeLeafDerivedClass> vector<uint64_t> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getPeakIndicesAtSize(const uint64_t size) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> vector<uint64_t> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getPeakIndicesAtSize(const uint64_t size) {
 
 	// Check if size is invalid
 	if(!isSizeValid(size)) {
@@ -2053,8 +2916,53 @@ template<typename MerkleMountainRangeLeafDerivedClass> vector<uint64_t> MerkleMo
 	return peakIndices;
 }
 
+// Bag peaks
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::bagPeaks(const uint64_t size, const vector<const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> *> &peakHashes) {
+
+	// Initialize root
+	array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> root;
+	
+	// Check if peaks exist
+	if(!peakHashes.empty()) {
+	
+		// Set root to the last peak's hash
+		memcpy(root.data(), (*peakHashes.crbegin())->data(), root.size());
+		
+		// Go through all remaining peaks in reverse
+		for(typename vector<const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> *>::const_reverse_iterator i = peakHashes.crbegin() + 1; i != peakHashes.crend(); ++i) {
+		
+			// Get peak hash
+			const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &peakHash = **i;
+			
+			// Create index and hashes
+			const uint64_t indexBigEndian = Common::hostByteOrderToBigEndian(size);
+			uint8_t indexAndHashes[sizeof(indexBigEndian) + peakHash.size() + root.size()];
+			memcpy(indexAndHashes, &indexBigEndian, sizeof(indexBigEndian));
+			memcpy(&indexAndHashes[sizeof(indexBigEndian)], peakHash.data(), peakHash.size());
+			memcpy(&indexAndHashes[sizeof(indexBigEndian) + peakHash.size()], root.data(), root.size());
+			
+			// Check if updating root failed
+			if(blake2b(root.data(), root.size(), indexAndHashes, sizeof(indexAndHashes), nullptr, 0)) {
+			
+				// Throw exception
+				throw runtime_error("Updating root failed");
+			}
+		}
+	}
+	
+	// Otherwise
+	else {
+	
+		// Set root to zero hash
+		root.fill(0);
+	}
+	
+	// Return root
+	return root;
+}
+
 // Get height at index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getHeightAtIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getHeightAtIndex(const uint64_t index) {
 
 	// Set height to index
 	uint64_t height = index;
@@ -2079,7 +2987,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get left sibling index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeftSiblingIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeftSiblingIndex(const uint64_t index) {
 
 	// Get height
 	const uint64_t height = getHeightAtIndex(index);
@@ -2089,7 +2997,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get right sibling index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getRightSiblingIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getRightSiblingIndex(const uint64_t index) {
 
 	// Get height
 	const uint64_t height = getHeightAtIndex(index);
@@ -2099,7 +3007,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get parent index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getParentIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getParentIndex(const uint64_t index) {
 
 	// Get height
 	const uint64_t height = getHeightAtIndex(index);
@@ -2120,7 +3028,7 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get left child index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getLeftChildIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getLeftChildIndex(const uint64_t index) {
 
 	// Get height
 	const uint64_t height = getHeightAtIndex(index);
@@ -2130,14 +3038,14 @@ template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRa
 }
 
 // Get right child index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getRightChildIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getRightChildIndex(const uint64_t index) {
 
 	// Return right child index
 	return index - 1;
 }
 
 // Get next peak index
-template<typename MerkleMountainRangeLeafDerivedClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass>::getNextPeakIndex(const uint64_t index) {
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> uint64_t MerkleMountainRange<MerkleMountainRangeLeafDerivedClass, HashesClass>::getNextPeakIndex(const uint64_t index) {
 
 	// Set peak index to the next index
 	uint64_t peakIndex = index + 1;
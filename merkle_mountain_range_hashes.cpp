@@ -0,0 +1,736 @@
+// Header files
+#include "./common.h"
+#include <bit>
+#include <new>
+#include "./merkle_mountain_range_hashes.h"
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+	// Header files
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+// Namespace
+using namespace MwcValidationNode;
+
+
+// Constants
+
+// End index
+const uint64_t MerkleMountainRangeHashes::END_INDEX = numeric_limits<uint64_t>::max();
+
+// Sparse page threshold
+const uint64_t MerkleMountainRangeHashes::SPARSE_PAGE_THRESHOLD = MerkleMountainRangeHashes::PAGE_LENGTH / 4;
+
+// Sparse page maximum length
+const uint64_t MerkleMountainRangeHashes::SPARSE_PAGE_MAXIMUM_LENGTH = MerkleMountainRangeHashes::PAGE_LENGTH / 2;
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+	// Check if number of hot pages is set
+	#ifdef SET_NUMBER_OF_HOT_MERKLE_MOUNTAIN_RANGE_HASHES_PAGES
+	
+		// Number of hot pages
+		const uint64_t MerkleMountainRangeHashes::NUMBER_OF_HOT_PAGES = SET_NUMBER_OF_HOT_MERKLE_MOUNTAIN_RANGE_HASHES_PAGES;
+		
+	// Otherwise
+	#else
+	
+		// Number of hot pages
+		const uint64_t MerkleMountainRangeHashes::NUMBER_OF_HOT_PAGES = 16;
+	#endif
+#endif
+
+
+// Supporting function implementation
+
+// Constructor
+MerkleMountainRangeHashes::ConstIterator::ConstIterator(const MerkleMountainRangeHashes &hashes, const uint64_t index) :
+
+	// Set hashes to hashes
+	hashes(&hashes),
+	
+	// Set index to index
+	index(index)
+{
+}
+
+// Get index
+uint64_t MerkleMountainRangeHashes::ConstIterator::getIndex() const {
+
+	// Return index
+	return index;
+}
+
+// Get hash
+const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &MerkleMountainRangeHashes::ConstIterator::getHash() const {
+
+	// Return hash at index
+	return hashes->at(index);
+}
+
+// Increment operator
+MerkleMountainRangeHashes::ConstIterator &MerkleMountainRangeHashes::ConstIterator::operator++() {
+
+	// Set index to the next unpruned hash's index
+	index = hashes->getNextIndex(index + 1);
+	
+	// Return self
+	return *this;
+}
+
+// Equality operator
+bool MerkleMountainRangeHashes::ConstIterator::operator==(const ConstIterator &other) const {
+
+	// Return if hashes and indices are the same
+	return hashes == other.hashes && index == other.index;
+}
+
+// Inequality operator
+bool MerkleMountainRangeHashes::ConstIterator::operator!=(const ConstIterator &other) const {
+
+	// Return if not equal
+	return !(*this == other);
+}
+
+// Constructor
+MerkleMountainRangeHashes::MerkleMountainRangeHashes() :
+
+	// Set number of hashes to zero
+	numberOfHashes(0)
+{
+}
+
+// Copy constructor
+MerkleMountainRangeHashes::MerkleMountainRangeHashes(const MerkleMountainRangeHashes &other) :
+
+	// Delegate constructor
+	MerkleMountainRangeHashes()
+{
+
+	// Go through all of the other's pages
+	pages.reserve(other.pages.size());
+	sparsePages.reserve(other.sparsePages.size());
+	for(vector<Page *>::size_type i = 0; i < other.pages.size(); ++i) {
+	
+		// Check if page exists
+		if(other.pages[i]) {
+		
+			// Append copy of page to list
+			pages.push_back(allocatePage());
+			*pages.back() = *other.pages[i];
+		}
+		
+		// Otherwise
+		else {
+		
+			// Append no page to list
+			pages.push_back(nullptr);
+		}
+		
+		// Check if sparse page exists
+		if(other.sparsePages[i]) {
+		
+			// Append copy of sparse page to list
+			sparsePages.push_back(new SparsePage(*other.sparsePages[i]));
+		}
+		
+		// Otherwise
+		else {
+		
+			// Append no sparse page to list
+			sparsePages.push_back(nullptr);
+		}
+	}
+	
+	// Set number of hashes to other's number of hashes
+	numberOfHashes = other.numberOfHashes;
+}
+
+// Move constructor
+MerkleMountainRangeHashes::MerkleMountainRangeHashes(MerkleMountainRangeHashes &&other) :
+
+	// Delegate constructor
+	MerkleMountainRangeHashes()
+{
+
+	// Move other to self
+	*this = move(other);
+}
+
+// Destructor
+MerkleMountainRangeHashes::~MerkleMountainRangeHashes() {
+
+	// Clear
+	clear();
+}
+
+// Copy assignment operator
+MerkleMountainRangeHashes &MerkleMountainRangeHashes::operator=(const MerkleMountainRangeHashes &other) {
+
+	// Check if not self
+	if(this != &other) {
+	
+		// Set self to a copy of other
+		*this = MerkleMountainRangeHashes(other);
+	}
+	
+	// Return self
+	return *this;
+}
+
+// Move assignment operator
+MerkleMountainRangeHashes &MerkleMountainRangeHashes::operator=(MerkleMountainRangeHashes &&other) {
+
+	// Swap self and other so that other frees self's previous pages
+	swap(pages, other.pages);
+	swap(sparsePages, other.sparsePages);
+	swap(numberOfHashes, other.numberOfHashes);
+	
+	// Return self
+	return *this;
+}
+
+// Contains
+bool MerkleMountainRangeHashes::contains(const uint64_t index) const {
+
+	// Get page index and offset
+	const uint64_t pageIndex = index / PAGE_LENGTH;
+	const uint64_t offset = index % PAGE_LENGTH;
+	
+	// Check if page doesn't exist
+	if(pageIndex >= pages.size()) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if page is sparse
+	if(sparsePages[pageIndex]) {
+	
+		// Return if the sparse page contains the offset
+		return binary_search(sparsePages[pageIndex]->offsets.cbegin(), sparsePages[pageIndex]->offsets.cend(), offset);
+	}
+	
+	// Return if page is allocated and the hash at the offset is unpruned
+	return pages[pageIndex] && (pages[pageIndex]->unprunedWords[offset / BITS_PER_WORD] & (static_cast<uint64_t>(1) << (offset % BITS_PER_WORD)));
+}
+
+// At
+const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &MerkleMountainRangeHashes::at(const uint64_t index) const {
+
+	// Check if hash doesn't exist
+	if(!contains(index)) {
+	
+		// Throw exception
+		throw out_of_range("Hash doesn't exist");
+	}
+	
+	// Get page index and offset
+	const uint64_t pageIndex = index / PAGE_LENGTH;
+	const uint64_t offset = index % PAGE_LENGTH;
+	
+	// Check if page is sparse
+	if(sparsePages[pageIndex]) {
+	
+		// Get sparse page
+		const SparsePage &sparsePage = *sparsePages[pageIndex];
+		
+		// Return sparse page's hash at the offset
+		return sparsePage.hashes[lower_bound(sparsePage.offsets.cbegin(), sparsePage.offsets.cend(), offset) - sparsePage.offsets.cbegin()];
+	}
+	
+	// Return hash at the offset
+	return pages[pageIndex]->hashes[offset];
+}
+
+// Emplace
+array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &MerkleMountainRangeHashes::emplace(const uint64_t index, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &hash) {
+
+	// Get page index and offset
+	const uint64_t pageIndex = index / PAGE_LENGTH;
+	const uint64_t offset = index % PAGE_LENGTH;
+	
+	// Check if page doesn't exist
+	if(pageIndex >= pages.size()) {
+	
+		// Add missing pages
+		pages.resize(pageIndex + 1);
+		sparsePages.resize(pageIndex + 1);
+	}
+	
+	// Check if page is sparse
+	if(sparsePages[pageIndex]) {
+	
+		// Get sparse page
+		SparsePage &sparsePage = *sparsePages[pageIndex];
+		
+		// Get where the offset is or would be in the sparse page
+		const vector<uint16_t>::iterator position = lower_bound(sparsePage.offsets.begin(), sparsePage.offsets.end(), offset);
+		const vector<uint16_t>::difference_type positionIndex = position - sparsePage.offsets.begin();
+		
+		// Check if hash at the offset is unpruned
+		if(position != sparsePage.offsets.end() && *position == offset) {
+		
+			// Return hash at the offset
+			return sparsePage.hashes[positionIndex];
+		}
+		
+		// Check if sparse page isn't full
+		if(sparsePage.offsets.size() < SPARSE_PAGE_MAXIMUM_LENGTH) {
+		
+			// Insert offset and hash into the sparse page
+			sparsePage.offsets.insert(position, offset);
+			sparsePage.hashes.insert(sparsePage.hashes.begin() + positionIndex, hash);
+			
+			// Increment number of hashes
+			++numberOfHashes;
+			
+			// Return hash at the offset
+			return sparsePage.hashes[positionIndex];
+		}
+		
+		// Make page dense
+		makePageDense(pageIndex);
+	}
+	
+	// Check if page isn't allocated
+	if(!pages[pageIndex]) {
+	
+		// Allocate page
+		pages[pageIndex] = allocatePage();
+		
+		// Check if the previous page exists and has few enough unpruned hashes to be sparse
+		if(pageIndex && pages[pageIndex - 1] && pages[pageIndex - 1]->numberOfUnprunedHashes <= SPARSE_PAGE_THRESHOLD) {
+		
+			// Make previous page sparse since hashes are only appended to the last page
+			makePageSparse(pageIndex - 1);
+		}
+		
+		// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+		#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+		
+			// Check if the page that's no longer hot exists
+			if(pageIndex >= NUMBER_OF_HOT_PAGES && pages[pageIndex - NUMBER_OF_HOT_PAGES]) {
+			
+				// Evict page that's no longer hot from memory
+				evictPage(pages[pageIndex - NUMBER_OF_HOT_PAGES]);
+			}
+		#endif
+	}
+	
+	// Get page
+	Page &page = *pages[pageIndex];
+	
+	// Check if hash at the offset is pruned
+	const uint64_t bit = static_cast<uint64_t>(1) << (offset % BITS_PER_WORD);
+	if(!(page.unprunedWords[offset / BITS_PER_WORD] & bit)) {
+	
+		// Set hash at the offset to the hash
+		page.hashes[offset] = hash;
+		
+		// Set hash at the offset as unpruned
+		page.unprunedWords[offset / BITS_PER_WORD] |= bit;
+		
+		// Increment page's number of unpruned hashes
+		++page.numberOfUnprunedHashes;
+		
+		// Increment number of hashes
+		++numberOfHashes;
+	}
+	
+	// Return hash at the offset
+	return page.hashes[offset];
+}
+
+// Erase
+void MerkleMountainRangeHashes::erase(const uint64_t index) {
+
+	// Check if hash exists
+	if(contains(index)) {
+	
+		// Get page index and offset
+		const uint64_t pageIndex = index / PAGE_LENGTH;
+		const uint64_t offset = index % PAGE_LENGTH;
+		
+		// Check if page is sparse
+		if(sparsePages[pageIndex]) {
+		
+			// Get sparse page
+			SparsePage &sparsePage = *sparsePages[pageIndex];
+			
+			// Remove offset and hash from the sparse page
+			const vector<uint16_t>::iterator position = lower_bound(sparsePage.offsets.begin(), sparsePage.offsets.end(), offset);
+			sparsePage.hashes.erase(sparsePage.hashes.begin() + (position - sparsePage.offsets.begin()));
+			sparsePage.offsets.erase(position);
+			
+			// Decrement number of hashes
+			--numberOfHashes;
+			
+			// Check if sparse page doesn't have any hashes
+			if(sparsePage.offsets.empty()) {
+			
+				// Free sparse page
+				delete sparsePages[pageIndex];
+				sparsePages[pageIndex] = nullptr;
+				
+				// Remove trailing empty pages
+				removeTrailingEmptyPages();
+			}
+			
+			// Return
+			return;
+		}
+		
+		// Set hash at the offset as pruned
+		pages[pageIndex]->unprunedWords[offset / BITS_PER_WORD] &= ~(static_cast<uint64_t>(1) << (offset % BITS_PER_WORD));
+		
+		// Decrement number of hashes
+		--numberOfHashes;
+		
+		// Check if page doesn't have any unpruned hashes
+		if(!--pages[pageIndex]->numberOfUnprunedHashes) {
+		
+			// Free page
+			freePage(pages[pageIndex]);
+			pages[pageIndex] = nullptr;
+			
+			// Remove trailing empty pages
+			removeTrailingEmptyPages();
+		}
+		
+		// Otherwise check if page isn't the last page and has few enough unpruned hashes to be sparse
+		else if(pageIndex != pages.size() - 1 && pages[pageIndex]->numberOfUnprunedHashes <= SPARSE_PAGE_THRESHOLD) {
+		
+			// Make page sparse
+			makePageSparse(pageIndex);
+		}
+	}
+}
+
+// Erase from index
+void MerkleMountainRangeHashes::eraseFromIndex(const uint64_t index) {
+
+	// Get page index and offset
+	const uint64_t pageIndex = index / PAGE_LENGTH;
+	const uint64_t offset = index % PAGE_LENGTH;
+	
+	// Go through all pages after the page
+	for(uint64_t i = pageIndex + 1; i < pages.size(); ++i) {
+	
+		// Check if page exists
+		if(pages[i]) {
+		
+			// Update number of hashes
+			numberOfHashes -= pages[i]->numberOfUnprunedHashes;
+			
+			// Free page
+			freePage(pages[i]);
+		}
+		
+		// Otherwise check if sparse page exists
+		else if(sparsePages[i]) {
+		
+			// Update number of hashes
+			numberOfHashes -= sparsePages[i]->offsets.size();
+			
+			// Free sparse page
+			delete sparsePages[i];
+		}
+	}
+	
+	// Check if pages after the page exist
+	if(pageIndex + 1 < pages.size()) {
+	
+		// Remove pages after the page
+		pages.resize(pageIndex + 1);
+		sparsePages.resize(pageIndex + 1);
+	}
+	
+	// Check if sparse page exists
+	if(pageIndex < sparsePages.size() && sparsePages[pageIndex]) {
+	
+		// Get sparse page
+		SparsePage &sparsePage = *sparsePages[pageIndex];
+		
+		// Remove offsets and hashes starting at the offset from the sparse page
+		const vector<uint16_t>::iterator position = lower_bound(sparsePage.offsets.begin(), sparsePage.offsets.end(), offset);
+		numberOfHashes -= sparsePage.offsets.end() - position;
+		sparsePage.hashes.erase(sparsePage.hashes.begin() + (position - sparsePage.offsets.begin()), sparsePage.hashes.end());
+		sparsePage.offsets.erase(position, sparsePage.offsets.end());
+		
+		// Check if sparse page doesn't have any hashes
+		if(sparsePage.offsets.empty()) {
+		
+			// Free sparse page
+			delete sparsePages[pageIndex];
+			sparsePages[pageIndex] = nullptr;
+		}
+	}
+	
+	// Otherwise check if page exists
+	else if(pageIndex < pages.size() && pages[pageIndex]) {
+	
+		// Go through all hashes in the page starting at the offset
+		Page &page = *pages[pageIndex];
+		for(uint64_t i = offset; i < PAGE_LENGTH; ++i) {
+		
+			// Check if hash is unpruned
+			const uint64_t bit = static_cast<uint64_t>(1) << (i % BITS_PER_WORD);
+			if(page.unprunedWords[i / BITS_PER_WORD] & bit) {
+			
+				// Set hash as pruned
+				page.unprunedWords[i / BITS_PER_WORD] &= ~bit;
+				
+				// Decrement page's number of unpruned hashes
+				--page.numberOfUnprunedHashes;
+				
+				// Decrement number of hashes
+				--numberOfHashes;
+			}
+		}
+		
+		// Check if page doesn't have any unpruned hashes
+		if(!page.numberOfUnprunedHashes) {
+		
+			// Free page
+			freePage(pages[pageIndex]);
+			pages[pageIndex] = nullptr;
+		}
+	}
+	
+	// Remove trailing empty pages
+	removeTrailingEmptyPages();
+}
+
+// Clear
+void MerkleMountainRangeHashes::clear() {
+
+	// Go through all pages
+	for(Page *page : pages) {
+	
+		// Check if page exists
+		if(page) {
+		
+			// Free page
+			freePage(page);
+		}
+	}
+	
+	// Go through all sparse pages
+	for(SparsePage *sparsePage : sparsePages) {
+	
+		// Free sparse page
+		delete sparsePage;
+	}
+	
+	// Clear pages
+	pages.clear();
+	sparsePages.clear();
+	
+	// Set number of hashes to zero
+	numberOfHashes = 0;
+}
+
+// Size
+uint64_t MerkleMountainRangeHashes::size() const {
+
+	// Return number of hashes
+	return numberOfHashes;
+}
+
+// Iterator constant begin
+MerkleMountainRangeHashes::ConstIterator MerkleMountainRangeHashes::cbegin() const {
+
+	// Return iterator at the first unpruned hash
+	return ConstIterator(*this, getNextIndex(0));
+}
+
+// Iterator constant end
+MerkleMountainRangeHashes::ConstIterator MerkleMountainRangeHashes::cend() const {
+
+	// Return iterator at the end index
+	return ConstIterator(*this, END_INDEX);
+}
+
+// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+
+	// Get mapped page length
+	size_t MerkleMountainRangeHashes::getMappedPageLength() {
+	
+		// Get system page size
+		static const size_t systemPageSize = sysconf(_SC_PAGESIZE);
+		
+		// Return page's length rounded up to the system page size so that pages can be evicted individually
+		return (sizeof(Page) + systemPageSize - 1) / systemPageSize * systemPageSize;
+	}
+	
+	// Evict page
+	void MerkleMountainRangeHashes::evictPage(Page *page) {
+	
+		// Remove page from the resident memory since its contents are kept in the file
+		MemoryMappedSlots::evict(page, getMappedPageLength());
+	}
+#endif
+
+// Allocate page
+MerkleMountainRangeHashes::Page *MerkleMountainRangeHashes::allocatePage() {
+
+	// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+	#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+	
+		// Return new page in a slot in the file that's shared by all Merkle mountain ranges
+		return new(MemoryMappedSlots::getSlots(getMappedPageLength()).allocate()) Page();
+		
+	// Otherwise
+	#else
+	
+		// Return new page
+		return new Page();
+	#endif
+}
+
+// Free page
+void MerkleMountainRangeHashes::freePage(Page *page) {
+
+	// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+	#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+	
+		// Evict page from memory
+		evictPage(page);
+		
+		// Free page's slot in the file
+		MemoryMappedSlots::getSlots(getMappedPageLength()).deallocate(page);
+		
+	// Otherwise
+	#else
+	
+		// Delete page
+		delete page;
+	#endif
+}
+
+// Make page sparse
+void MerkleMountainRangeHashes::makePageSparse(const uint64_t pageIndex) {
+
+	// Get page
+	const Page &page = *pages[pageIndex];
+	
+	// Create sparse page with space for the page's unpruned hashes
+	unique_ptr<SparsePage> sparsePage = make_unique<SparsePage>();
+	sparsePage->offsets.reserve(page.numberOfUnprunedHashes);
+	sparsePage->hashes.reserve(page.numberOfUnprunedHashes);
+	
+	// Go through all words in the page
+	for(uint64_t i = 0; i < PAGE_LENGTH / BITS_PER_WORD; ++i) {
+	
+		// Go through all unpruned hashes in the word
+		for(uint64_t word = page.unprunedWords[i]; word; word &= word - 1) {
+		
+			// Append unpruned hash's offset and hash to the sparse page
+			const uint64_t offset = i * BITS_PER_WORD + countr_zero(word);
+			sparsePage->offsets.push_back(offset);
+			sparsePage->hashes.push_back(page.hashes[offset]);
+		}
+	}
+	
+	// Free page
+	freePage(pages[pageIndex]);
+	pages[pageIndex] = nullptr;
+	
+	// Set sparse page
+	sparsePages[pageIndex] = sparsePage.release();
+}
+
+// Make page dense
+void MerkleMountainRangeHashes::makePageDense(const uint64_t pageIndex) {
+
+	// Get sparse page
+	const SparsePage &sparsePage = *sparsePages[pageIndex];
+	
+	// Allocate page
+	Page *page = allocatePage();
+	
+	// Go through all of the sparse page's hashes
+	for(vector<uint16_t>::size_type i = 0; i < sparsePage.offsets.size(); ++i) {
+	
+		// Set hash at the offset to the hash
+		const uint64_t offset = sparsePage.offsets[i];
+		page->hashes[offset] = sparsePage.hashes[i];
+		
+		// Set hash at the offset as unpruned
+		page->unprunedWords[offset / BITS_PER_WORD] |= static_cast<uint64_t>(1) << (offset % BITS_PER_WORD);
+	}
+	
+	// Set page's number of unpruned hashes
+	page->numberOfUnprunedHashes = sparsePage.offsets.size();
+	
+	// Free sparse page
+	delete sparsePages[pageIndex];
+	sparsePages[pageIndex] = nullptr;
+	
+	// Set page
+	pages[pageIndex] = page;
+}
+
+// Get next index
+uint64_t MerkleMountainRangeHashes::getNextIndex(const uint64_t index) const {
+
+	// Go through all pages starting at the index's page
+	for(uint64_t pageIndex = index / PAGE_LENGTH; pageIndex < pages.size(); ++pageIndex) {
+	
+		// Get the offset to start at in the page
+		const uint64_t startOffset = (pageIndex == index / PAGE_LENGTH) ? index % PAGE_LENGTH : 0;
+		
+		// Check if page is sparse
+		if(sparsePages[pageIndex]) {
+		
+			// Check if the sparse page has an offset at or after the start offset
+			const vector<uint16_t>::const_iterator position = lower_bound(sparsePages[pageIndex]->offsets.cbegin(), sparsePages[pageIndex]->offsets.cend(), startOffset);
+			if(position != sparsePages[pageIndex]->offsets.cend()) {
+			
+				// Return the index of the unpruned hash
+				return pageIndex * PAGE_LENGTH + *position;
+			}
+		}
+		
+		// Otherwise check if page exists
+		else if(pages[pageIndex]) {
+		
+			// Go through all words in the page starting at the start offset's word
+			for(uint64_t i = startOffset / BITS_PER_WORD; i < PAGE_LENGTH / BITS_PER_WORD; ++i) {
+			
+				// Get the word's unpruned bits that are at or after the start offset
+				const uint64_t word = (i == startOffset / BITS_PER_WORD) ? pages[pageIndex]->unprunedWords[i] & (numeric_limits<uint64_t>::max() << (startOffset % BITS_PER_WORD)) : pages[pageIndex]->unprunedWords[i];
+				
+				// Check if word has an unpruned hash
+				if(word) {
+				
+					// Return the index of the unpruned hash
+					return pageIndex * PAGE_LENGTH + i * BITS_PER_WORD + countr_zero(word);
+				}
+			}
+		}
+	}
+	
+	// Return end index
+	return END_INDEX;
+}
+
+// Remove trailing empty pages
+void MerkleMountainRangeHashes::removeTrailingEmptyPages() {
+
+	// Loop while the last page is empty
+	while(!pages.empty() && !pages.back() && !sparsePages.back()) {
+	
+		// Remove last page
+		pages.pop_back();
+		sparsePages.pop_back();
+	}
+}
@@ -0,0 +1,193 @@
+// Header guard
+#ifndef MWC_VALIDATION_NODE_MERKLE_MOUNTAIN_RANGE_HASHES_H
+#define MWC_VALIDATION_NODE_MERKLE_MOUNTAIN_RANGE_HASHES_H
+
+
+// Header files
+#include "./common.h"
+#include <array>
+#include <limits>
+#include "./crypto.h"
+#include "./memory_mapped_slots.h"
+
+using namespace std;
+
+
+// Namespace
+namespace MwcValidationNode {
+
+
+// Classes
+
+// Merkle mountain range hashes class
+class MerkleMountainRangeHashes final {
+
+	// Public
+	public:
+	
+		// Constant iterator
+		class ConstIterator final {
+		
+			// Public
+			public:
+			
+				// Constructor
+				explicit ConstIterator(const MerkleMountainRangeHashes &hashes, const uint64_t index);
+				
+				// Get index
+				uint64_t getIndex() const;
+				
+				// Get hash
+				const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &getHash() const;
+				
+				// Increment operator
+				ConstIterator &operator++();
+				
+				// Equality operator
+				bool operator==(const ConstIterator &other) const;
+				
+				// Inequality operator
+				bool operator!=(const ConstIterator &other) const;
+				
+			// Private
+			private:
+			
+				// Hashes
+				const MerkleMountainRangeHashes *hashes;
+				
+				// Index
+				uint64_t index;
+		};
+		
+		// Constructor
+		MerkleMountainRangeHashes();
+		
+		// Copy constructor
+		MerkleMountainRangeHashes(const MerkleMountainRangeHashes &other);
+		
+		// Move constructor
+		MerkleMountainRangeHashes(MerkleMountainRangeHashes &&other);
+		
+		// Destructor
+		~MerkleMountainRangeHashes();
+		
+		// Copy assignment operator
+		MerkleMountainRangeHashes &operator=(const MerkleMountainRangeHashes &other);
+		
+		// Move assignment operator
+		MerkleMountainRangeHashes &operator=(MerkleMountainRangeHashes &&other);
+		
+		// Contains
+		bool contains(const uint64_t index) const;
+		
+		// At
+		const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &at(const uint64_t index) const;
+		
+		// Emplace
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &emplace(const uint64_t index, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &hash);
+		
+		// Erase
+		void erase(const uint64_t index);
+		
+		// Erase from index
+		void eraseFromIndex(const uint64_t index);
+		
+		// Clear
+		void clear();
+		
+		// Size
+		uint64_t size() const;
+		
+		// Iterator constant begin
+		ConstIterator cbegin() const;
+		
+		// Iterator constant end
+		ConstIterator cend() const;
+		
+	// Private
+	private:
+	
+		// Page length
+		static const uint64_t PAGE_LENGTH = 1024;
+		
+		// Bits per word
+		static const uint64_t BITS_PER_WORD = numeric_limits<uint64_t>::digits;
+		
+		// End index
+		static const uint64_t END_INDEX;
+		
+		// Page structure
+		struct Page final {
+		
+			// Hashes
+			array<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, PAGE_LENGTH> hashes;
+			
+			// Unpruned words
+			array<uint64_t, PAGE_LENGTH / BITS_PER_WORD> unprunedWords;
+			
+			// Number of unpruned hashes
+			uint64_t numberOfUnprunedHashes;
+		};
+		
+		// Sparse page threshold
+		static const uint64_t SPARSE_PAGE_THRESHOLD;
+		
+		// Sparse page maximum length
+		static const uint64_t SPARSE_PAGE_MAXIMUM_LENGTH;
+		
+		// Sparse page structure
+		struct SparsePage final {
+		
+			// Offsets
+			vector<uint16_t> offsets;
+			
+			// Hashes
+			vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> hashes;
+		};
+		
+		// Check if memory mapped Merkle mountain ranges are enabled and not Windows
+		#if defined ENABLE_MEMORY_MAPPED_MERKLE_MOUNTAIN_RANGES && !defined _WIN32
+		
+			// Number of hot pages
+			static const uint64_t NUMBER_OF_HOT_PAGES;
+			
+			// Get mapped page length
+			static size_t getMappedPageLength();
+			
+			// Evict page
+			static void evictPage(Page *page);
+		#endif
+		
+		// Allocate page
+		Page *allocatePage();
+		
+		// Free page
+		void freePage(Page *page);
+		
+		// Make page sparse
+		void makePageSparse(const uint64_t pageIndex);
+		
+		// Make page dense
+		void makePageDense(const uint64_t pageIndex);
+		
+		// Get next index
+		uint64_t getNextIndex(const uint64_t index) const;
+		
+		// Remove trailing empty pages
+		void removeTrailingEmptyPages();
+		
+		// Pages
+		vector<Page *> pages;
+		
+		// Sparse pages
+		vector<SparsePage *> sparsePages;
+		
+		// Number of hashes
+		uint64_t numberOfHashes;
+};
+
+
+}
+
+
+#endif
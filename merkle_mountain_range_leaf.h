@@ -8,6 +8,7 @@
 #include <array>
 #include <fstream>
 #include <optional>
+#include "./crypto.h"
 
 using namespace std;
 
@@ -19,7 +20,7 @@ namespace MwcValidationNode {
 // Classes
 
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Merkle mountain range leaf class
 template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength = 0, typename SumClass = int, bool allowDuplicateLookupValues = false> class MerkleMountainRangeLeaf {
@@ -28,7 +29,7 @@ template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafL
 	protected:
 	
 		// Merkle mountain range friend class
-		friend class MerkleMountainRange<DerivedClass>;
+		template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> friend class MerkleMountainRange;
 		
 		// Maximum serialized length
 		static const size_t MAXIMUM_SERIALIZED_LENGTH = maximumSerializedMerkleMountainRangeLeafLength;
@@ -63,7 +64,7 @@ template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafL
 		typedef SumClass Sum;
 		
 		// Get lookup value
-		virtual optional<vector<uint8_t>> getLookupValue() const;
+		virtual optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> getLookupValue() const;
 		
 		// Add to sum
 		virtual void addToSum(SumClass &sum, const AdditionReason additionReason) const;
@@ -78,7 +79,7 @@ template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafL
 		virtual vector<uint8_t> serialize() const = 0;
 		
 		// Save
-		virtual void save(ofstream &file) const = 0;
+		virtual void save(ostream &file) const = 0;
 		
 		// Get serialized protocol version
 		static uint32_t getSerializedProtocolVersion(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedMerkleMountainRangeLeaf, const typename array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedMerkleMountainRangeLeafLength, const uint32_t protocolVersion);
@@ -86,21 +87,24 @@ template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafL
 		// Unserialize
 		static pair<DerivedClass, array<uint8_t, 0>::size_type> unserialize(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedMerkleMountainRangeLeaf, const typename array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedMerkleMountainRangeLeafLength, const uint32_t protocolVersion, const bool isGenesisBlock = false);
 		
+		// Verify unserialized
+		static bool verifyUnserialized(const MerkleMountainRange<DerivedClass> &merkleMountainRange);
+		
 		// Restore
-		static DerivedClass restore(ifstream &file);
+		static DerivedClass restore(istream &file);
 		
 		// Save sum
-		static void saveSum(const SumClass &sum, ofstream &file);
+		static void saveSum(const SumClass &sum, ostream &file);
 		
 		// Restore sum
-		static void restoreSum(SumClass &sum, ifstream &file);
+		static void restoreSum(SumClass &sum, istream &file);
 };
 
 
 // Supporting function implementation
 
 // Get lookup value
-template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> optional<vector<uint8_t>> MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::getLookupValue() const {
+template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::getLookupValue() const {
 
 	// Return no look up value
 	return nullopt;
@@ -130,22 +134,29 @@ template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafL
 	return DerivedClass::unserialize(serializedMerkleMountainRangeLeaf, serializedMerkleMountainRangeLeafLength, protocolVersion, isGenesisBlock);
 }
 
+// Verify unserialized
+template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> bool MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::verifyUnserialized(const MerkleMountainRange<DerivedClass> &merkleMountainRange) {
+
+	// Return true
+	return true;
+}
+
 // Restore
-template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> DerivedClass MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::restore(ifstream &file) {
+template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> DerivedClass MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::restore(istream &file) {
 
 	// Return restored derived class
 	return DerivedClass::restore(file);
 }
 
 // Save sum
-template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> void MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::saveSum(const SumClass &sum, ofstream &file) {
+template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> void MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::saveSum(const SumClass &sum, ostream &file) {
 
 	// Save sum
 	DerivedClass::saveSum(sum, file);
 }
 
 // Restore sum
-template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> void MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::restoreSum(SumClass &sum, ifstream &file) {
+template<typename DerivedClass, size_t maximumSerializedMerkleMountainRangeLeafLength, typename SumClass, bool allowDuplicateLookupValues> void MerkleMountainRangeLeaf<DerivedClass, maximumSerializedMerkleMountainRangeLeafLength, SumClass, allowDuplicateLookupValues>::restoreSum(SumClass &sum, istream &file) {
 
 	// Restore sum
 	DerivedClass::restoreSum(sum, file);
@@ -524,7 +524,7 @@ vector<uint8_t> Message::createErrorMessage() {
 }
 
 // Read message header
-tuple<Message::Type, vector<uint8_t>::size_type> Message::readMessageHeader(const vector<uint8_t> &messageHeader) {
+tuple<Message::Type, vector<uint8_t>::size_type> Message::readMessageHeader(const span<const uint8_t> &messageHeader) {
 
 	// Check if message header isn't complete
 	if(messageHeader.size() < MESSAGE_HEADER_LENGTH) {
@@ -558,7 +558,7 @@ tuple<Message::Type, vector<uint8_t>::size_type> Message::readMessageHeader(cons
 }
 
 // Read hand message
-tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress> Message::readHandMessage(const vector<uint8_t> &handMessage) {
+tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress> Message::readHandMessage(const span<const uint8_t> &handMessage) {
 
 	// Check if hand message doesn't contain a protocol version
 	if(handMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint32_t)) {
@@ -746,7 +746,7 @@ tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress>
 	}
 	
 	// Get user agent from hand message
-	const string userAgent(handMessage.cbegin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(nonce) + sizeof(totalDifficulty) + clientAddressLength + serverAddressLength + sizeof(userAgentLength), handMessage.cbegin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(nonce) + sizeof(totalDifficulty) + clientAddressLength + serverAddressLength + sizeof(userAgentLength) + userAgentLength);
+	const string userAgent(handMessage.begin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(nonce) + sizeof(totalDifficulty) + clientAddressLength + serverAddressLength + sizeof(userAgentLength), handMessage.begin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(nonce) + sizeof(totalDifficulty) + clientAddressLength + serverAddressLength + sizeof(userAgentLength) + userAgentLength);
 	
 	// Check if user agent is invalid
 	if(!Common::isUtf8(userAgent.c_str(), userAgent.size())) {
@@ -802,7 +802,7 @@ tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress>
 }
 
 // Read shake message
-tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> Message::readShakeMessage(const vector<uint8_t> &shakeMessage) {
+tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> Message::readShakeMessage(const span<const uint8_t> &shakeMessage) {
 
 	// Check if shake message doesn't contain a negotiated protocol version
 	if(shakeMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint32_t)) {
@@ -880,7 +880,7 @@ tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> Message::readSha
 	}
 	
 	// Get user agent from shake message
-	const string userAgent(shakeMessage.cbegin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(totalDifficulty) + sizeof(userAgentLength), shakeMessage.cbegin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(totalDifficulty) + sizeof(userAgentLength) + userAgentLength);
+	const string userAgent(shakeMessage.begin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(totalDifficulty) + sizeof(userAgentLength), shakeMessage.begin() + MESSAGE_HEADER_LENGTH + sizeof(negotiatedProtocolVersion) + sizeof(capabilities) + sizeof(totalDifficulty) + sizeof(userAgentLength) + userAgentLength);
 	
 	// Check if user agent is invalid
 	if(!Common::isUtf8(userAgent.c_str(), userAgent.size())) {
@@ -936,7 +936,7 @@ tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> Message::readSha
 }
 
 // Read ping message
-tuple<uint64_t, uint64_t> Message::readPingMessage(const vector<uint8_t> &pingMessage) {
+tuple<uint64_t, uint64_t> Message::readPingMessage(const span<const uint8_t> &pingMessage) {
 
 	// Check if ping message doesn't contain a total difficulty
 	if(pingMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint64_t)) {
@@ -977,7 +977,7 @@ tuple<uint64_t, uint64_t> Message::readPingMessage(const vector<uint8_t> &pingMe
 }
 
 // Read pong message
-tuple<uint64_t, uint64_t> Message::readPongMessage(const vector<uint8_t> &pongMessage) {
+tuple<uint64_t, uint64_t> Message::readPongMessage(const span<const uint8_t> &pongMessage) {
 
 	// Check if pong message doesn't contain a total difficulty
 	if(pongMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint64_t)) {
@@ -1018,7 +1018,7 @@ tuple<uint64_t, uint64_t> Message::readPongMessage(const vector<uint8_t> &pongMe
 }
 
 // Read get peer addresses message
-Node::Capabilities Message::readGetPeerAddressesMessage(const vector<uint8_t> &getPeerAddressesMessage) {
+Node::Capabilities Message::readGetPeerAddressesMessage(const span<const uint8_t> &getPeerAddressesMessage) {
 
 	// Check if get peer addresses message doesn't contain capabilities
 	if(getPeerAddressesMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(Node::Capabilities)) {
@@ -1035,7 +1035,7 @@ Node::Capabilities Message::readGetPeerAddressesMessage(const vector<uint8_t> &g
 }
 
 // Read peer addresses message
-list<NetworkAddress> Message::readPeerAddressesMessage(const vector<uint8_t> &peerAddressesMessage) {
+vector<NetworkAddress> Message::readPeerAddressesMessage(const span<const uint8_t> &peerAddressesMessage) {
 
 	// Check if peer addresses message doesn't contain the number of peer addresses
 	if(peerAddressesMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint32_t)) {
@@ -1054,8 +1054,9 @@ list<NetworkAddress> Message::readPeerAddressesMessage(const vector<uint8_t> &pe
 		throw runtime_error("Number of peer addresses is invalid");
 	}
 	
-	// Initialize network addresses
-	list<NetworkAddress> networkAddresses;
+	// Initialize network addresses with space for the number of peer addresses
+	vector<NetworkAddress> networkAddresses;
+	networkAddresses.reserve(numberOfPeerAddresses);
 	
 	// Go through all peer addresses
 	vector<uint8_t>::size_type peerAddressOffset = MESSAGE_HEADER_LENGTH + sizeof(numberOfPeerAddresses);
@@ -1127,14 +1128,14 @@ list<NetworkAddress> Message::readPeerAddressesMessage(const vector<uint8_t> &pe
 }
 
 // Read header message
-Header Message::readHeaderMessage(const vector<uint8_t> &headerMessage) {
+Header Message::readHeaderMessage(const span<const uint8_t> &headerMessage) {
 
 	// Return reading header from header message
-	return readHeader(headerMessage, MESSAGE_HEADER_LENGTH);
+	return readHeader(headerMessage, MESSAGE_HEADER_LENGTH, true);
 }
 
 // Read headers message
-list<Header> Message::readHeadersMessage(const vector<uint8_t> &headersMessage) {
+vector<Header> Message::readHeadersMessage(const span<const uint8_t> &headersMessage, const bool verifyProofOfWork) {
 
 	// Check if headers message doesn't contain the number of headers
 	if(headersMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint16_t)) {
@@ -1153,8 +1154,9 @@ list<Header> Message::readHeadersMessage(const vector<uint8_t> &headersMessage)
 		throw runtime_error("Number of headers is invalid");
 	}
 
-	// Initialize headers
-	list<Header> headers;
+	// Initialize headers with space for the number of headers
+	vector<Header> headers;
+	headers.reserve(numberOfHeaders);
 	
 	// Go through all headers
 	vector<uint8_t>::size_type headerOffset = MESSAGE_HEADER_LENGTH + sizeof(numberOfHeaders);
@@ -1162,7 +1164,7 @@ list<Header> Message::readHeadersMessage(const vector<uint8_t> &headersMessage)
 	for(uint16_t i = 0; i < numberOfHeaders; ++i) {
 	
 		// Read header from headers message
-		Header header = readHeader(headersMessage, headerOffset);
+		Header header = readHeader(headersMessage, headerOffset, verifyProofOfWork);
 		
 		// Set number of proof nonces bytes
 		const uint64_t numberOfProofNoncesBytes = Common::numberOfBytesRequired(header.getEdgeBits() * Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES);
@@ -1179,10 +1181,10 @@ list<Header> Message::readHeadersMessage(const vector<uint8_t> &headersMessage)
 }
 
 // Read block message
-tuple<Header, Block> Message::readBlockMessage(const vector<uint8_t> &blockMessage, const uint32_t protocolVersion) {
+tuple<Header, Block> Message::readBlockMessage(const span<const uint8_t> &blockMessage, const uint32_t protocolVersion) {
 
 	// Read header from block message
-	const Header header = readHeader(blockMessage, MESSAGE_HEADER_LENGTH);
+	Header header = readHeader(blockMessage, MESSAGE_HEADER_LENGTH, true);
 	
 	// Set number of proof nonces bytes
 	const uint64_t numberOfProofNoncesBytes = Common::numberOfBytesRequired(header.getEdgeBits() * Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES);
@@ -1194,17 +1196,17 @@ tuple<Header, Block> Message::readBlockMessage(const vector<uint8_t> &blockMessa
 	tuple transactionBody = readTransactionBody(blockMessage, MESSAGE_HEADER_LENGTH + headerSize, protocolVersion, false, header.getHeight(), header.getVersion());
 	
 	// Create block
-	const Block block(move(get<0>(transactionBody)), move(get<1>(transactionBody)), move(get<2>(transactionBody)), move(get<3>(transactionBody)));
+	Block block(move(get<0>(transactionBody)), move(get<1>(transactionBody)), move(get<2>(transactionBody)), move(get<3>(transactionBody)));
 	
-	// Return header and block
-	return {header, block};
+	// Return header and block without copying them
+	return {move(header), move(block)};
 }
 
 // Read compact block message
-Header Message::readCompactBlockMessage(const vector<uint8_t> &compactBlockMessage) {
+Header Message::readCompactBlockMessage(const span<const uint8_t> &compactBlockMessage) {
 
 	// Read header from compact block message
-	const Header header = readHeader(compactBlockMessage, MESSAGE_HEADER_LENGTH);
+	const Header header = readHeader(compactBlockMessage, MESSAGE_HEADER_LENGTH, true);
 	
 	// TODO Verify compact block message's nonce and body
 	
@@ -1213,7 +1215,7 @@ Header Message::readCompactBlockMessage(const vector<uint8_t> &compactBlockMessa
 }
 
 // Read stem transaction message
-vector<uint8_t> Message::readStemTransactionMessage(const vector<uint8_t> &stemTransactionMessage, const uint32_t protocolVersion) {
+vector<uint8_t> Message::readStemTransactionMessage(const span<const uint8_t> &stemTransactionMessage, const uint32_t protocolVersion) {
 
 	// Check if stem transaction message doesn't contain an offset or the number of inputs
 	if(stemTransactionMessage.size() < MESSAGE_HEADER_LENGTH + Crypto::SECP256K1_PRIVATE_KEY_LENGTH + sizeof(uint64_t)) {
@@ -1467,14 +1469,14 @@ vector<uint8_t> Message::readStemTransactionMessage(const vector<uint8_t> &stemT
 	vector message = createMessageHeader(Type::STEM_TRANSACTION, offset - MESSAGE_HEADER_LENGTH);
 	
 	// Append transaction to message
-	message.insert(message.cend(), stemTransactionMessage.cbegin() + MESSAGE_HEADER_LENGTH, stemTransactionMessage.cbegin() + offset);
+	message.insert(message.cend(), stemTransactionMessage.begin() + MESSAGE_HEADER_LENGTH, stemTransactionMessage.begin() + offset);
 	
 	// Return message
 	return message;
 }
 
 // Read transaction message
-Transaction Message::readTransactionMessage(const vector<uint8_t> &transactionMessage, const uint32_t protocolVersion) {
+Transaction Message::readTransactionMessage(const span<const uint8_t> &transactionMessage, const uint32_t protocolVersion) {
 
 	// Check if transaction message doesn't contain an offset
 	if(transactionMessage.size() < MESSAGE_HEADER_LENGTH + Crypto::SECP256K1_PRIVATE_KEY_LENGTH) {
@@ -1494,7 +1496,7 @@ Transaction Message::readTransactionMessage(const vector<uint8_t> &transactionMe
 }
 
 // Read transaction hash set archive message
-tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, uint64_t, vector<uint8_t>::size_type> Message::readTransactionHashSetArchiveMessage(const vector<uint8_t> &transactionHashSetArchiveMessage) {
+tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, uint64_t, vector<uint8_t>::size_type> Message::readTransactionHashSetArchiveMessage(const span<const uint8_t> &transactionHashSetArchiveMessage) {
 
 	// Check if transaction hash set archive message doesn't contain a block hash
 	if(transactionHashSetArchiveMessage.size() < MESSAGE_HEADER_LENGTH + Crypto::BLAKE2B_HASH_LENGTH) {
@@ -1539,7 +1541,7 @@ tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, uint64_t, vector<uint8_t>::si
 }
 
 // Read transaction kernel message
-void Message::readTransactionKernelMessage(const vector<uint8_t> &transactionKernelMessage) {
+void Message::readTransactionKernelMessage(const span<const uint8_t> &transactionKernelMessage) {
 
 	// Check if transaction kernel message doesn't contain a transaction kernel hash
 	if(transactionKernelMessage.size() < MESSAGE_HEADER_LENGTH + Crypto::BLAKE2B_HASH_LENGTH) {
@@ -1550,7 +1552,7 @@ void Message::readTransactionKernelMessage(const vector<uint8_t> &transactionKer
 }
 
 // Read Tor address message
-void Message::readTorAddressMessage(const vector<uint8_t> &torAddressMessage) {
+void Message::readTorAddressMessage(const span<const uint8_t> &torAddressMessage) {
 
 	// Check if Tor address message doesn't contain a Tor address length
 	if(torAddressMessage.size() < MESSAGE_HEADER_LENGTH + sizeof(uint64_t)) {
@@ -1878,7 +1880,7 @@ void Message::writeNetworkAddress(vector<uint8_t> &buffer, const NetworkAddress
 }
 
 // Read network address
-NetworkAddress Message::readNetworkAddress(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
+NetworkAddress Message::readNetworkAddress(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
 
 	// Initialize network address
 	NetworkAddress networkAddress;
@@ -2078,37 +2080,12 @@ void Message::writeHeader(vector<uint8_t> &buffer, const Header &header) {
 		throw runtime_error("Number of proof nonces bytes is invalid");
 	}
 	
-	// Initialize proof nonces bytes
-	uint8_t proofNoncesBytes[numberOfProofNoncesBytes];
-	memset(proofNoncesBytes, 0, sizeof(proofNoncesBytes));
-	
-	// Go through all header's proof nonces
-	for(uint64_t i = 0; i < Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES; ++i) {
-	
-		// Get header's proof nonce
-		const uint64_t &proofNonce = header.getProofNonces()[i];
-		
-		// Go through all edge bits
-		for(uint8_t j = 0; j < header.getEdgeBits(); ++j) {
-		
-			// Check if bit is set in the proof nonce
-			if(proofNonce & (static_cast<uint64_t>(1) << j)) {
-			
-				// Set bit position
-				const uint64_t bitPosition = i * header.getEdgeBits() + j;
-				
-				// Set bit in the proof nonces bytes
-				proofNoncesBytes[bitPosition / Common::BITS_IN_A_BYTE] |= 1 << (bitPosition % Common::BITS_IN_A_BYTE);
-			}
-		}
-	}
-	
-	// Append proof nonces bytes to buffer
-	buffer.insert(buffer.cend(), proofNoncesBytes, proofNoncesBytes + numberOfProofNoncesBytes);
+	// Append header's proof nonces bytes to buffer
+	header.serialize(buffer);
 }
 
 // Read header
-Header Message::readHeader(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
+Header Message::readHeader(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const bool verifyProofOfWork) {
 
 	// Check if header doesn't contain a version
 	if(buffer.size() < offset + sizeof(uint16_t)) {
@@ -2333,7 +2310,7 @@ Header Message::readHeader(const vector<uint8_t> &buffer, const vector<uint8_t>:
 	}
 	
 	// Return header
-	return Header(version, height, chrono::time_point<chrono::system_clock>(chrono::seconds(timestamp)), previousBlockHash, previousHeaderRoot, outputRoot, rangeproofRoot, kernelRoot, totalKernelOffset, outputMerkleMountainRangeSize, kernelMerkleMountainRangeSize, totalDifficulty, secondaryScaling, nonce, edgeBits, proofNonces);
+	return Header(version, height, chrono::time_point<chrono::system_clock>(chrono::seconds(timestamp)), previousBlockHash, previousHeaderRoot, outputRoot, rangeproofRoot, kernelRoot, totalKernelOffset, outputMerkleMountainRangeSize, kernelMerkleMountainRangeSize, totalDifficulty, secondaryScaling, nonce, edgeBits, proofNonces, true, verifyProofOfWork);
 }
 
 // Write input
@@ -2383,7 +2360,7 @@ void Message::writeInput(vector<uint8_t> &buffer, const Input &input, const uint
 }
 
 // Read input
-Input Message::readInput(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion) {
+Input Message::readInput(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion) {
 
 	// Initialize features
 	Input::Features features;
@@ -2471,7 +2448,7 @@ void Message::writeOutput(vector<uint8_t> &buffer, const Output &output) {
 }
 
 // Read output
-Output Message::readOutput(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
+Output Message::readOutput(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
 
 	// Check if output doesn't contain features
 	if(buffer.size() < offset + sizeof(Output::Features)) {
@@ -2508,7 +2485,7 @@ void Message::writeRangeproof(vector<uint8_t> &buffer, const Rangeproof &rangepr
 }
 
 // Read rangeproof
-Rangeproof Message::readRangeproof(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
+Rangeproof Message::readRangeproof(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset) {
 
 	// Check if rangeproof doesn't contain a length
 	if(buffer.size() < offset + sizeof(uint64_t)) {
@@ -2679,7 +2656,7 @@ void Message::writeKernel(vector<uint8_t> &buffer, const Kernel &kernel, const u
 }
 
 // Read kernel
-Kernel Message::readKernel(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion) {
+Kernel Message::readKernel(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool verifySignature) {
 
 	// Check if kernel doesn't contain features
 	if(buffer.size() < offset + sizeof(Kernel::Features)) {
@@ -2914,11 +2891,11 @@ Kernel Message::readKernel(const vector<uint8_t> &buffer, const vector<uint8_t>:
 	const uint8_t *signature = &buffer[offset + sizeof(features) + featuresSize + Crypto::COMMITMENT_LENGTH];
 	
 	// Return kernel
-	return Kernel(features, fee, lockHeight, relativeHeight, excess, signature);
+	return Kernel(features, fee, lockHeight, relativeHeight, excess, signature, false, verifySignature);
 }
 
 // Write transaction body
-void Message::writeTransactionBody(vector<uint8_t> &buffer, const list<Input> &inputs, const list<Output> &outputs, const list<Rangeproof> &rangeproofs, const list<Kernel> &kernels, const uint32_t protocolVersion) {
+void Message::writeTransactionBody(vector<uint8_t> &buffer, const vector<Input> &inputs, const vector<Output> &outputs, const vector<Rangeproof> &rangeproofs, const vector<Kernel> &kernels, const uint32_t protocolVersion) {
 
 	// Check if number of inputs is invalid
 	if(inputs.size() > MAXIMUM_INPUTS_LENGTH) {
@@ -3002,8 +2979,8 @@ void Message::writeTransactionBody(vector<uint8_t> &buffer, const list<Input> &i
 	}
 	
 	// Go through all outputs and rangeproofs
-	list<Output>::const_iterator i = outputs.cbegin();
-	for(list<Rangeproof>::const_iterator j = rangeproofs.cbegin(); i != outputs.cend(); ++i, ++j) {
+	vector<Output>::const_iterator i = outputs.cbegin();
+	for(vector<Rangeproof>::const_iterator j = rangeproofs.cbegin(); i != outputs.cend(); ++i, ++j) {
 	
 		// Append output to buffer
 		writeOutput(buffer, *i);
@@ -3021,7 +2998,7 @@ void Message::writeTransactionBody(vector<uint8_t> &buffer, const list<Input> &i
 }
 
 // Read transaction body
-tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> Message::readTransactionBody(const vector<uint8_t> &buffer, vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool isTransaction, const uint64_t headerHeight, const uint16_t headerVersion) {
+tuple<vector<Input>, vector<Output>, vector<Rangeproof>, vector<Kernel>> Message::readTransactionBody(const span<const uint8_t> &buffer, vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool isTransaction, const uint64_t headerHeight, const uint16_t headerVersion) {
 
 	// Check if transaction body doesn't contain the number of inputs
 	if(buffer.size() < offset + sizeof(uint64_t)) {
@@ -3077,8 +3054,9 @@ tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> Message::readTr
 	// Update offset
 	offset += sizeof(numberOfInputs) + sizeof(numberOfOutputs) + sizeof(numberOfKernels);
 	
-	// Initialize inputs
-	list<Input> inputs;
+	// Initialize inputs with space for the number of inputs that the transaction body can contain
+	vector<Input> inputs;
+	inputs.reserve(min(numberOfInputs, static_cast<uint64_t>((buffer.size() - offset) / Crypto::COMMITMENT_LENGTH)));
 	
 	// Go through all inputs
 	for(uint64_t i = 0; i < numberOfInputs; ++i) {
@@ -3115,9 +3093,11 @@ tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> Message::readTr
 		inputs.push_back(move(input));
 	}
 	
-	// Initialize outputs and rangeproofs
-	list<Output> outputs;
-	list<Rangeproof> rangeproofs;
+	// Initialize outputs and rangeproofs with space for the number of outputs that the transaction body can contain
+	vector<Output> outputs;
+	vector<Rangeproof> rangeproofs;
+	outputs.reserve(min(numberOfOutputs, static_cast<uint64_t>((buffer.size() - offset) / (sizeof(Output::Features) + Crypto::COMMITMENT_LENGTH + sizeof(uint64_t) + Crypto::BULLETPROOF_LENGTH))));
+	rangeproofs.reserve(outputs.capacity());
 	
 	// Go through all outputs
 	for(uint64_t i = 0; i < numberOfOutputs; ++i) {
@@ -3155,14 +3135,15 @@ tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> Message::readTr
 		rangeproofs.push_back(move(rangeproof));
 	}
 	
-	// Initialize kernels
-	list<Kernel> kernels;
+	// Initialize kernels with space for the number of kernels that the transaction body can contain
+	vector<Kernel> kernels;
+	kernels.reserve(min(numberOfKernels, static_cast<uint64_t>((buffer.size() - offset) / (Crypto::COMMITMENT_LENGTH + Crypto::SINGLE_SIGNER_SIGNATURE_LENGTH))));
 	
 	// Go through all kernels
 	for(uint64_t i = 0; i < numberOfKernels; ++i) {
 	
-		// Read kernel from transaction body
-		Kernel kernel = readKernel(buffer, offset, protocolVersion);
+		// Read kernel from transaction body without verifying its signature
+		Kernel kernel = readKernel(buffer, offset, protocolVersion, false);
 		
 		// Check kernel's features
 		switch(kernel.getFeatures()) {
@@ -3288,6 +3269,24 @@ tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> Message::readTr
 		kernels.push_back(move(kernel));
 	}
 	
+	// Initialize unverified kernels
+	vector<const Kernel *> unverifiedKernels;
+	unverifiedKernels.reserve(kernels.size());
+	
+	// Go through all kernels
+	for(const Kernel &kernel : kernels) {
+	
+		// Append kernel to list
+		unverifiedKernels.push_back(&kernel);
+	}
+	
+	// Check if kernels' signatures aren't for the kernels
+	if(!Kernel::verifySignatures(unverifiedKernels)) {
+	
+		// Throw exception
+		throw runtime_error("Kernels' signatures aren't for the kernels");
+	}
+	
 	// Return inputs, outputs, rangeproofs, and kernels
-	return {inputs, outputs, rangeproofs, kernels};
+	return {move(inputs), move(outputs), move(rangeproofs), move(kernels)};
 }
@@ -6,6 +6,7 @@
 // Header files
 #include "./common.h"
 #include <set>
+#include <span>
 #include "./network_address.h"
 #include "./node.h"
 
@@ -168,52 +169,52 @@ class Message final {
 		static vector<uint8_t> createErrorMessage();
 		
 		// Read message header
-		static tuple<Type, vector<uint8_t>::size_type> readMessageHeader(const vector<uint8_t> &messageHeader);
+		static tuple<Type, vector<uint8_t>::size_type> readMessageHeader(const span<const uint8_t> &messageHeader);
 		
 		// Read hand message
-		static tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress> readHandMessage(const vector<uint8_t> &handMessage);
+		static tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t, NetworkAddress> readHandMessage(const span<const uint8_t> &handMessage);
 		
 		// Read shake message
-		static tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> readShakeMessage(const vector<uint8_t> &shakeMessage);
+		static tuple<Node::Capabilities, uint64_t, string, uint32_t, uint64_t> readShakeMessage(const span<const uint8_t> &shakeMessage);
 		
 		// Read ping message
-		static tuple<uint64_t, uint64_t> readPingMessage(const vector<uint8_t> &pingMessage);
+		static tuple<uint64_t, uint64_t> readPingMessage(const span<const uint8_t> &pingMessage);
 		
 		// Read pong message
-		static tuple<uint64_t, uint64_t> readPongMessage(const vector<uint8_t> &pongMessage);
+		static tuple<uint64_t, uint64_t> readPongMessage(const span<const uint8_t> &pongMessage);
 		
 		// Read get peer addresses message
-		static Node::Capabilities readGetPeerAddressesMessage(const vector<uint8_t> &getPeerAddressesMessage);
+		static Node::Capabilities readGetPeerAddressesMessage(const span<const uint8_t> &getPeerAddressesMessage);
 		
 		// Read peer addresses message
-		static list<NetworkAddress> readPeerAddressesMessage(const vector<uint8_t> &peerAddressesMessage);
+		static vector<NetworkAddress> readPeerAddressesMessage(const span<const uint8_t> &peerAddressesMessage);
 		
 		// Read header message
-		static Header readHeaderMessage(const vector<uint8_t> &headerMessage);
+		static Header readHeaderMessage(const span<const uint8_t> &headerMessage);
 		
 		// Read headers message
-		static list<Header> readHeadersMessage(const vector<uint8_t> &headersMessage);
+		static vector<Header> readHeadersMessage(const span<const uint8_t> &headersMessage, const bool verifyProofOfWork);
 		
 		// Read block message
-		static tuple<Header, Block> readBlockMessage(const vector<uint8_t> &blockMessage, const uint32_t protocolVersion);
+		static tuple<Header, Block> readBlockMessage(const span<const uint8_t> &blockMessage, const uint32_t protocolVersion);
 		
 		// Read compact block message
-		static Header readCompactBlockMessage(const vector<uint8_t> &compactBlockMessage);
+		static Header readCompactBlockMessage(const span<const uint8_t> &compactBlockMessage);
 		
 		// Read stem transaction message
-		static vector<uint8_t> readStemTransactionMessage(const vector<uint8_t> &stemTransactionMessage, const uint32_t protocolVersion);
+		static vector<uint8_t> readStemTransactionMessage(const span<const uint8_t> &stemTransactionMessage, const uint32_t protocolVersion);
 		
 		// Read transaction message
-		static Transaction readTransactionMessage(const vector<uint8_t> &transactionMessage, const uint32_t protocolVersion);
+		static Transaction readTransactionMessage(const span<const uint8_t> &transactionMessage, const uint32_t protocolVersion);
 		
 		// Read transaction hash set archive message
-		static tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, uint64_t, vector<uint8_t>::size_type> readTransactionHashSetArchiveMessage(const vector<uint8_t> &transactionHashSetArchiveMessage);
+		static tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, uint64_t, vector<uint8_t>::size_type> readTransactionHashSetArchiveMessage(const span<const uint8_t> &transactionHashSetArchiveMessage);
 		
 		// Read transaction kernel message
-		static void readTransactionKernelMessage(const vector<uint8_t> &transactionKernelMessage);
+		static void readTransactionKernelMessage(const span<const uint8_t> &transactionKernelMessage);
 		
 		// Read Tor address message
-		static void readTorAddressMessage(const vector<uint8_t> &torAddressMessage);
+		static void readTorAddressMessage(const span<const uint8_t> &torAddressMessage);
 	
 	// Private
 	private:
@@ -246,43 +247,43 @@ class Message final {
 		static void writeNetworkAddress(vector<uint8_t> &buffer, const NetworkAddress &networkAddress);
 		
 		// Read network address
-		static NetworkAddress readNetworkAddress(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset);
+		static NetworkAddress readNetworkAddress(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset);
 		
 		// Write header
 		static void writeHeader(vector<uint8_t> &buffer, const Header &header);
 		
 		// Read header
-		static Header readHeader(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset);
+		static Header readHeader(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const bool verifyProofOfWork);
 		
 		// Write input
 		static void writeInput(vector<uint8_t> &buffer, const Input &input, const uint32_t protocolVersion);
 		
 		// Read input
-		static Input readInput(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion);
+		static Input readInput(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion);
 		
 		// Write output
 		static void writeOutput(vector<uint8_t> &buffer, const Output &output);
 		
 		// Read output
-		static Output readOutput(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset);
+		static Output readOutput(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset);
 		
 		// Write rangeproof
 		static void writeRangeproof(vector<uint8_t> &buffer, const Rangeproof &rangeproof);
 		
 		// Read rangeproof
-		static Rangeproof readRangeproof(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset);
+		static Rangeproof readRangeproof(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset);
 		
 		// Write kernel
 		static void writeKernel(vector<uint8_t> &buffer, const Kernel &kernel, const uint32_t protocolVersion);
 		
 		// Read kernel
-		static Kernel readKernel(const vector<uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion);
+		static Kernel readKernel(const span<const uint8_t> &buffer, const vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool verifySignature = true);
 		
 		// Write transaction body
-		static void writeTransactionBody(vector<uint8_t> &buffer, const list<Input> &inputs, const list<Output> &outputs, const list<Rangeproof> &rangeproofs, const list<Kernel> &kernels, const uint32_t protocolVersion);
+		static void writeTransactionBody(vector<uint8_t> &buffer, const vector<Input> &inputs, const vector<Output> &outputs, const vector<Rangeproof> &rangeproofs, const vector<Kernel> &kernels, const uint32_t protocolVersion);
 		
 		// Read transaction body
-		static tuple<list<Input>, list<Output>, list<Rangeproof>, list<Kernel>> readTransactionBody(const vector<uint8_t> &buffer, vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool isTransaction, const uint64_t headerHeight = 0, const uint16_t headerVersion = Consensus::getHeaderVersion(0));
+		static tuple<vector<Input>, vector<Output>, vector<Rangeproof>, vector<Kernel>> readTransactionBody(const span<const uint8_t> &buffer, vector<uint8_t>::size_type offset, const uint32_t protocolVersion, const bool isTransaction, const uint64_t headerHeight = 0, const uint16_t headerVersion = Consensus::getHeaderVersion(0));
 };
 
 
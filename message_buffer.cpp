@@ -0,0 +1,140 @@
+// Header files
+#include "./common.h"
+#include "./message_buffer.h"
+
+using namespace std;
+
+
+// Namespace
+using namespace MwcValidationNode;
+
+
+// Supporting function implementation
+
+// Constructor
+MessageBuffer::MessageBuffer() :
+
+	// Set start to zero
+	start(0)
+{
+}
+
+// Empty
+bool MessageBuffer::empty() const {
+
+	// Return if all of the buffer has been consumed
+	return start == buffer.size();
+}
+
+// Size
+MessageBuffer::size_type MessageBuffer::size() const {
+
+	// Return number of bytes that haven't been consumed
+	return buffer.size() - start;
+}
+
+// Data
+const uint8_t *MessageBuffer::data() const {
+
+	// Return first byte that hasn't been consumed
+	return buffer.data() + start;
+}
+
+// Get contents
+span<const uint8_t> MessageBuffer::getContents() const {
+
+	// Return bytes that haven't been consumed
+	return span(buffer.cbegin() + start, buffer.cend());
+}
+
+// Append
+void MessageBuffer::append(const uint8_t *bytes, const size_type length) {
+
+	// Check if at least half of the buffer has been consumed
+	if(start && start >= buffer.size() - start) {
+	
+		// Compact
+		compact();
+	}
+	
+	// Append bytes to the buffer
+	buffer.insert(buffer.cend(), bytes, bytes + length);
+}
+
+// Append
+void MessageBuffer::append(const vector<uint8_t> &bytes) {
+
+	// Append bytes to the buffer
+	append(bytes.data(), bytes.size());
+}
+
+// Consume
+void MessageBuffer::consume(const size_type length) {
+
+	// Move start past the consumed bytes
+	start += length;
+	
+	// Check if all of the buffer has been consumed
+	if(start == buffer.size()) {
+	
+		// Empty the buffer while keeping its memory
+		buffer.clear();
+		
+		// Set start to zero
+		start = 0;
+	}
+}
+
+// Extract
+vector<uint8_t> MessageBuffer::extract(const size_type length) {
+
+	// Check if bytes have been consumed
+	if(start) {
+	
+		// Copy extracted bytes
+		vector<uint8_t> contents(buffer.cbegin() + start, buffer.cbegin() + start + length);
+		
+		// Consume extracted bytes
+		consume(length);
+		
+		// Return contents
+		return contents;
+	}
+	
+	// Move buffer and empty it
+	vector<uint8_t> contents;
+	buffer.swap(contents);
+	
+	// Check if more bytes exist after the extracted bytes
+	if(contents.size() > length) {
+	
+		// Append remaining bytes to the buffer
+		buffer.insert(buffer.cend(), contents.cbegin() + length, contents.cend());
+		
+		// Remove remaining bytes from the extracted bytes
+		contents.resize(length);
+	}
+	
+	// Return contents
+	return contents;
+}
+
+// Clear
+void MessageBuffer::clear() {
+
+	// Free all memory allocated by the buffer
+	vector<uint8_t>().swap(buffer);
+	
+	// Set start to zero
+	start = 0;
+}
+
+// Compact
+void MessageBuffer::compact() {
+
+	// Remove consumed bytes from the buffer
+	buffer.erase(buffer.cbegin(), buffer.cbegin() + start);
+	
+	// Set start to zero
+	start = 0;
+}
@@ -0,0 +1,76 @@
+// Header guard
+#ifndef MWC_VALIDATION_NODE_MESSAGE_BUFFER_H
+#define MWC_VALIDATION_NODE_MESSAGE_BUFFER_H
+
+
+// Header files
+#include "./common.h"
+#include <span>
+#include <vector>
+
+using namespace std;
+
+
+// Namespace
+namespace MwcValidationNode {
+
+
+// Classes
+
+// Message buffer class
+class MessageBuffer final {
+
+	// Public
+	public:
+	
+		// Size type
+		typedef vector<uint8_t>::size_type size_type;
+		
+		// Constructor
+		MessageBuffer();
+		
+		// Empty
+		bool empty() const;
+		
+		// Size
+		size_type size() const;
+		
+		// Data
+		const uint8_t *data() const;
+		
+		// Get contents
+		span<const uint8_t> getContents() const;
+		
+		// Append
+		void append(const uint8_t *bytes, const size_type length);
+		
+		// Append
+		void append(const vector<uint8_t> &bytes);
+		
+		// Consume
+		void consume(const size_type length);
+		
+		// Extract
+		vector<uint8_t> extract(const size_type length);
+		
+		// Clear
+		void clear();
+		
+	// Private
+	private:
+	
+		// Compact
+		void compact();
+		
+		// Buffer
+		vector<uint8_t> buffer;
+		
+		// Start
+		size_type start;
+};
+
+
+}
+
+
+#endif
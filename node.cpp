@@ -1,6 +1,8 @@
 // Header files
 #include "./common.h"
+#include <algorithm>
 #include <fcntl.h>
+#include <filesystem>
 #include <unistd.h>
 #include "./consensus.h"
 #include "./crypto.h"
@@ -124,6 +126,34 @@ const chrono::hours Node::BANNED_PEERS_CLEANUP_INTERVAL = 6h;
 // Remove random peer interval
 const chrono::hours Node::REMOVE_RANDOM_PEER_INTERVAL = 6h;
 
+// Checkpoint interval
+const chrono::minutes Node::CHECKPOINT_INTERVAL = 1min;
+
+// Maximum number of checkpoint deltas
+const uint64_t Node::MAXIMUM_NUMBER_OF_CHECKPOINT_DELTAS = 60;
+
+// State version
+const uint64_t Node::STATE_VERSION = 1;
+
+// Check if block download window size is set
+#ifdef SET_BLOCK_DOWNLOAD_WINDOW_SIZE
+
+	// Block download window size
+	const uint64_t Node::BLOCK_DOWNLOAD_WINDOW_SIZE = SET_BLOCK_DOWNLOAD_WINDOW_SIZE;
+	
+// Otherwise
+#else
+
+	// Block download window size
+	const uint64_t Node::BLOCK_DOWNLOAD_WINDOW_SIZE = 64;
+#endif
+
+// Maximum number of block requests per peer
+const uint64_t Node::MAXIMUM_NUMBER_OF_BLOCK_REQUESTS_PER_PEER = 8;
+
+// Block request timeout
+const chrono::seconds Node::BLOCK_REQUEST_TIMEOUT = 30s;
+
 
 // Supporting function implementation
 
@@ -175,7 +205,13 @@ Node::Node() :
 	
 	// Set number of inbound peers to zero
 	numberOfInboundPeers(0),
-
+	
+	// Set block template mempool version to zero
+	blockTemplateMempoolVersion(0),
+	
+	// Set block template previous block hash to zero
+	blockTemplatePreviousBlockHash({}),
+	
 	// Set stop monitoring to false
 	stopMonitoring(false),
 	
@@ -183,7 +219,16 @@ Node::Node() :
 	started(false),
 	
 	// Set disconnected to false
-	disconnected(false)
+	disconnected(false),
+	
+	// Set checkpoint identifier to zero
+	checkpointIdentifier(0),
+	
+	// Set number of checkpoint deltas to zero
+	numberOfCheckpointDeltas(0),
+	
+	// Set checkpoint snapshot required to true
+	checkpointSnapshotRequired(true)
 {
 
 	// Check if initializing common failed
@@ -236,44 +281,87 @@ void Node::save(ofstream &file) const {
 		throw runtime_error("Node isn't disconnected");
 	}
 	
-	// Write headers to file
-	headers.save(file);
-		
-	// Write synced header index to file
-	const uint64_t serializedSyncedHeaderIndex = Common::hostByteOrderToBigEndian(syncedHeaderIndex);
-	file.write(reinterpret_cast<const char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
+	// Write state to file
+	saveState(file, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, healthyPeers);
+}
+
+// Restore
+void Node::restore(ifstream &file) {
+
+	// Check if started
+	if(started) {
 	
-	// Write kernels to file
-	kernels.save(file);
+		// Throw exception
+		throw runtime_error("Node is started");
+	}
 	
-	// Write outputs to file
-	outputs.save(file);
+	// Read state from file into temporaries so that the node's state isn't changed if it fails
+	MerkleMountainRange<Header> restoredHeaders;
+	uint64_t restoredSyncedHeaderIndex;
+	MerkleMountainRange<Kernel> restoredKernels;
+	MerkleMountainRange<Output> restoredOutputs;
+	MerkleMountainRange<Rangeproof> restoredRangeproofs;
+	unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> restoredHealthyPeers;
+	restoreState(file, restoredHeaders, restoredSyncedHeaderIndex, restoredKernels, restoredOutputs, restoredRangeproofs, restoredHealthyPeers);
+	
+	// Set state to the restored state
+	setRestoredState(move(restoredHeaders), restoredSyncedHeaderIndex, move(restoredKernels), move(restoredOutputs), move(restoredRangeproofs), move(restoredHealthyPeers));
+}
+
+// Set checkpoint file
+void Node::setCheckpointFile(const string &checkpointFile) {
+
+	// Check if started
+	if(started) {
 	
-	// Write rangeproofs to file
-	rangeproofs.save(file);
+		// Throw exception
+		throw runtime_error("Node is started");
+	}
 	
-	// Write healthy peers size to file
-	const uint64_t serializedHealthyPeersSize = Common::hostByteOrderToBigEndian(healthyPeers.size());
-	file.write(reinterpret_cast<const char *>(&serializedHealthyPeersSize), sizeof(serializedHealthyPeersSize));
+	// Set checkpoint file to checkpoint file
+	this->checkpointFile = checkpointFile;
+}
+
+// Save checkpoint
+void Node::saveCheckpoint() {
+
+	// Check if main thread is running
+	if(mainThread.joinable()) {
 	
-	// Go through all healthy peers
-	for(const pair<const string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeer : healthyPeers) {
+		// Throw exception
+		throw runtime_error("Node is running");
+	}
 	
-		// Write identifier size to file
-		const uint64_t serializedIdentifierSize = Common::hostByteOrderToBigEndian(healthyPeer.first.size());
-		file.write(reinterpret_cast<const char *>(&serializedIdentifierSize), sizeof(serializedIdentifierSize));
-		
-		// Write identifier to file
-		file.write(healthyPeer.first.data(), healthyPeer.first.size());
-		
-		// Write capabilities to file
-		const uint32_t serializedCapabilities = htonl(static_cast<underlying_type_t<Capabilities>>(healthyPeer.second.second));
-		file.write(reinterpret_cast<const char *>(&serializedCapabilities), sizeof(serializedCapabilities));
+	// Check if started and not disconnected
+	if(started && !disconnected) {
+	
+		// Throw exception
+		throw runtime_error("Node isn't disconnected");
+	}
+	
+	// Check if checkpoint file isn't set
+	if(checkpointFile.empty()) {
+	
+		// Throw exception
+		throw runtime_error("Checkpoint file isn't set");
 	}
+	
+	// Save checkpoint snapshot with a new identifier
+	const uint64_t newCheckpointIdentifier = randomNumberGenerator();
+	saveCheckpointSnapshot(checkpointFile, newCheckpointIdentifier, numberOfCheckpointDeltas, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, healthyPeers);
+	
+	// Set checkpoint identifier to the new checkpoint identifier
+	checkpointIdentifier = newCheckpointIdentifier;
+	
+	// Set number of checkpoint deltas to zero
+	numberOfCheckpointDeltas = 0;
+	
+	// Set checkpoint snapshot required to false
+	checkpointSnapshotRequired = false;
 }
 
-// Restore
-void Node::restore(ifstream &file) {
+// Restore checkpoint
+void Node::restoreCheckpoint() {
 
 	// Check if started
 	if(started) {
@@ -282,53 +370,50 @@ void Node::restore(ifstream &file) {
 		throw runtime_error("Node is started");
 	}
 	
-	// Read headers from file
-	headers = MerkleMountainRange<Header>::restore(file);
-	
-	// Read synced header index from file
-	uint64_t serializedSyncedHeaderIndex;
-	file.read(reinterpret_cast<char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
-	syncedHeaderIndex = Common::bigEndianToHostByteOrder(serializedSyncedHeaderIndex);
+	// Check if checkpoint file isn't set
+	if(checkpointFile.empty()) {
 	
-	// Read kernels from file
-	kernels = MerkleMountainRange<Kernel>::restore(file);
-	
-	// Read outputs from file
-	outputs = MerkleMountainRange<Output>::restore(file);
+		// Throw exception
+		throw runtime_error("Checkpoint file isn't set");
+	}
 	
-	// Read rangeproofs from file
-	rangeproofs = MerkleMountainRange<Rangeproof>::restore(file);
+	// Read checkpoint's snapshot and deltas into temporaries so that the node's state isn't changed if it fails
+	MerkleMountainRange<Header> restoredHeaders;
+	uint64_t restoredSyncedHeaderIndex;
+	MerkleMountainRange<Kernel> restoredKernels;
+	MerkleMountainRange<Output> restoredOutputs;
+	MerkleMountainRange<Rangeproof> restoredRangeproofs;
+	unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> restoredHealthyPeers;
+	uint64_t restoredNumberOfCheckpointDeltas;
+	const optional<uint64_t> fileCheckpointIdentifier = restoreCheckpointState(checkpointFile, restoredHeaders, restoredSyncedHeaderIndex, restoredKernels, restoredOutputs, restoredRangeproofs, restoredHealthyPeers, restoredNumberOfCheckpointDeltas);
 	
-	// Read healthy peers size from file
-	uint64_t serializedHealthyPeersSize;
-	file.read(reinterpret_cast<char *>(&serializedHealthyPeersSize), sizeof(serializedHealthyPeersSize));
-	const uint64_t healthyPeersSize = Common::bigEndianToHostByteOrder(serializedHealthyPeersSize);
+	// Set state to the restored state
+	setRestoredState(move(restoredHeaders), restoredSyncedHeaderIndex, move(restoredKernels), move(restoredOutputs), move(restoredRangeproofs), move(restoredHealthyPeers));
 	
-	// Go through all healthy peers
-	for(uint64_t i = 0; i < healthyPeersSize; ++i) {
+	// Check if file doesn't have a checkpoint identifier
+	if(!fileCheckpointIdentifier.has_value()) {
 	
-		// Read identifier size from file
-		uint64_t serializedIdentifierSize;
-		file.read(reinterpret_cast<char *>(&serializedIdentifierSize), sizeof(serializedIdentifierSize));
-		
-		// Read identifier from file
-		string identifier(Common::bigEndianToHostByteOrder(serializedIdentifierSize), '\0');
-		file.read(identifier.data(), identifier.size());
-		
-		// Read capabilities from file
-		uint32_t serializedCapabilities;
-		file.read(reinterpret_cast<char *>(&serializedCapabilities), sizeof(serializedCapabilities));
+		// Set checkpoint snapshot required to true
+		checkpointSnapshotRequired = true;
 		
-		// Add healthy peer to healthy peers
-		healthyPeers.emplace(move(identifier), make_pair(chrono::steady_clock::now(), static_cast<Capabilities>(ntohl(serializedCapabilities))));
+		// Return
+		return;
 	}
 	
-	// Go through all healthy peers
-	for(const pair<const string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeer : healthyPeers) {
+	// Start headers, kernels, outputs, and rangeproofs journals so that future checkpoint deltas continue from the restored state
+	headers.startJournal();
+	kernels.startJournal();
+	outputs.startJournal();
+	rangeproofs.startJournal();
 	
-		// Add healthy peer to unused peer candidates
-		unusedPeerCandidates.emplace(healthyPeer.first, chrono::steady_clock::now());
-	}
+	// Set checkpoint identifier to the file's checkpoint identifier
+	checkpointIdentifier = fileCheckpointIdentifier.value();
+	
+	// Set number of checkpoint deltas to the restored number of checkpoint deltas
+	numberOfCheckpointDeltas = restoredNumberOfCheckpointDeltas;
+	
+	// Set checkpoint snapshot required to false
+	checkpointSnapshotRequired = false;
 }
 
 // Set on start syncing callback
@@ -544,7 +629,7 @@ void Node::setOnMempoolClearCallback(const function<void(Node &node)> &onMempool
 }
 
 // Start
-void Node::start(const char *torProxyAddress, const uint16_t torProxyPort, const char *customDnsSeed, const uint64_t baseFee, const char *listeningAddress, const uint16_t listeningPort, const Capabilities desiredPeerCapabilities) {
+void Node::start(const char *torProxyAddress, const uint16_t torProxyPort, const char *customDnsSeed, const uint64_t baseFee, const char *listeningAddress, const uint16_t listeningPort, const Capabilities desiredPeerCapabilities, const unsigned int numberOfVerificationThreads) {
 
 	// Check if started
 	if(started) {
@@ -818,6 +903,9 @@ void Node::start(const char *torProxyAddress, const uint16_t torProxyPort, const
 		this->desiredPeerCapabilities = desiredPeerCapabilities;
 	#endif
 	
+	// Set number of verification threads to number of verification threads with at least one thread
+	this->numberOfVerificationThreads = max(numberOfVerificationThreads, static_cast<unsigned int>(1));
+	
 	// Try
 	try {
 	
@@ -940,8 +1028,8 @@ void Node::disconnect() {
 					// Check if performing initial sync and the peer obtained new headers
 					if(syncedHeaderIndex == Consensus::GENESIS_BLOCK_HEADER.getHeight() && !peer.getHeaders().empty() && peer.getHeaders().back().getHeight() > syncedHeaderIndex) {
 					
-						// Set headers to peer's headers
-						headers = move(peer.getHeaders());
+						// Replace headers with peer's headers
+						headers.replace(move(peer.getHeaders()));
 					}
 				}
 				
@@ -1203,9 +1291,26 @@ tuple<Header, Block, uint64_t> Node::getNextBlock(const function<tuple<Output, R
 			throw runtime_error("Node isn't sycned");
 		}
 		
+		// Get previous header
+		const Header *previousHeader = headers.getLeaf(syncedHeaderIndex);
+		
+		// Check if block template was created with the current mempool on top of the previous header at the next header's height
+		if(blockTemplate.has_value() && blockTemplateMempoolVersion == mempool.getVersion() && blockTemplatePreviousBlockHash == previousHeader->getBlockHash() && get<0>(blockTemplate.value()).getHeight() == SaturateMath::add(previousHeader->getHeight(), 1)) {
+		
+			// Get block template's header
+			const Header &templateHeader = get<0>(blockTemplate.value());
+			
+			// Create header from the block template's header with a new timestamp
+			const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES] = {};
+			Header header(templateHeader.getVersion(), templateHeader.getHeight(), max(chrono::system_clock::now() + Consensus::BLOCK_TIME, previousHeader->getTimestamp() + 1s), templateHeader.getPreviousBlockHash(), templateHeader.getPreviousHeaderRoot(), templateHeader.getOutputRoot(), templateHeader.getRangeproofRoot(), templateHeader.getKernelRoot(), templateHeader.getTotalKernelOffset(), templateHeader.getOutputMerkleMountainRangeSize(), templateHeader.getKernelMerkleMountainRangeSize(), templateHeader.getTotalDifficulty(), templateHeader.getSecondaryScaling(), 0, 0, proofNonces, false);
+			
+			// Return header, block template's block, and block template's target difficulty
+			return {move(header), get<1>(blockTemplate.value()), get<2>(blockTemplate.value())};
+		}
+		
 		// Initialize block inputs, outputs, and kernels
-		unordered_map<vector<uint8_t>, const Input *, Common::Uint8VectorHash> blockInputs;
-		unordered_map<vector<uint8_t>, pair<const Output *, const Rangeproof *>, Common::Uint8VectorHash> blockOutputs;
+		unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, const Input *, Common::Uint8ArrayHash> blockInputs;
+		unordered_map<array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Rangeproof *>, Common::Uint8ArrayHash> blockOutputs;
 		unordered_map<vector<uint8_t>, const Kernel *, Common::Uint8VectorHash> blockKernels;
 		
 		// Initialize fees to zero
@@ -1214,436 +1319,439 @@ tuple<Header, Block, uint64_t> Node::getNextBlock(const function<tuple<Output, R
 		// Initialize offsets
 		vector<const uint8_t *> offsets;
 		
-		// Go through all fees in the mempool in descending order
+		// Initialize included transactions
 		unordered_set<const Transaction *> includedTransactions;
-		unordered_set<vector<uint8_t>, Common::Uint8VectorHash> pendingOutputs;
-		for(map<uint64_t, unordered_set<const Transaction *>>::const_reverse_iterator i = mempool.getFees().crbegin(); i != mempool.getFees().crend();) {
 		
-			// Initialize recheck transactions to false
-			bool recheckTransactions = false;
+		// Initialize considered transactions
+		unordered_set<const Transaction *> consideredTransactions;
+		
+		// Initialize modified packages and their fee rates for transactions that have ancestors included in the block
+		unordered_map<const Transaction *, tuple<uint64_t, uint64_t, const Transaction *>> modifiedPackages;
+		Mempool::PackageFeeRates modifiedPackageFeeRates;
+		
+		// Go through all packages in the mempool and modified packages in descending fee rate order
+		Mempool::PackageFeeRates::const_iterator nextPackageFeeRate = mempool.getPackageFeeRates().cbegin();
+		while(true) {
+		
+			// Loop while the next package's transaction is already included in the block, was already considered, or has a modified package
+			while(nextPackageFeeRate != mempool.getPackageFeeRates().cend() && (includedTransactions.contains(get<2>(*nextPackageFeeRate)) || consideredTransactions.contains(get<2>(*nextPackageFeeRate)) || modifiedPackages.contains(get<2>(*nextPackageFeeRate)))) {
 			
-			// Go through all transactions with the fees
-			for(const Transaction *transaction : i->second) {
+				// Go to next package
+				++nextPackageFeeRate;
+			}
 			
-				// Check if transaction isn't already included in the block
-				if(!includedTransactions.contains(transaction)) {
+			// Check if no packages remain
+			if(nextPackageFeeRate == mempool.getPackageFeeRates().cend() && modifiedPackageFeeRates.empty()) {
 			
-					// Check if block with the transaction won't have too many inputs, outputs, or kernels
-					if(blockInputs.size() + transaction->getInputs().size() <= Message::MAXIMUM_INPUTS_LENGTH && blockOutputs.size() + transaction->getOutputs().size() <= Message::MAXIMUM_OUTPUTS_LENGTH - 1 && blockKernels.size() + transaction->getKernels().size() <= Message::MAXIMUM_KERNELS_LENGTH - 1) {
-				
-						// Check if block's weight with the transaction is valid
-						if(Consensus::getBlockWeight(blockInputs.size() + transaction->getInputs().size(), blockOutputs.size() + transaction->getOutputs().size() + 1, blockKernels.size() + transaction->getKernels().size() + 1) <= Consensus::MAXIMUM_BLOCK_WEIGHT) {
-				
-							// Initialize include transaction to true
-							bool includeTransaction = true;
-							
-							// Go through all of the transaction's kernels
-							for(const Kernel &kernel : transaction->getKernels()) {
-							
-								// Check if kernel already exists in the block
-								if(blockKernels.contains(kernel.serialize())) {
-								
-									// Set include transaction to false
-									includeTransaction = false;
-									
-									// Break
-									break;
-								}
-							}
-							
-							// Check if including transaction
-							if(includeTransaction) {
-						
-								// Go through all of the transaction's inputs
-								for(const Input &input : transaction->getInputs()) {
-									
-									// Check if input already exists in the block
-									vector inputLookupValue = input.getLookupValue();
-									if(blockInputs.contains(inputLookupValue)) {
-									
-										// Set include transaction to false
-										includeTransaction = false;
-										
-										// Break
-										break;
-									}
-									
-									// Otherwise check if output doesn't exist
-									else if(!outputs.leafWithLookupValueExists(inputLookupValue) && !blockOutputs.contains(inputLookupValue)) {
-									
-										// Set include transaction to false
-										includeTransaction = false;
-										
-										// Add output to pending outputs
-										pendingOutputs.insert(move(inputLookupValue));
-										
-										// Break
-										break;
-									}
-								}
-							}
-							
-							// Check if including transaction
-							if(includeTransaction) {
-							
-								// Add transaction to list of included transactions
-								includedTransactions.insert(transaction);
-								
-								// Check if transaction's offset isn't zero
-								if(any_of(transaction->getOffset(), transaction->getOffset() + Crypto::SECP256K1_PRIVATE_KEY_LENGTH, [](const uint8_t value) {
-	
-									// Return if value isn't zero
-									return value;
-								
-								})) {
-								
-									// Add transaction's offset to list of offsets
-									offsets.push_back(transaction->getOffset());
-								}
-							
-								// Go through all of the transaction's inputs
-								for(const Input &input : transaction->getInputs()) {
-								
-									// Check if input is the output from another transaction in the block
-									vector inputLookupValue = input.getLookupValue();
-									if(blockOutputs.contains(inputLookupValue)) {
-									
-										// Remove output from block outputs
-										blockOutputs.erase(inputLookupValue);
-									}
-									
-									// Otherwise
-									else {
-								
-										// Add input to block inputs
-										blockInputs.emplace(move(inputLookupValue), &input);
-									}
-								}
-								
-								// Go through all of the transaction's outputs
-								list<Output>::const_iterator j = transaction->getOutputs().cbegin();
-								for(list<Rangeproof>::const_iterator k = transaction->getRangeproofs().cbegin(); j != transaction->getOutputs().cend(); ++j, ++k) {
-								
-									// Check if output is the input to another transaction
-									vector outputLookupValue = j->getLookupValue().value();
-									if(pendingOutputs.contains(outputLookupValue)) {
-									
-										// Set recheck transactions to true
-										recheckTransactions = true;
-									}
-									
-									// Add output and rangeproof to block outputs
-									blockOutputs.emplace(move(outputLookupValue), make_pair(&*j, &*k));
-								}
-								
-								// Go through all of the transaction's kernels
-								for(const Kernel &kernel : transaction->getKernels()) {
-								
-									// Add kernel to block kernels
-									blockKernels.emplace(kernel.serialize(), &kernel);
-									
-									// Add kernel's fees to fees
-									fees = SaturateMath::add(fees, kernel.getMaskedFee());
-								}
-								
-								// Check if rechecking transactions
-								if(recheckTransactions) {
-								
-									// Break
-									break;
-								}
-							}
-						}
-					}
-				}
+				// Break
+				break;
 			}
 			
-			// Check if rechecking transactions
-			if(recheckTransactions) {
+			// Check if the best modified package has a higher fee rate than the next package
+			const Transaction *packageTransaction;
+			if(!modifiedPackageFeeRates.empty() && (nextPackageFeeRate == mempool.getPackageFeeRates().cend() || modifiedPackageFeeRates.key_comp()(*modifiedPackageFeeRates.cbegin(), *nextPackageFeeRate))) {
 			
-				// Go to first fees
-				i = mempool.getFees().crbegin();
+				// Set package's transaction to the best modified package's transaction
+				packageTransaction = get<2>(*modifiedPackageFeeRates.cbegin());
 				
-				// Clear pending outputs
-				pendingOutputs.clear();
+				// Remove best modified package
+				modifiedPackageFeeRates.erase(modifiedPackageFeeRates.cbegin());
+				modifiedPackages.erase(packageTransaction);
 			}
 			
 			// Otherwise
 			else {
 			
-				// Go to next fees
-				++i;
-			}
-		}
-		
-		// Get previous header
-		const Header *previousHeader = headers.getLeaf(syncedHeaderIndex);
-		
-		// Check if previous header's total kernel offset isn't zero
-		if(any_of(previousHeader->getTotalKernelOffset(), previousHeader->getTotalKernelOffset() + Crypto::SECP256K1_PRIVATE_KEY_LENGTH, [](const uint8_t value) {
-
-			// Return if value isn't zero
-			return value;
-		
-		})) {
-		
-			// Add previous header's total kernel offset to list of offsets
-			offsets.push_back(previousHeader->getTotalKernelOffset());
-		}
-		
-		// Initialize total kernel offset
-		uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH] = {};
-		
-		// Check if non-zero offsets exist
-		if(!offsets.empty()) {
-		
-			// Check if getting total kernel offset failed
-			if(!secp256k1_pedersen_blind_sum(secp256k1_context_no_precomp, totalKernelOffset, offsets.data(), offsets.size(), offsets.size())) {
-			
-				// Throw exception
-				throw runtime_error("Getting total kernel offset failed");
+				// Set package's transaction to the next package's transaction
+				packageTransaction = get<2>(*nextPackageFeeRate);
+				
+				// Go to next package
+				++nextPackageFeeRate;
 			}
-		
-			// Check if total kernel offset is invalid
-			if(any_of(cbegin(totalKernelOffset), cend(totalKernelOffset), [](const uint8_t value) {
-			
-				// Return if value isn't zero
-				return value;
 			
-			}) && !secp256k1_ec_seckey_verify(secp256k1_context_no_precomp, totalKernelOffset)) {
-			
-				// Throw exception
-				throw runtime_error("Total kernel offset is invalid");
-			}
-		}
-		
-		// Initialize secondary scaling sum to zero
-		uint64_t secondaryScalingSum = 0;
-		
-		// Initialize difficulty sum to zero
-		uint64_t difficultySum = 0;
-		
-		// Initialize number of C29 headers to zero
-		uint64_t numberOfC29Headers = 0;
-		
-		// Go through all previous headers in the difficulty adjustment window
-		for(uint64_t i = 0; i < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW; ++i) {
-		
-			// Add header's secondary scaling to the sum
-			secondaryScalingSum += (i <= previousHeader->getHeight()) ? headers.getLeaf(previousHeader->getHeight() - i)->getSecondaryScaling() : Consensus::GENESIS_BLOCK_HEADER.getSecondaryScaling();
+			// Add package's transaction to list of considered transactions
+			consideredTransactions.insert(packageTransaction);
 			
-			// Check if previous header exists
-			if(i <= previousHeader->getHeight()) {
+			// Go through all of the package transaction's ancestors
+			vector<const Transaction *> packageTransactions;
+			for(const Transaction *ancestor : mempool.getAncestors(packageTransaction)) {
 			
-				// Check if header before the previous header exists
-				if(i + 1 <= previousHeader->getHeight()) {
-				
-					// Add header's difficulty to the difficulty sum
-					difficultySum += headers.getLeaf(previousHeader->getHeight() - i)->getTotalDifficulty() - headers.getLeaf(previousHeader->getHeight() - (i + 1))->getTotalDifficulty();
-				}
-				
-				// Otherwise
-				else {
+				// Check if ancestor isn't already included in the block
+				if(!includedTransactions.contains(ancestor)) {
 				
-					// Add header's difficulty to the difficulty sum
-					difficultySum += headers.getLeaf(previousHeader->getHeight() - i)->getTotalDifficulty();
+					// Add ancestor to package's transactions
+					packageTransactions.push_back(ancestor);
 				}
 			}
 			
-			// Otherwise
-			else {
+			// Add package's transaction to the package's transactions
+			packageTransactions.push_back(packageTransaction);
 			
-				// Add header's difficulty to the difficulty sum
-				difficultySum += previousHeader->getTotalDifficulty() - (previousHeader->getHeight() ? headers.getLeaf(previousHeader->getHeight() - 1)->getTotalDifficulty() : 0);
-			}
+			// Sort package's transactions so that transactions come before the transactions that spend their outputs
+			sort(packageTransactions.begin(), packageTransactions.end(), [this](const Transaction *firstTransaction, const Transaction *secondTransaction) -> bool {
 			
-			// Check if header uses C29 proof of work
-			if(((i <= previousHeader->getHeight()) ? headers.getLeaf(previousHeader->getHeight() - i)->getEdgeBits() : Consensus::GENESIS_BLOCK_HEADER.getEdgeBits()) == Consensus::C29_EDGE_BITS) {
+				// Return if the first transaction has fewer ancestors than the second transaction
+				return mempool.getNumberOfAncestors(firstTransaction) < mempool.getNumberOfAncestors(secondTransaction);
+			});
 			
-				// Increment the number of C29 headers
-				++numberOfC29Headers;
-			}
-		}
-		
-		// Get next header height
-		const uint64_t nextHeaderHeight = SaturateMath::add(syncedHeaderIndex, 1);
-		
-		// Get target C29 ratio
-		const uint64_t targetC29Ratio = Consensus::getC29ProofOfWorkRatio(nextHeaderHeight);
-		
-		// Get target number of C29 headers
-		const uint64_t targetNumberOfC29Headers = Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * targetC29Ratio;
-		
-		// Get C29 headers adjustment
-		const uint64_t c29HeadersAdjustment = Common::clamp(Common::damp(numberOfC29Headers * 100, targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_DAMP_FACTOR), targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_CLAMP_FACTOR);
+			// Initialize include package to true
+			bool includePackage = true;
+			
+			// Initialize package inputs, outputs, and kernels
+			unordered_set<array<uint8_t, Crypto::COMMITMENT_LENGTH>, Common::Uint8ArrayHash> packageInputs;
+			unordered_set<array<uint8_t, Crypto::COMMITMENT_LENGTH>, Common::Uint8ArrayHash> packageOutputs;
+			unordered_set<vector<uint8_t>, Common::Uint8VectorHash> packageKernels;
+			
+			// Initialize number of spent outputs to zero
+			uint64_t numberOfSpentOutputs = 0;
+			
+			// Go through all of the package's transactions while including the package
+			for(vector<const Transaction *>::const_iterator i = packageTransactions.cbegin(); i != packageTransactions.cend() && includePackage; ++i) {
+			
+				// Go through all of the transaction's inputs
+				for(const Input &input : (*i)->getInputs()) {
+				
+					// Check if input already exists in the block or the package
+					array inputLookupValue = input.getLookupValue();
+					if(blockInputs.contains(inputLookupValue) || packageInputs.contains(inputLookupValue)) {
+					
+						// Set include package to false
+						includePackage = false;
+						
+						// Break
+						break;
+					}
+					
+					// Check if input is the output from another transaction in the block or the package
+					if(blockOutputs.contains(inputLookupValue) || packageOutputs.contains(inputLookupValue)) {
+					
+						// Increment number of spent outputs
+						++numberOfSpentOutputs;
+					}
+					
+					// Otherwise check if output doesn't exist
+					else if(!outputs.leafWithLookupValueExists(inputLookupValue)) {
+					
+						// Set include package to false
+						includePackage = false;
+						
+						// Break
+						break;
+					}
+					
+					// Add input to package inputs
+					packageInputs.insert(move(inputLookupValue));
+				}
+				
+				// Check if including package
+				if(includePackage) {
+				
+					// Go through all of the transaction's outputs
+					for(const Output &output : (*i)->getOutputs()) {
+					
+						// Add output to package outputs
+						packageOutputs.insert(output.getLookupValue().value());
+					}
+					
+					// Go through all of the transaction's kernels
+					for(const Kernel &kernel : (*i)->getKernels()) {
+					
+						// Check if kernel already exists in the block or the package
+						vector serializedKernel = kernel.serialize();
+						if(blockKernels.contains(serializedKernel) || packageKernels.contains(serializedKernel)) {
+						
+							// Set include package to false
+							includePackage = false;
+							
+							// Break
+							break;
+						}
+						
+						// Add kernel to package kernels
+						packageKernels.insert(move(serializedKernel));
+					}
+				}
+			}
+			
+			// Check if including package
+			if(includePackage) {
+			
+				// Get block's number of inputs, outputs, and kernels with the package
+				const uint64_t numberOfInputs = blockInputs.size() + packageInputs.size() - numberOfSpentOutputs;
+				const uint64_t numberOfOutputs = blockOutputs.size() + packageOutputs.size() - numberOfSpentOutputs;
+				const uint64_t numberOfKernels = blockKernels.size() + packageKernels.size();
+				
+				// Check if block with the package won't have too many inputs, outputs, or kernels and its weight with the package is valid
+				if(numberOfInputs <= Message::MAXIMUM_INPUTS_LENGTH && numberOfOutputs <= Message::MAXIMUM_OUTPUTS_LENGTH - 1 && numberOfKernels <= Message::MAXIMUM_KERNELS_LENGTH - 1 && Consensus::getBlockWeight(numberOfInputs, numberOfOutputs + 1, numberOfKernels + 1) <= Consensus::MAXIMUM_BLOCK_WEIGHT) {
+				
+					// Go through all of the package's transactions
+					for(const Transaction *transaction : packageTransactions) {
+					
+						// Add transaction to list of included transactions
+						includedTransactions.insert(transaction);
+						
+						// Check if transaction's offset isn't zero
+						if(any_of(transaction->getOffset(), transaction->getOffset() + Crypto::SECP256K1_PRIVATE_KEY_LENGTH, [](const uint8_t value) {
+						
+							// Return if value isn't zero
+							return value;
+							
+						})) {
+						
+							// Add transaction's offset to list of offsets
+							offsets.push_back(transaction->getOffset());
+						}
+						
+						// Go through all of the transaction's inputs
+						for(const Input &input : transaction->getInputs()) {
+						
+							// Check if input is the output from another transaction in the block
+							array inputLookupValue = input.getLookupValue();
+							if(blockOutputs.contains(inputLookupValue)) {
+							
+								// Remove output from block outputs
+								blockOutputs.erase(inputLookupValue);
+							}
+							
+							// Otherwise
+							else {
+							
+								// Add input to block inputs
+								blockInputs.emplace(move(inputLookupValue), &input);
+							}
+						}
+						
+						// Go through all of the transaction's outputs
+						vector<Output>::const_iterator j = transaction->getOutputs().cbegin();
+						for(vector<Rangeproof>::const_iterator k = transaction->getRangeproofs().cbegin(); j != transaction->getOutputs().cend(); ++j, ++k) {
+						
+							// Add output and rangeproof to block outputs
+							blockOutputs.emplace(j->getLookupValue().value(), make_pair(&*j, &*k));
+						}
+						
+						// Go through all of the transaction's kernels
+						for(const Kernel &kernel : transaction->getKernels()) {
+						
+							// Add kernel to block kernels
+							blockKernels.emplace(kernel.serialize(), &kernel);
+							
+							// Add kernel's fees to fees
+							fees = SaturateMath::add(fees, kernel.getMaskedFee());
+						}
+					}
+					
+					// Go through all of the package's transactions
+					unordered_set<const Transaction *> updatedTransactions;
+					for(const Transaction *transaction : packageTransactions) {
+					
+						// Go through all of the transaction's descendants
+						for(const Transaction *descendant : mempool.getDescendants(transaction)) {
+						
+							// Check if descendant isn't included in the block and wasn't already considered
+							if(!includedTransactions.contains(descendant) && !consideredTransactions.contains(descendant)) {
+							
+								// Add descendant to list of updated transactions
+								updatedTransactions.insert(descendant);
+							}
+						}
+					}
+					
+					// Go through all updated transactions
+					for(const Transaction *transaction : updatedTransactions) {
+					
+						// Check if transaction already has a modified package
+						if(modifiedPackages.contains(transaction)) {
+						
+							// Remove transaction's modified package fee rate
+							modifiedPackageFeeRates.erase(modifiedPackages.at(transaction));
+						}
+						
+						// Set transaction's modified package fee rate to its package without the transactions included in the block
+						const tuple modifiedPackageFeeRate = mempool.getPackageFeeRate(transaction, includedTransactions);
+						modifiedPackages[transaction] = modifiedPackageFeeRate;
+						modifiedPackageFeeRates.insert(modifiedPackageFeeRate);
+					}
+				}
+			}
+		}
 		
-		// Get target secondary scaling
-		const uint32_t targetSecondaryScaling = max(secondaryScalingSum * targetC29Ratio / max(static_cast<uint64_t>(1), c29HeadersAdjustment), static_cast<uint64_t>(Consensus::MINIMUM_SECONDARY_SCALING));
+		// Check if previous header's total kernel offset isn't zero
+		if(any_of(previousHeader->getTotalKernelOffset(), previousHeader->getTotalKernelOffset() + Crypto::SECP256K1_PRIVATE_KEY_LENGTH, [](const uint8_t value) {
+
+			// Return if value isn't zero
+			return value;
 		
-		// Set number of missing headers
-		const uint64_t numberOfMissingHeaders = (previousHeader->getHeight() < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW) ? Consensus::DIFFICULTY_ADJUSTMENT_WINDOW - previousHeader->getHeight() : 0;
+		})) {
 		
-		// Get last timestamp delta
-		const chrono::seconds lastTimestampDelta = (previousHeader->getHeight() != Consensus::GENESIS_BLOCK_HEADER.getHeight()) ? chrono::duration_cast<chrono::seconds>(previousHeader->getTimestamp() - headers.getLeaf(previousHeader->getHeight() - 1)->getTimestamp()) : Consensus::BLOCK_TIME;
+			// Add previous header's total kernel offset to list of offsets
+			offsets.push_back(previousHeader->getTotalKernelOffset());
+		}
 		
-		// Initialize window start timestamp
-		chrono::time_point<chrono::system_clock> windowStartTimestamp;
+		// Initialize total kernel offset
+		uint8_t totalKernelOffset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH] = {};
 		
-		// Check if headers are missing from the window
-		if(numberOfMissingHeaders) {
+		// Check if non-zero offsets exist
+		if(!offsets.empty()) {
 		
-			// Check if window start timestamp won't underflow
-			if(lastTimestampDelta * numberOfMissingHeaders <= chrono::duration_cast<chrono::seconds>(Consensus::GENESIS_BLOCK_HEADER.getTimestamp().time_since_epoch())) {
+			// Check if getting total kernel offset failed
+			if(!secp256k1_pedersen_blind_sum(secp256k1_context_no_precomp, totalKernelOffset, offsets.data(), offsets.size(), offsets.size())) {
 			
-				// Set window start timestamp to the timestamp of the first missing block in the window
-				windowStartTimestamp = Consensus::GENESIS_BLOCK_HEADER.getTimestamp() - lastTimestampDelta * numberOfMissingHeaders;
+				// Throw exception
+				throw runtime_error("Getting total kernel offset failed");
 			}
+		
+			// Check if total kernel offset is invalid
+			if(any_of(cbegin(totalKernelOffset), cend(totalKernelOffset), [](const uint8_t value) {
 			
-			// Otherwise
-			else {
+				// Return if value isn't zero
+				return value;
+			
+			}) && !secp256k1_ec_seckey_verify(secp256k1_context_no_precomp, totalKernelOffset)) {
 			
-				// Set window start timestamp to zero
-				windowStartTimestamp = chrono::time_point<chrono::system_clock>(chrono::seconds(0));
+				// Throw exception
+				throw runtime_error("Total kernel offset is invalid");
 			}
 		}
 		
-		// Otherwise
-		else {
-		
-			// Set window start timestamp to the timestamp of the first header in the window
-			windowStartTimestamp = headers.getLeaf(previousHeader->getHeight() - Consensus::DIFFICULTY_ADJUSTMENT_WINDOW)->getTimestamp();
-		}
-		
-		// Get window duration
-		const chrono::seconds windowDuration = chrono::duration_cast<chrono::seconds>(previousHeader->getTimestamp() - windowStartTimestamp);
+		// Get next header height
+		const uint64_t nextHeaderHeight = SaturateMath::add(syncedHeaderIndex, 1);
 		
-		// Get window duration adjustment
-		const uint64_t windowDurationAdjustment = Common::clamp(Common::damp(windowDuration.count(), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_DAMP_FACTOR), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_CLAMP_FACTOR);
+		// Get target difficulty and secondary scaling using the difficulty adjustment window
+		const pair targetDifficultyAndSecondaryScaling = difficultyAdjustmentWindow.getTargetDifficultyAndSecondaryScaling(headers, *previousHeader, previousHeader->getBlockHash());
 		
 		// Get target difficulty
-		const uint64_t targetDifficulty = max(Consensus::MINIMUM_DIFFICULTY, difficultySum * Consensus::BLOCK_TIME.count() / windowDurationAdjustment);
+		const uint64_t targetDifficulty = targetDifficultyAndSecondaryScaling.first;
+		
+		// Get target secondary scaling
+		const uint32_t targetSecondaryScaling = targetDifficultyAndSecondaryScaling.second;
 		
 		// Get reward as the sum of the coinbase reward at next header's height and the fees
 		const uint64_t reward = SaturateMath::add(Consensus::getCoinbaseReward(nextHeaderHeight), fees);
 		
-		// Loop until coinbase can be used in the block
+		// Check if the previous block template's coinbase is for the same height and reward
 		optional<tuple<Output, Rangeproof, Kernel>> coinbase;
+		if(blockTemplateCoinbase.has_value() && get<0>(blockTemplateCoinbase.value()) == nextHeaderHeight && get<1>(blockTemplateCoinbase.value()) == reward) {
+		
+			// Set coinbase to the previous block template's coinbase
+			coinbase = get<2>(blockTemplateCoinbase.value());
+		}
+		
+		// Loop until coinbase can be used in the block
 		while(true) {
 		
-			// Create coinbase for reward
-			coinbase = createCoinbase(reward);
+			// Check if coinbase doesn't exist
+			if(!coinbase.has_value()) {
+			
+				// Create coinbase for reward
+				coinbase = createCoinbase(reward);
+			}
 		
 			// Check if coinbase output and kernel don't already exist in the block
-			const vector coinbaseOutputLookupValue = get<0>(coinbase.value()).getLookupValue().value();
+			const array coinbaseOutputLookupValue = get<0>(coinbase.value()).getLookupValue().value();
 			if(!outputs.leafWithLookupValueExists(coinbaseOutputLookupValue) && !blockInputs.contains(coinbaseOutputLookupValue) && !blockOutputs.contains(coinbaseOutputLookupValue) && !blockKernels.contains(get<2>(coinbase.value()).serialize())) {
 			
 				// Break
 				break;
 			}
+			
+			// Reset coinbase
+			coinbase.reset();
 		}
 		
+		// Set block template coinbase to the coinbase so that it can be reused while the height and reward don't change
+		blockTemplateCoinbase.emplace(nextHeaderHeight, reward, coinbase.value());
+		
 		// Go through all of the block's inputs
-		list<Input> inputs;
-		for(const pair<const vector<uint8_t>, const Input *> &input : blockInputs) {
+		vector<Input> inputs;
+		inputs.reserve(blockInputs.size());
+		for(const pair<const array<uint8_t, Crypto::COMMITMENT_LENGTH>, const Input *> &input : blockInputs) {
 		
 			// Add input to inputs
 			inputs.push_back(*input.second);
 		}
 		
-		// Go through all of the block's outputs
-		list<pair<Output, Rangeproof>> sortedOutputsAndRangeproofs;
-		for(const pair<const vector<uint8_t>, pair<const Output *, const Rangeproof *>> &output : blockOutputs) {
-		
-			// Add output to sorted outputs and rangeproofs
-			sortedOutputsAndRangeproofs.emplace_back(*output.second.first, *output.second.second);
-		}
-		
-		// Add coinbase output and rangeproof to sorted outputs and rangeproofs
-		sortedOutputsAndRangeproofs.emplace_back(move(get<0>(coinbase.value())), move(get<1>(coinbase.value())));
+		// Add coinbase output and rangeproof to the block's outputs
+		blockOutputs.emplace(get<0>(coinbase.value()).getLookupValue().value(), make_pair(&get<0>(coinbase.value()), &get<1>(coinbase.value())));
 		
-		// Sort sorted outputs and rangeproofs
-		sortedOutputsAndRangeproofs.sort([](const pair<Output, Rangeproof> &firstOutputAndRangeproof, const pair<Output, Rangeproof> &secondOutputAndRangeproof) -> bool {
+		// Go through all of the block's outputs
+		vector<pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, pair<const Output *, const Rangeproof *>>> sortedOutputsAndRangeproofs;
+		sortedOutputsAndRangeproofs.reserve(blockOutputs.size());
+		for(const pair<const array<uint8_t, Crypto::COMMITMENT_LENGTH>, pair<const Output *, const Rangeproof *>> &output : blockOutputs) {
 		
-			// Get serialized first output and rangeproof's output
-			const vector serializedFirstOutput = firstOutputAndRangeproof.first.serialize();
-			
-			// Check if creating first output's hash failed
-			uint8_t firstOutputHash[Crypto::BLAKE2B_HASH_LENGTH];
-			if(blake2b(firstOutputHash, sizeof(firstOutputHash), serializedFirstOutput.data(), serializedFirstOutput.size(), nullptr, 0)) {
-			
-				// Throw exception
-				throw runtime_error("Creating first output's hash failed");
-			}
-			
-			// Get serialized second output and rangeproof's output
-			const vector serializedSecondOutput = secondOutputAndRangeproof.first.serialize();
+			// Get serialized output
+			const vector serializedOutput = output.second.first->serialize();
 			
-			// Check if creating second output's hash failed
-			uint8_t secondOutputHash[Crypto::BLAKE2B_HASH_LENGTH];
-			if(blake2b(secondOutputHash, sizeof(secondOutputHash), serializedSecondOutput.data(), serializedSecondOutput.size(), nullptr, 0)) {
+			// Check if creating output's hash failed
+			array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> outputHash;
+			if(blake2b(outputHash.data(), outputHash.size(), serializedOutput.data(), serializedOutput.size(), nullptr, 0)) {
 			
 				// Throw exception
-				throw runtime_error("Creating second output's hash failed");
+				throw runtime_error("Creating output's hash failed");
 			}
 			
+			// Add output's hash, output, and rangeproof to sorted outputs and rangeproofs so that each output is only hashed once
+			sortedOutputsAndRangeproofs.emplace_back(outputHash, output.second);
+		}
+		
+		// Sort sorted outputs and rangeproofs by their output hashes
+		sort(sortedOutputsAndRangeproofs.begin(), sortedOutputsAndRangeproofs.end(), [](const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, pair<const Output *, const Rangeproof *>> &firstOutputAndRangeproof, const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, pair<const Output *, const Rangeproof *>> &secondOutputAndRangeproof) -> bool {
+		
 			// Return comparing the first and second output hashes
-			return memcmp(firstOutputHash, secondOutputHash, sizeof(secondOutputHash)) < 0;
+			return firstOutputAndRangeproof.first < secondOutputAndRangeproof.first;
 		});
 		
 		// Go through all sorted outputs and rangeproofs
-		list<Output> sortedOutputs;
-		list<Rangeproof> sortedRangeproofs;
-		for(pair<Output, Rangeproof> &outputAndRangeproof : sortedOutputsAndRangeproofs) {
+		vector<Output> sortedOutputs;
+		sortedOutputs.reserve(sortedOutputsAndRangeproofs.size());
+		vector<Rangeproof> sortedRangeproofs;
+		sortedRangeproofs.reserve(sortedOutputsAndRangeproofs.size());
+		for(const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, pair<const Output *, const Rangeproof *>> &outputAndRangeproof : sortedOutputsAndRangeproofs) {
 		
 			// Add output to sorted outputs
-			sortedOutputs.push_back(move(outputAndRangeproof.first));
+			sortedOutputs.push_back(*outputAndRangeproof.second.first);
 			
 			// Add rangeproof to sorted rangeproofs
-			sortedRangeproofs.push_back(move(outputAndRangeproof.second));
+			sortedRangeproofs.push_back(*outputAndRangeproof.second.second);
 		}
 		
+		// Add coinbase kernel to the block's kernels
+		blockKernels.emplace(get<2>(coinbase.value()).serialize(), &get<2>(coinbase.value()));
+		
 		// Go through all of the block's kernels
-		list<Kernel> sortedKernels;
+		vector<pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, const Kernel *>> kernelHashes;
+		kernelHashes.reserve(blockKernels.size());
 		for(const pair<const vector<uint8_t>, const Kernel *> &kernel : blockKernels) {
 		
-			// Add kernel to sorted kernels
-			sortedKernels.push_back(*kernel.second);
-		}
-		
-		// Add coinbase kernel to sorted kernels
-		sortedKernels.push_back(move(get<2>(coinbase.value())));
-		
-		// Sort sorted kernels
-		sortedKernels.sort([](const Kernel &firstKernel, const Kernel &secondKernel) -> bool {
-		
-			// Get serialized first kernel
-			const vector serializedFirstKernel = firstKernel.serialize();
-			
-			// Check if creating first kernel's hash failed
-			uint8_t firstKernelHash[Crypto::BLAKE2B_HASH_LENGTH];
-			if(blake2b(firstKernelHash, sizeof(firstKernelHash), serializedFirstKernel.data(), serializedFirstKernel.size(), nullptr, 0)) {
+			// Check if creating kernel's hash failed
+			array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> kernelHash;
+			if(blake2b(kernelHash.data(), kernelHash.size(), kernel.first.data(), kernel.first.size(), nullptr, 0)) {
 			
 				// Throw exception
-				throw runtime_error("Creating first kernel's hash failed");
-			}
-			
-			// Get serialized second kernel
-			const vector serializedSecondKernel = secondKernel.serialize();
-			
-			// Check if creating second kernel's hash failed
-			uint8_t secondKernelHash[Crypto::BLAKE2B_HASH_LENGTH];
-			if(blake2b(secondKernelHash, sizeof(secondKernelHash), serializedSecondKernel.data(), serializedSecondKernel.size(), nullptr, 0)) {
-			
-				// Throw exception
-				throw runtime_error("Creating second kernel's hash failed");
+				throw runtime_error("Creating kernel's hash failed");
 			}
 			
+			// Add kernel's hash and kernel to kernel hashes so that each kernel is only hashed once
+			kernelHashes.emplace_back(kernelHash, kernel.second);
+		}
+		
+		// Sort kernel hashes
+		sort(kernelHashes.begin(), kernelHashes.end(), [](const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, const Kernel *> &firstKernel, const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, const Kernel *> &secondKernel) -> bool {
+		
 			// Return comparing the first and second kernel hashes
-			return memcmp(firstKernelHash, secondKernelHash, sizeof(secondKernelHash)) < 0;
+			return firstKernel.first < secondKernel.first;
 		});
 		
+		// Go through all kernel hashes
+		vector<Kernel> sortedKernels;
+		sortedKernels.reserve(kernelHashes.size());
+		for(const pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, const Kernel *> &kernel : kernelHashes) {
+		
+			// Add kernel to sorted kernels
+			sortedKernels.push_back(*kernel.second);
+		}
+		
 		// Create block from inputs, sorted outputs, sorted rangeproofs, and sorted kernels
-		const Block block(move(inputs), move(sortedOutputs), move(sortedRangeproofs), move(sortedKernels), false, false);
+		Block block(move(inputs), move(sortedOutputs), move(sortedRangeproofs), move(sortedKernels), false, false);
 		
 		// Try
 		try {
@@ -1730,7 +1838,7 @@ tuple<Header, Block, uint64_t> Node::getNextBlock(const function<tuple<Output, R
 			
 			// Create header
 			const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES] = {};
-			const Header header(Consensus::getHeaderVersion(nextHeaderHeight), nextHeaderHeight, max(chrono::system_clock::now() + Consensus::BLOCK_TIME, previousHeader->getTimestamp() + 1s), previousHeader->getBlockHash().data(), headers.getRootAtNumberOfLeaves(previousHeader->getHeight() + 1).data(), outputs.getRootAtSize(outputs.getSize()).data(), rangeproofs.getRootAtSize(rangeproofs.getSize()).data(), kernels.getRootAtSize(kernels.getSize()).data(), totalKernelOffset, outputs.getSize(), kernels.getSize(), SaturateMath::add(previousHeader->getTotalDifficulty(), targetDifficulty), targetSecondaryScaling, 0, 0, proofNonces, false);
+			Header header(Consensus::getHeaderVersion(nextHeaderHeight), nextHeaderHeight, max(chrono::system_clock::now() + Consensus::BLOCK_TIME, previousHeader->getTimestamp() + 1s), previousHeader->getBlockHash().data(), headers.getRootAtNumberOfLeaves(previousHeader->getHeight() + 1).data(), outputs.getRootAtSize(outputs.getSize()).data(), rangeproofs.getRootAtSize(rangeproofs.getSize()).data(), kernels.getRootAtSize(kernels.getSize()).data(), totalKernelOffset, outputs.getSize(), kernels.getSize(), SaturateMath::add(previousHeader->getTotalDifficulty(), targetDifficulty), targetSecondaryScaling, 0, 0, proofNonces, false);
 			
 			// Try
 			try {
@@ -1796,8 +1904,17 @@ tuple<Header, Block, uint64_t> Node::getNextBlock(const function<tuple<Output, R
 				throw runtime_error("Removing block to Merkle mountain ranges failed");
 			}
 			
-			// Return header, block, and target difficulty
-			return {header, block, targetDifficulty};
+			// Set block template to the header, block, and target difficulty
+			blockTemplate.emplace(header, block, targetDifficulty);
+			
+			// Set block template mempool version to the mempool's version
+			blockTemplateMempoolVersion = mempool.getVersion();
+			
+			// Set block template previous block hash to the previous header's block hash
+			blockTemplatePreviousBlockHash = previousHeader->getBlockHash();
+			
+			// Return header, block, and target difficulty without copying them
+			return {move(header), move(block), targetDifficulty};
 		}
 		
 		// Catch errors
@@ -2089,6 +2206,9 @@ void Node::setSyncState(MerkleMountainRange<Header> &&headers, const Header &tra
 	// Set rangeproofs to rangeproofs
 	this->rangeproofs = move(rangeproofs);
 	
+	// Set checkpoint snapshot required to true since the kernels, outputs, and rangeproofs were replaced
+	checkpointSnapshotRequired = true;
+	
 	// Check if mempool is enabled
 	#ifdef ENABLE_MEMPOOL
 	
@@ -2120,20 +2240,39 @@ void Node::setSyncState(MerkleMountainRange<Header> &&headers, const Header &tra
 }
 
 // Update sync state
-bool Node::updateSyncState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, const Block &block) {
+bool Node::updateSyncState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, Block &&block) {
 
-	// Set headers to headers
-	this->headers = move(headers);
+	// Replace headers with headers
+	this->headers.replace(move(headers));
 	
 	// Return applying block to sync state
-	return applyBlockToSyncState(syncedHeaderIndex, block);
+	return applyBlockToSyncState(syncedHeaderIndex, move(block));
 }
 
 // Update sync state
-bool Node::updateSyncState(const uint64_t syncedHeaderIndex, const Block &block) {
+bool Node::updateSyncState(const uint64_t syncedHeaderIndex, Block &&block) {
 
 	// Return applying block to sync state
-	return applyBlockToSyncState(syncedHeaderIndex, block);
+	return applyBlockToSyncState(syncedHeaderIndex, move(block));
+}
+
+// Add downloaded block
+void Node::addDownloadedBlock(const uint64_t height, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &blockHash, vector<uint8_t> &&blockMessage, const string &peerIdentifier) {
+
+	// Check if block is in the block download window and wasn't already downloaded
+	if(height > syncedHeaderIndex && height - syncedHeaderIndex <= BLOCK_DOWNLOAD_WINDOW_SIZE && !downloadedBlocks.contains(height)) {
+	
+		// Check if block's header is known
+		const Header *header = headers.getLeaf(height);
+		if(header && header->getBlockHash() == blockHash) {
+		
+			// Add block to the list of downloaded blocks
+			downloadedBlocks.emplace(height, make_tuple(move(blockMessage), blockHash, peerIdentifier));
+			
+			// Remove block from the list of block requests
+			blockRequests.erase(height);
+		}
+	}
 }
 
 // Peer connected
@@ -2284,7 +2423,7 @@ void Node::addToMempool(Transaction &&transaction) {
 					if(input.getFeatures() == Input::Features::SAME_AS_OUTPUT) {
 					
 						// Check if output doesn't exist
-						const vector inputLookupValue = input.getLookupValue();
+						const array inputLookupValue = input.getLookupValue();
 						const Output *output = outputs.getLeafByLookupValue(inputLookupValue);
 						if(!output) {
 						
@@ -2319,13 +2458,13 @@ void Node::addToMempool(Transaction &&transaction) {
 					unordered_set<const Transaction *> replacedTransactions;
 					
 					// Initialize removed outputs
-					unordered_set<vector<uint8_t>, Common::Uint8VectorHash> removedOutputs;
+					unordered_set<array<uint8_t, Crypto::COMMITMENT_LENGTH>, Common::Uint8ArrayHash> removedOutputs;
 			
 					// Go through all of the transaction's outputs
 					for(const Output &output : transaction.getOutputs()) {
 					
 						// Check if output already exists
-						const vector outputLookupValue = output.getLookupValue().value();
+						const array outputLookupValue = output.getLookupValue().value();
 						if(outputs.leafWithLookupValueExists(outputLookupValue)) {
 						
 							// Return
@@ -2353,107 +2492,46 @@ void Node::addToMempool(Transaction &&transaction) {
 					
 					// Check if transaction replaces other transactions
 					if(!replacedTransactions.empty()) {
-					
-						// Go through all of the transaction's outputs
-						for(const Output &output : transaction.getOutputs()) {
 						
-							// Remove output from list of removed outputs
-							removedOutputs.erase(output.getLookupValue().value());
-						}
+						// Initialize pending removed outputs to the removed outputs
+						vector<array<uint8_t, Crypto::COMMITMENT_LENGTH>> pendingRemovedOutputs(removedOutputs.cbegin(), removedOutputs.cend());
 						
-						// Go through all transactions in the mempool
-						unordered_set<vector<uint8_t>, Common::Uint8VectorHash> inputDependencies;
-						for(Mempool::const_iterator i = mempool.cbegin(); i != mempool.cend();) {
+						// Go through all pending removed outputs
+						while(!pendingRemovedOutputs.empty()) {
 						
-							// Get existing transaction
-							const Transaction &existingTransaction = *i;
+							// Get pending removed output
+							const array removedOutput = pendingRemovedOutputs.back();
+							pendingRemovedOutputs.pop_back();
 							
-							// Check if existing transaction isn't already being replaced
-							if(!replacedTransactions.contains(&existingTransaction)) {
+							// Check if removed output doesn't exist and transactions in the mempool spend it
+							const unordered_set<const Transaction *> *spendingTransactions = mempool.getSpendingTransactions(removedOutput);
+							if(!outputs.leafWithLookupValueExists(removedOutput) && spendingTransactions) {
 							
-								// Initialize remove transaction to false
-								bool removeTransaction = false;
-								
-								// Go through all of the existing transactions inputs
-								for(const Input &input : existingTransaction.getInputs()) {
+								// Go through all transactions that spend the removed output
+								for(const Transaction *spendingTransaction : *spendingTransactions) {
 								
-									// Check if output doesn't exist
-									vector inputLookupValue = input.getLookupValue();
-									if(!outputs.leafWithLookupValueExists(inputLookupValue)) {
+									// Check if spending transaction isn't already being replaced
+									if(!replacedTransactions.contains(spendingTransaction)) {
 									
-										// Check if output will be removed
-										if(removedOutputs.contains(inputLookupValue)) {
+										// Add spending transaction's fees to replaced fees
+										replacedFees = SaturateMath::add(replacedFees, spendingTransaction->getFees());
 										
-											// Set remove transaction to true
-											removeTransaction = true;
-											
-											// Break
-											break;
-										}
+										// Add spending transaction to list of transactions to replace
+										replacedTransactions.insert(spendingTransaction);
 										
-										// Add output to input dependencies
-										inputDependencies.insert(move(inputLookupValue));
-									}
-								}
-								
-								// Check if removing transaction
-								if(removeTransaction) {
-								
-									// Add existing transaction's fees to replaced fees
-									replacedFees = SaturateMath::add(replacedFees, existingTransaction.getFees());
-									
-									// Add existing transaction to list of transactions to replace
-									replacedTransactions.insert(&existingTransaction);
-									
-									// Initialize recheck transactions to false
-									bool recheckTransactions = false;
-									
-									// Go through all of the existing transaction's outputs
-									for(const Output &existingOutput : existingTransaction.getOutputs()) {
-									
-										// Check if existing output is the input to another transaction
-										vector outputLookupValue = existingOutput.getLookupValue().value();
-										if(inputDependencies.contains(outputLookupValue)) {
+										// Go through all of the spending transaction's outputs
+										for(const Output &spendingOutput : spendingTransaction->getOutputs()) {
 										
-											// Set recheck transactions to true
-											recheckTransactions = true;
+											// Check if spending output wasn't already removed
+											const array outputLookupValue = spendingOutput.getLookupValue().value();
+											if(removedOutputs.insert(outputLookupValue).second) {
+											
+												// Add spending output to list of pending removed outputs
+												pendingRemovedOutputs.push_back(outputLookupValue);
+											}
 										}
-										
-										// Add existing output to list of removed outputs
-										removedOutputs.insert(move(outputLookupValue));
-									}
-									
-									// Check if rechecking transactions
-									if(recheckTransactions) {
-									
-										// Go to first transaction
-										i = mempool.cbegin();
-										
-										// Clear input dependencies
-										inputDependencies.clear();
-									}
-									
-									// Otherwise
-									else {
-									
-										// Go to next transaction
-										++i;
 									}
 								}
-								
-								// Otherwise
-								else {
-								
-									// Go to next transaction
-									++i;
-								}
-							}
-							
-							// Otherwise
-							else {
-							
-								// Go to next transaction
-								++i;
 							}
 						}
 						
@@ -2465,6 +2543,13 @@ void Node::addToMempool(Transaction &&transaction) {
 						}
 					}
 					
+					// Check if transaction's fee rate is too low for the mempool to evict other transactions for it once the replaced transactions are removed
+					if(mempool.isFeeRateTooLow(transaction, replacedTransactions)) {
+					
+						// Return
+						return;
+					}
+					
 					// Get next header height
 					const uint64_t nextHeaderHeight = SaturateMath::add(syncedHeaderIndex, 1);
 					
@@ -2475,7 +2560,7 @@ void Node::addToMempool(Transaction &&transaction) {
 					for(const Input &input : transaction.getInputs()) {
 					
 						// Check if output doesn't exist
-						const vector inputLookupValue = input.getLookupValue();
+						const array inputLookupValue = input.getLookupValue();
 						const Output *output = outputs.getLeafByLookupValue(inputLookupValue);
 						if(!output) {
 						
@@ -2550,6 +2635,13 @@ void Node::addToMempool(Transaction &&transaction) {
 						}
 					}
 					
+					// Check if transaction would exceed the mempool's ancestor or descendant limits once the replaced transactions are removed
+					if(mempool.exceedsPackageLimits(transaction, replacedTransactions)) {
+					
+						// Return
+						return;
+					}
+					
 					// Check if on transaction added to mempool callback exists
 					if(onTransactionAddedToMempoolCallback) {
 					
@@ -2569,8 +2661,16 @@ void Node::addToMempool(Transaction &&transaction) {
 					// Try
 					try {
 					
-						// Go through all replaced transactions
-						for(const Transaction *replacedTransaction : replacedTransactions) {
+						// Sort replaced transactions so that transactions come after the transactions that spend their outputs
+						vector<const Transaction *> sortedReplacedTransactions(replacedTransactions.cbegin(), replacedTransactions.cend());
+						sort(sortedReplacedTransactions.begin(), sortedReplacedTransactions.end(), [this](const Transaction *firstTransaction, const Transaction *secondTransaction) -> bool {
+						
+							// Return if the first transaction has more ancestors than the second transaction
+							return mempool.getNumberOfAncestors(firstTransaction) > mempool.getNumberOfAncestors(secondTransaction);
+						});
+						
+						// Go through all sorted replaced transactions
+						for(const Transaction *replacedTransaction : sortedReplacedTransactions) {
 						
 							// Check if on transaction removed from mempool callback exists
 							if(onTransactionRemovedFromMempoolCallback) {
@@ -2594,6 +2694,46 @@ void Node::addToMempool(Transaction &&transaction) {
 						
 						// Insert transaction into mempool
 						mempool.insert(move(transaction));
+						
+						// Loop while the mempool is full
+						while(mempool.isFull()) {
+						
+							// Get transaction with the lowest descendant package fee rate and its descendants
+							const Transaction *lowestFeeRateTransaction = get<2>(*mempool.getDescendantPackageFeeRates().crbegin());
+							const unordered_set descendants = mempool.getDescendants(lowestFeeRateTransaction);
+							vector<const Transaction *> evictedTransactions(descendants.cbegin(), descendants.cend());
+							evictedTransactions.push_back(lowestFeeRateTransaction);
+							
+							// Sort evicted transactions so that transactions come after the transactions that spend their outputs
+							sort(evictedTransactions.begin(), evictedTransactions.end(), [this](const Transaction *firstTransaction, const Transaction *secondTransaction) -> bool {
+							
+								// Return if the first transaction has more ancestors than the second transaction
+								return mempool.getNumberOfAncestors(firstTransaction) > mempool.getNumberOfAncestors(secondTransaction);
+							});
+							
+							// Go through all evicted transactions
+							for(const Transaction *evictedTransaction : evictedTransactions) {
+							
+								// Check if on transaction removed from mempool callback exists
+								if(onTransactionRemovedFromMempoolCallback) {
+								
+									// Try
+									try {
+									
+										// Run on transaction removed from mempool callback
+										onTransactionRemovedFromMempoolCallback(*this, *evictedTransaction);
+									}
+									
+									// Catch errors
+									catch(...) {
+									
+									}
+								}
+								
+								// Remove evicted transaction from mempool
+								mempool.erase(*evictedTransaction);
+							}
+						}
 					}
 					
 					// Catch errors
@@ -2677,6 +2817,485 @@ Node::Capabilities Node::getDesiredPeerCapabilities() const {
 	return desiredPeerCapabilities;
 }
 
+// Get number of verification threads
+unsigned int Node::getNumberOfVerificationThreads() const {
+
+	// Return number of verification threads
+	return numberOfVerificationThreads;
+}
+
+// Save state
+void Node::saveState(ofstream &file, const MerkleMountainRange<Header> &headers, const uint64_t syncedHeaderIndex, const MerkleMountainRange<Kernel> &kernels, const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers) {
+
+	// Write state version to file
+	const uint64_t serializedStateVersion = Common::hostByteOrderToBigEndian(STATE_VERSION);
+	file.write(reinterpret_cast<const char *>(&serializedStateVersion), sizeof(serializedStateVersion));
+	
+	// Write headers to file
+	headers.save(file);
+	
+	// Write synced header index to file
+	const uint64_t serializedSyncedHeaderIndex = Common::hostByteOrderToBigEndian(syncedHeaderIndex);
+	file.write(reinterpret_cast<const char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
+	
+	// Write kernels to file
+	kernels.save(file);
+	
+	// Write outputs to file
+	outputs.save(file);
+	
+	// Write rangeproofs to file
+	rangeproofs.save(file);
+	
+	// Write healthy peers size to file
+	const uint64_t serializedHealthyPeersSize = Common::hostByteOrderToBigEndian(healthyPeers.size());
+	file.write(reinterpret_cast<const char *>(&serializedHealthyPeersSize), sizeof(serializedHealthyPeersSize));
+	
+	// Go through all healthy peers
+	for(const pair<const string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeer : healthyPeers) {
+	
+		// Write identifier size to file
+		const uint64_t serializedIdentifierSize = Common::hostByteOrderToBigEndian(healthyPeer.first.size());
+		file.write(reinterpret_cast<const char *>(&serializedIdentifierSize), sizeof(serializedIdentifierSize));
+		
+		// Write identifier to file
+		file.write(healthyPeer.first.data(), healthyPeer.first.size());
+		
+		// Write capabilities to file
+		const uint32_t serializedCapabilities = htonl(static_cast<underlying_type_t<Capabilities>>(healthyPeer.second.second));
+		file.write(reinterpret_cast<const char *>(&serializedCapabilities), sizeof(serializedCapabilities));
+	}
+}
+
+// Restore state
+void Node::restoreState(ifstream &file, MerkleMountainRange<Header> &headers, uint64_t &syncedHeaderIndex, MerkleMountainRange<Kernel> &kernels, MerkleMountainRange<Output> &outputs, MerkleMountainRange<Rangeproof> &rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers) {
+
+	// Read state version from file
+	uint64_t serializedStateVersion;
+	file.read(reinterpret_cast<char *>(&serializedStateVersion), sizeof(serializedStateVersion));
+	const uint64_t stateVersion = Common::bigEndianToHostByteOrder(serializedStateVersion);
+	
+	// Check if state is legacy
+	if(!stateVersion) {
+	
+		// Go back to the start of the legacy state since it begins with the headers' empty lookup table size
+		file.seekg(-static_cast<streamoff>(sizeof(serializedStateVersion)), ios::cur);
+		
+		// Read legacy headers from file
+		headers = MerkleMountainRange<Header>::restoreLegacy(file);
+	}
+	
+	// Otherwise check if state version is supported
+	else if(stateVersion == STATE_VERSION) {
+	
+		// Read headers from file
+		headers = MerkleMountainRange<Header>::restore(file);
+	}
+	
+	// Otherwise
+	else {
+	
+		// Throw exception
+		throw runtime_error("State version isn't supported");
+	}
+	
+	// Read synced header index from file
+	uint64_t serializedSyncedHeaderIndex;
+	file.read(reinterpret_cast<char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
+	syncedHeaderIndex = Common::bigEndianToHostByteOrder(serializedSyncedHeaderIndex);
+	
+	// Read kernels, outputs, and rangeproofs from file
+	kernels = stateVersion ? MerkleMountainRange<Kernel>::restore(file) : MerkleMountainRange<Kernel>::restoreLegacy(file);
+	outputs = stateVersion ? MerkleMountainRange<Output>::restore(file) : MerkleMountainRange<Output>::restoreLegacy(file);
+	rangeproofs = stateVersion ? MerkleMountainRange<Rangeproof>::restore(file) : MerkleMountainRange<Rangeproof>::restoreLegacy(file);
+	
+	// Read healthy peers size from file
+	uint64_t serializedHealthyPeersSize;
+	file.read(reinterpret_cast<char *>(&serializedHealthyPeersSize), sizeof(serializedHealthyPeersSize));
+	const uint64_t healthyPeersSize = Common::bigEndianToHostByteOrder(serializedHealthyPeersSize);
+	
+	// Go through all healthy peers
+	for(uint64_t i = 0; i < healthyPeersSize; ++i) {
+	
+		// Read identifier size from file
+		uint64_t serializedIdentifierSize;
+		file.read(reinterpret_cast<char *>(&serializedIdentifierSize), sizeof(serializedIdentifierSize));
+		
+		// Read identifier from file
+		string identifier(Common::bigEndianToHostByteOrder(serializedIdentifierSize), '\0');
+		file.read(identifier.data(), identifier.size());
+		
+		// Read capabilities from file
+		uint32_t serializedCapabilities;
+		file.read(reinterpret_cast<char *>(&serializedCapabilities), sizeof(serializedCapabilities));
+		
+		// Add healthy peer to healthy peers
+		healthyPeers.emplace(move(identifier), make_pair(chrono::steady_clock::now(), static_cast<Capabilities>(ntohl(serializedCapabilities))));
+	}
+}
+
+// Save file atomically
+void Node::saveFileAtomically(const string &fileName, const function<void(ofstream &file)> &writeFile) {
+
+	// Get temporary file name
+	const string temporaryFileName = fileName + ".tmp";
+	
+	{
+		// Set temporary file to throw exception on error
+		ofstream temporaryFile;
+		temporaryFile.exceptions(ios::badbit | ios::failbit);
+		
+		// Open temporary file
+		temporaryFile.open(temporaryFileName, ios::binary | ios::trunc);
+		
+		// Write temporary file
+		writeFile(temporaryFile);
+		
+		// Close temporary file
+		temporaryFile.close();
+	}
+	
+	// Check if not Windows
+	#ifndef _WIN32
+	
+		// Check if opening temporary file failed
+		const int temporaryFile = open(temporaryFileName.c_str(), O_RDONLY);
+		if(temporaryFile == -1) {
+		
+			// Throw exception
+			throw runtime_error("Opening temporary file failed");
+		}
+		
+		// Check if synchronizing temporary file to disk failed
+		if(fsync(temporaryFile)) {
+		
+			// Close temporary file
+			close(temporaryFile);
+			
+			// Throw exception
+			throw runtime_error("Synchronizing temporary file to disk failed");
+		}
+		
+		// Close temporary file
+		close(temporaryFile);
+	#endif
+	
+	// Replace file with the temporary file
+	filesystem::rename(temporaryFileName, fileName);
+}
+
+// Get checkpoint delta file name
+string Node::getCheckpointDeltaFileName(const string &checkpointFile, const uint64_t checkpointDeltaNumber) {
+
+	// Return checkpoint delta file name
+	return checkpointFile + '.' + to_string(checkpointDeltaNumber);
+}
+
+// Restore checkpoint state
+optional<uint64_t> Node::restoreCheckpointState(const string &checkpointFile, MerkleMountainRange<Header> &headers, uint64_t &syncedHeaderIndex, MerkleMountainRange<Kernel> &kernels, MerkleMountainRange<Output> &outputs, MerkleMountainRange<Rangeproof> &rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers, uint64_t &numberOfCheckpointDeltas) {
+
+	// Set file to throw exception on error
+	ifstream file;
+	file.exceptions(ios::badbit | ios::failbit);
+	
+	// Open file
+	file.open(checkpointFile, ios::binary);
+	
+	// Read state from file
+	restoreState(file, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, healthyPeers);
+	
+	// Set number of checkpoint deltas to zero
+	numberOfCheckpointDeltas = 0;
+	
+	// Check if file doesn't have a checkpoint identifier
+	if(file.peek() == ifstream::traits_type::eof()) {
+	
+		// Return nothing
+		return nullopt;
+	}
+	
+	// Read checkpoint identifier from file
+	uint64_t serializedCheckpointIdentifier;
+	file.read(reinterpret_cast<char *>(&serializedCheckpointIdentifier), sizeof(serializedCheckpointIdentifier));
+	const uint64_t checkpointIdentifier = Common::bigEndianToHostByteOrder(serializedCheckpointIdentifier);
+	
+	// Close file
+	file.close();
+	
+	// Loop through all checkpoint deltas
+	for(;; ++numberOfCheckpointDeltas) {
+	
+		// Check if checkpoint delta file doesn't exist
+		ifstream deltaFile(getCheckpointDeltaFileName(checkpointFile, numberOfCheckpointDeltas + 1), ios::binary);
+		if(!deltaFile.is_open()) {
+		
+			// Break
+			break;
+		}
+		
+		// Set checkpoint delta file to throw exception on error
+		deltaFile.exceptions(ios::badbit | ios::failbit);
+		
+		// Check if checkpoint delta is for a different checkpoint
+		uint64_t serializedDeltaCheckpointIdentifier;
+		deltaFile.read(reinterpret_cast<char *>(&serializedDeltaCheckpointIdentifier), sizeof(serializedDeltaCheckpointIdentifier));
+		if(Common::bigEndianToHostByteOrder(serializedDeltaCheckpointIdentifier) != checkpointIdentifier) {
+		
+			// Break
+			break;
+		}
+		
+		// Read synced header index from checkpoint delta file
+		uint64_t serializedSyncedHeaderIndex;
+		deltaFile.read(reinterpret_cast<char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
+		syncedHeaderIndex = Common::bigEndianToHostByteOrder(serializedSyncedHeaderIndex);
+		
+		// Apply headers journal from checkpoint delta file
+		headers.applyJournal(deltaFile);
+		
+		// Apply kernels journal from checkpoint delta file
+		kernels.applyJournal(deltaFile);
+		
+		// Apply outputs journal from checkpoint delta file
+		outputs.applyJournal(deltaFile);
+		
+		// Apply rangeproofs journal from checkpoint delta file
+		rangeproofs.applyJournal(deltaFile);
+	}
+	
+	// Return checkpoint identifier
+	return checkpointIdentifier;
+}
+
+// Save checkpoint snapshot
+void Node::saveCheckpointSnapshot(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t previousNumberOfCheckpointDeltas, const MerkleMountainRange<Header> &headers, const uint64_t syncedHeaderIndex, const MerkleMountainRange<Kernel> &kernels, const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers) {
+
+	// Save checkpoint file atomically
+	saveFileAtomically(checkpointFile, [&](ofstream &file) -> void {
+	
+		// Write state to file
+		saveState(file, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, healthyPeers);
+		
+		// Write checkpoint identifier to file
+		const uint64_t serializedCheckpointIdentifier = Common::hostByteOrderToBigEndian(checkpointIdentifier);
+		file.write(reinterpret_cast<const char *>(&serializedCheckpointIdentifier), sizeof(serializedCheckpointIdentifier));
+	});
+	
+	// Go through all previous checkpoint deltas
+	for(uint64_t i = 1; i <= previousNumberOfCheckpointDeltas; ++i) {
+	
+		// Remove previous checkpoint delta file since it's included in the snapshot
+		error_code errorCode;
+		filesystem::remove(getCheckpointDeltaFileName(checkpointFile, i), errorCode);
+	}
+}
+
+// Save checkpoint delta
+void Node::saveCheckpointDelta(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t checkpointDeltaNumber, const uint64_t syncedHeaderIndex, const vector<MerkleMountainRange<Header>::JournalEntry> &headersJournal, const vector<MerkleMountainRange<Kernel>::JournalEntry> &kernelsJournal, const vector<MerkleMountainRange<Output>::JournalEntry> &outputsJournal, const vector<MerkleMountainRange<Rangeproof>::JournalEntry> &rangeproofsJournal) {
+
+	// Save checkpoint delta file atomically
+	saveFileAtomically(getCheckpointDeltaFileName(checkpointFile, checkpointDeltaNumber), [&](ofstream &file) -> void {
+	
+		// Write checkpoint identifier to file
+		const uint64_t serializedCheckpointIdentifier = Common::hostByteOrderToBigEndian(checkpointIdentifier);
+		file.write(reinterpret_cast<const char *>(&serializedCheckpointIdentifier), sizeof(serializedCheckpointIdentifier));
+		
+		// Write synced header index to file
+		const uint64_t serializedSyncedHeaderIndex = Common::hostByteOrderToBigEndian(syncedHeaderIndex);
+		file.write(reinterpret_cast<const char *>(&serializedSyncedHeaderIndex), sizeof(serializedSyncedHeaderIndex));
+		
+		// Write headers journal to file
+		MerkleMountainRange<Header>::saveJournal(headersJournal, file);
+		
+		// Write kernels journal to file
+		MerkleMountainRange<Kernel>::saveJournal(kernelsJournal, file);
+		
+		// Write outputs journal to file
+		MerkleMountainRange<Output>::saveJournal(outputsJournal, file);
+		
+		// Write rangeproofs journal to file
+		MerkleMountainRange<Rangeproof>::saveJournal(rangeproofsJournal, file);
+	});
+}
+
+// Compact checkpoint
+void Node::compactCheckpoint(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t numberOfCheckpointDeltas, const uint64_t newCheckpointIdentifier, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers) {
+
+	// Read checkpoint's snapshot and deltas
+	MerkleMountainRange<Header> headers;
+	uint64_t syncedHeaderIndex;
+	MerkleMountainRange<Kernel> kernels;
+	MerkleMountainRange<Output> outputs;
+	MerkleMountainRange<Rangeproof> rangeproofs;
+	unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> savedHealthyPeers;
+	uint64_t savedNumberOfCheckpointDeltas;
+	const optional<uint64_t> savedCheckpointIdentifier = restoreCheckpointState(checkpointFile, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, savedHealthyPeers, savedNumberOfCheckpointDeltas);
+	
+	// Check if the saved checkpoint isn't the checkpoint or is missing deltas
+	if(savedCheckpointIdentifier != checkpointIdentifier || savedNumberOfCheckpointDeltas != numberOfCheckpointDeltas) {
+	
+		// Throw exception
+		throw runtime_error("Saved checkpoint is incomplete");
+	}
+	
+	// Save checkpoint snapshot with the new identifier
+	saveCheckpointSnapshot(checkpointFile, newCheckpointIdentifier, numberOfCheckpointDeltas, headers, syncedHeaderIndex, kernels, outputs, rangeproofs, healthyPeers);
+}
+
+// Set restored state
+void Node::setRestoredState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, MerkleMountainRange<Kernel> &&kernels, MerkleMountainRange<Output> &&outputs, MerkleMountainRange<Rangeproof> &&rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &&healthyPeers) {
+
+	// Set headers to the headers
+	this->headers = move(headers);
+	
+	// Set synced header index to the synced header index
+	this->syncedHeaderIndex = syncedHeaderIndex;
+	
+	// Set kernels to the kernels
+	this->kernels = move(kernels);
+	
+	// Set outputs to the outputs
+	this->outputs = move(outputs);
+	
+	// Set rangeproofs to the rangeproofs
+	this->rangeproofs = move(rangeproofs);
+	
+	// Add healthy peers to the healthy peers
+	this->healthyPeers.merge(healthyPeers);
+	
+	// Go through all healthy peers
+	for(const pair<const string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeer : this->healthyPeers) {
+	
+		// Add healthy peer to unused peer candidates
+		unusedPeerCandidates.emplace(healthyPeer.first, chrono::steady_clock::now());
+	}
+}
+
+// Create checkpoint
+void Node::createCheckpoint() {
+
+	// Check if the previous checkpoint is being saved
+	if(checkpointSaver.valid()) {
+	
+		// Check if the previous checkpoint is still being saved
+		if(checkpointSaver.wait_for(0s) != future_status::ready) {
+		
+			// Return
+			return;
+		}
+		
+		// Try
+		try {
+		
+			// Get if saving the previous checkpoint failed
+			checkpointSaver.get();
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+			// Set checkpoint snapshot required to true since the checkpoint deltas are incomplete
+			checkpointSnapshotRequired = true;
+			
+			// Throw
+			throw;
+		}
+	}
+	
+	// Lock for reading since writers are the only other users of the journals and they require the lock for writing
+	shared_lock readLock(lock);
+	
+	// Check if a checkpoint snapshot is required or the changes to the state weren't recorded
+	if(checkpointSnapshotRequired || !headers.isJournalStarted() || !kernels.isJournalStarted() || !outputs.isJournalStarted() || !rangeproofs.isJournalStarted()) {
+	
+		// Get snapshot of the state
+		MerkleMountainRange<Header> headersSnapshot(headers);
+		const uint64_t syncedHeaderIndexSnapshot = syncedHeaderIndex;
+		MerkleMountainRange<Kernel> kernelsSnapshot(kernels);
+		MerkleMountainRange<Output> outputsSnapshot(outputs);
+		MerkleMountainRange<Rangeproof> rangeproofsSnapshot(rangeproofs);
+		unordered_map healthyPeersSnapshot(healthyPeers);
+		
+		// Start headers, kernels, outputs, and rangeproofs journals so that the next checkpoint delta starts from the snapshot
+		headers.startJournal();
+		kernels.startJournal();
+		outputs.startJournal();
+		rangeproofs.startJournal();
+		
+		// Unlock read lock
+		readLock.unlock();
+		
+		// Set checkpoint snapshot required to true in case saving the snapshot can't be started
+		checkpointSnapshotRequired = true;
+		
+		// Save checkpoint snapshot with a new identifier in a separate thread
+		const uint64_t newCheckpointIdentifier = randomNumberGenerator();
+		checkpointSaver = async(launch::async, &Node::saveCheckpointSnapshot, checkpointFile, newCheckpointIdentifier, numberOfCheckpointDeltas, move(headersSnapshot), syncedHeaderIndexSnapshot, move(kernelsSnapshot), move(outputsSnapshot), move(rangeproofsSnapshot), move(healthyPeersSnapshot));
+		
+		// Set checkpoint identifier to the new checkpoint identifier
+		checkpointIdentifier = newCheckpointIdentifier;
+		
+		// Set number of checkpoint deltas to zero
+		numberOfCheckpointDeltas = 0;
+	}
+	
+	// Otherwise
+	else {
+	
+		// Get changes to the state since the previous checkpoint
+		vector headersJournal = headers.takeJournal();
+		const uint64_t syncedHeaderIndexSnapshot = syncedHeaderIndex;
+		vector kernelsJournal = kernels.takeJournal();
+		vector outputsJournal = outputs.takeJournal();
+		vector rangeproofsJournal = rangeproofs.takeJournal();
+		unordered_map healthyPeersSnapshot(healthyPeers);
+		
+		// Unlock read lock
+		readLock.unlock();
+		
+		// Set checkpoint snapshot required to true in case saving the checkpoint delta can't be started
+		checkpointSnapshotRequired = true;
+		
+		// Check if the checkpoint should be compacted into a new snapshot after saving the checkpoint delta
+		const bool compact = numberOfCheckpointDeltas + 1 >= MAXIMUM_NUMBER_OF_CHECKPOINT_DELTAS;
+		const uint64_t newCheckpointIdentifier = compact ? randomNumberGenerator() : checkpointIdentifier;
+		
+		// Save checkpoint delta and compact the checkpoint from the saved files in a separate thread so that the state isn't copied
+		checkpointSaver = async(launch::async, [checkpointFile = checkpointFile, checkpointIdentifier = checkpointIdentifier, checkpointDeltaNumber = numberOfCheckpointDeltas + 1, syncedHeaderIndexSnapshot, headersJournal = move(headersJournal), kernelsJournal = move(kernelsJournal), outputsJournal = move(outputsJournal), rangeproofsJournal = move(rangeproofsJournal), compact, newCheckpointIdentifier, healthyPeersSnapshot = move(healthyPeersSnapshot)]() -> void {
+		
+			// Save checkpoint delta
+			saveCheckpointDelta(checkpointFile, checkpointIdentifier, checkpointDeltaNumber, syncedHeaderIndexSnapshot, headersJournal, kernelsJournal, outputsJournal, rangeproofsJournal);
+			
+			// Check if compacting the checkpoint
+			if(compact) {
+			
+				// Compact checkpoint
+				compactCheckpoint(checkpointFile, checkpointIdentifier, checkpointDeltaNumber, newCheckpointIdentifier, healthyPeersSnapshot);
+			}
+		});
+		
+		// Check if compacting the checkpoint
+		if(compact) {
+		
+			// Set checkpoint identifier to the new checkpoint identifier
+			checkpointIdentifier = newCheckpointIdentifier;
+			
+			// Set number of checkpoint deltas to zero
+			numberOfCheckpointDeltas = 0;
+		}
+		
+		// Otherwise
+		else {
+		
+			// Increment number of checkpoint deltas
+			++numberOfCheckpointDeltas;
+		}
+	}
+	
+	// Set checkpoint snapshot required to false
+	checkpointSnapshotRequired = false;
+}
+
 // Cleanup mempool
 void Node::cleanupMempool() {
 
@@ -2695,6 +3314,9 @@ void Node::cleanupMempool() {
 				// Get unspendable coinbase outputs starting index at the next header's height
 				const uint64_t unspendableCoinbaseOutputsStartingIndex = MerkleMountainRange<Header>::getNumberOfLeavesAtSize(headers.getLeaf(SaturateMath::subtract(nextHeaderHeight, Consensus::COINBASE_MATURITY))->getOutputMerkleMountainRangeSize());
 				
+				// Initialize removed outputs
+				vector<array<uint8_t, Crypto::COMMITMENT_LENGTH>> removedOutputs;
+				
 				// Go through all transactions in the mempool
 				for(Mempool::const_iterator i = mempool.cbegin(); i != mempool.cend();) {
 				
@@ -2725,7 +3347,7 @@ void Node::cleanupMempool() {
 						for(const Input &input : transaction.getInputs()) {
 						
 							// Check if output doesn't exist
-							const vector inputLookupValue = input.getLookupValue();
+							const array inputLookupValue = input.getLookupValue();
 							const Output *output = outputs.getLeafByLookupValue(inputLookupValue);
 							if(!output) {
 							
@@ -2840,6 +3462,13 @@ void Node::cleanupMempool() {
 							}
 						}
 						
+						// Go through all of the transaction's outputs
+						for(const Output &output : transaction.getOutputs()) {
+						
+							// Add output to list of removed outputs
+							removedOutputs.push_back(output.getLookupValue().value());
+						}
+						
 						// Remove transaction from mempool and go to next transaction
 						i = mempool.erase(i);
 					}
@@ -2852,105 +3481,50 @@ void Node::cleanupMempool() {
 					}
 				}
 				
-				// Go through all transactions in the mempool
-				unordered_set<vector<uint8_t>, Common::Uint8VectorHash> inputDependencies;
-				for(Mempool::const_iterator i = mempool.cbegin(); i != mempool.cend();) {
+				// Go through all outputs of removed transactions
+				while(!removedOutputs.empty()) {
 				
-					// Get transaction
-					const Transaction &transaction = *i;
-					
-					// Initialize remove transaction to false
-					bool removeTransaction = false;
+					// Get removed output
+					const array removedOutput = removedOutputs.back();
+					removedOutputs.pop_back();
 					
-					// Go through all of the transaction's inputs
-					for(const Input &input : transaction.getInputs()) {
+					// Check if removed output doesn't exist and transactions in the mempool spend it
+					const unordered_set<const Transaction *> *spendingTransactions = mempool.getSpendingTransactions(removedOutput);
+					if(!outputs.leafWithLookupValueExists(removedOutput) && spendingTransactions) {
 					
-						// Check if output doesn't exist
-						vector inputLookupValue = input.getLookupValue();
-						if(!outputs.leafWithLookupValueExists(inputLookupValue)) {
+						// Copy spending transactions since removing them from the mempool changes its spending transactions
+						const unordered_set<const Transaction *> removedTransactions = *spendingTransactions;
 						
-							// Check if output doesn't exist in the mempool
-							if(!mempool.getOutput(inputLookupValue)) {
+						// Go through all transactions that spend the removed output
+						for(const Transaction *removedTransaction : removedTransactions) {
 						
-								// Set remove transaction to true
-								removeTransaction = true;
-								
-								// Break
-								break;
-							}
-							
-							// Otherwise
-							else {
+							// Go through all of the removed transaction's outputs
+							for(const Output &output : removedTransaction->getOutputs()) {
 							
-								// Add output to input dependencies
-								inputDependencies.insert(move(inputLookupValue));
+								// Add output to list of removed outputs
+								removedOutputs.push_back(output.getLookupValue().value());
 							}
-						}
-					}
-					
-					// Check if removing transaction
-					if(removeTransaction) {
-					
-						// Initialize recheck transactions to false
-						bool recheckTransactions = false;
-						
-						// Go through all of the transaction's outputs
-						for(const Output &output : transaction.getOutputs()) {
-						
-							// Check if output is the input to another transaction
-							if(inputDependencies.contains(output.getLookupValue().value())) {
 							
-								// Set recheck transactions to true
-								recheckTransactions = true;
-								
-								// Break
-								break;
-							}
-						}
-						
-						// Check if on transaction removed from mempool callback exists
-						if(onTransactionRemovedFromMempoolCallback) {
-						
-							// Try
-							try {
+							// Check if on transaction removed from mempool callback exists
+							if(onTransactionRemovedFromMempoolCallback) {
 							
-								// Run on transaction removed from mempool callback
-								onTransactionRemovedFromMempoolCallback(*this, *i);
+								// Try
+								try {
+								
+									// Run on transaction removed from mempool callback
+									onTransactionRemovedFromMempoolCallback(*this, *removedTransaction);
+								}
+								
+								// Catch errors
+								catch(...) {
+								
+								}
 							}
 							
-							// Catch errors
-							catch(...) {
-							
-							}
-						}
-						
-						// Check if rechecking transactions
-						if(recheckTransactions) {
-						
 							// Remove transaction from mempool
-							mempool.erase(i);
-							
-							// Go to the first transaction
-							i = mempool.cbegin();
-							
-							// Clear input dependencies
-							inputDependencies.clear();
-						}
-						
-						// Otherwise
-						else {
-						
-							// Remove transaction from mempool and go to next transaction
-							i = mempool.erase(i);
+							mempool.erase(*removedTransaction);
 						}
 					}
-					
-					// Otherwise
-					else {
-					
-						// Go to next transaction
-						++i;
-					}
 				}
 			}
 			
@@ -2985,7 +3559,7 @@ void Node::cleanupMempool() {
 }
 
 // Apply block to sync state
-bool Node::applyBlockToSyncState(const uint64_t syncedHeaderIndex, const Block &block) {
+bool Node::applyBlockToSyncState(const uint64_t syncedHeaderIndex, Block &&block) {
 
 	// Save old synced header index
 	const uint64_t oldSyncedHeaderIndex = this->syncedHeaderIndex;
@@ -3008,7 +3582,7 @@ bool Node::applyBlockToSyncState(const uint64_t syncedHeaderIndex, const Block &
 		rangeproofs.rewindToSize(headers.getLeaf(syncedHeaderIndex - 1)->getOutputMerkleMountainRangeSize());
 		
 		// Go through all of the block's outputs
-		for(const Output &output : block.getOutputs()) {
+		for(Output &output : block.outputs) {
 		
 			// Check if output already exists
 			if(outputs.getLeafByLookupValue(output.getLookupValue().value())) {
@@ -3019,16 +3593,38 @@ bool Node::applyBlockToSyncState(const uint64_t syncedHeaderIndex, const Block &
 				// Throw exception
 				throw runtime_error("Output already exists");
 			}
-		
-			// Append output to outputs
-			outputs.appendLeaf(output);
+			
+			// Check if on block callback exists
+			if(onBlockCallback) {
+			
+				// Append output to outputs
+				outputs.appendLeaf(output);
+			}
+			
+			// Otherwise
+			else {
+			
+				// Append output to outputs without copying it since the block isn't used afterwards
+				outputs.appendLeaf(move(output));
+			}
 		}
 		
 		// Go through all of the block's rangeproofs
-		for(const Rangeproof &rangeproof : block.getRangeproofs()) {
+		for(Rangeproof &rangeproof : block.rangeproofs) {
 		
-			// Append rangeproof to rangeproofs
-			rangeproofs.appendLeaf(rangeproof);
+			// Check if on block callback exists
+			if(onBlockCallback) {
+			
+				// Append rangeproof to rangeproofs
+				rangeproofs.appendLeaf(rangeproof);
+			}
+			
+			// Otherwise
+			else {
+			
+				// Append rangeproof to rangeproofs without copying it since the block isn't used afterwards
+				rangeproofs.appendLeaf(move(rangeproof));
+			}
 			
 			// Check if pruning rangeproofs
 			#ifdef PRUNE_RANGEPROOFS
@@ -3137,12 +3733,23 @@ bool Node::applyBlockToSyncState(const uint64_t syncedHeaderIndex, const Block &
 		}
 		
 		// Go through all of the block's kernels
-		for(const Kernel &kernel : block.getKernels()) {
+		for(Kernel &kernel : block.kernels) {
 		
 			// TODO NRD check for floonet
 		
-			// Append kernel to kernels
-			kernels.appendLeaf(kernel);
+			// Check if on block callback exists
+			if(onBlockCallback) {
+			
+				// Append kernel to kernels
+				kernels.appendLeaf(kernel);
+			}
+			
+			// Otherwise
+			else {
+			
+				// Append kernel to kernels without copying it since the block isn't used afterwards
+				kernels.appendLeaf(move(kernel));
+			}
 			
 			// Check if pruning kernels
 			#ifdef PRUNE_KERNELS
@@ -3426,6 +4033,9 @@ void Node::monitor() {
 		// Set last banned peers cleanup time to now
 		chrono::time_point lastBannedPeersCleanupTime = chrono::steady_clock::now();
 		
+		// Set last checkpoint time to now
+		chrono::time_point lastCheckpointTime = chrono::steady_clock::now();
+		
 		// Loop while not stopping monitoring and not closing
 		while(!stopMonitoring.load() && !Common::isClosing()) {
 		
@@ -3552,6 +4162,16 @@ void Node::monitor() {
 				lastBannedPeersCleanupTime = chrono::steady_clock::now();
 			}
 			
+			// Check if using a checkpoint file and time to create a checkpoint
+			if(!checkpointFile.empty() && chrono::steady_clock::now() - lastCheckpointTime >= CHECKPOINT_INTERVAL) {
+			
+				// Create checkpoint
+				createCheckpoint();
+				
+				// Set last checkpoint time to now
+				lastCheckpointTime = chrono::steady_clock::now();
+			}
+			
 			// Wait for a peer event to occur
 			mutex peerEventOccurredMutex;
 			unique_lock peerEventOccurredLock(peerEventOccurredMutex);
@@ -3567,6 +4187,27 @@ void Node::monitor() {
 		Common::setClosing();
 	}
 	
+	// Check if a checkpoint is being saved
+	if(checkpointSaver.valid()) {
+	
+		// Try
+		try {
+		
+			// Wait for the checkpoint to be saved
+			checkpointSaver.get();
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+			// Set checkpoint snapshot required to true since the checkpoint deltas are incomplete
+			checkpointSnapshotRequired = true;
+			
+			// Set closing so that the failure is reported
+			Common::setClosing();
+		}
+	}
+	
 	// Check if is listening
 	if(isListening()) {
 	
@@ -3886,6 +4527,9 @@ void Node::removeDisconnectedPeers() {
 				// Remove peer from the list of currently used peer candidates
 				currentlyUsedPeerCandidates.erase(peer.getIdentifier());
 			}
+			
+			// Cancel peer's block downloads
+			cancelBlockDownloads(peer.getIdentifier());
 		}
 		
 		// Check if syncing peer was disconnected
@@ -3931,8 +4575,8 @@ void Node::removeDisconnectedPeers() {
 				// Check if performing initial sync and the peer obtained new headers
 				if(syncedHeaderIndex == Consensus::GENESIS_BLOCK_HEADER.getHeight() && !peer.getHeaders().empty() && peer.getHeaders().back().getHeight() > syncedHeaderIndex) {
 				
-					// Set headers to peer's headers
-					headers = move(peer.getHeaders());
+					// Replace headers with peer's headers
+					headers.replace(move(peer.getHeaders()));
 				}
 			}
 			
@@ -4053,6 +4697,9 @@ void Node::removeRandomPeer() {
 				// Remove peer from the list of currently used peer candidates
 				currentlyUsedPeerCandidates.erase(peer->getIdentifier());
 			}
+			
+			// Cancel peer's block downloads
+			cancelBlockDownloads(peer->getIdentifier());
 		}
 		
 		// Check if syncing peer was disconnected
@@ -4098,8 +4745,8 @@ void Node::removeRandomPeer() {
 				// Check if performing initial sync and the peer obtained new headers
 				if(syncedHeaderIndex == Consensus::GENESIS_BLOCK_HEADER.getHeight() && !peer->getHeaders().empty() && peer->getHeaders().back().getHeight() > syncedHeaderIndex) {
 				
-					// Set headers to peer's headers
-					headers = move(peer->getHeaders());
+					// Replace headers with peer's headers
+					headers.replace(move(peer->getHeaders()));
 				}
 			}
 			
@@ -4453,6 +5100,9 @@ void Node::sync() {
 	// Lock for writing
 	lock_guard writeLock(lock);
 	
+	// Request blocks
+	requestBlocks();
+	
 	// Check if not already syncing
 	if(!isSyncing) {
 	
@@ -4489,6 +5139,12 @@ void Node::sync() {
 		
 			// Initialize syncable peers
 			vector<Peer *> syncablePeers;
+			
+			// Get the next block if it was downloaded
+			const map<uint64_t, tuple<vector<uint8_t>, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string>>::iterator downloadedBlock = downloadedBlocks.find(syncedHeaderIndex + 1);
+			
+			// Initialize downloaded block peer
+			Peer *downloadedBlockPeer = nullptr;
 		
 			// Go through all peers
 			peerIndex = 0;
@@ -4500,8 +5156,15 @@ void Node::sync() {
 				// Check if peer is connected and healthy
 				if(peer.getConnectionState() == Peer::ConnectionState::CONNECTED_AND_HEALTHY) {
 				
-					// Check if peer has the highest total difficulty and its message queue isn't full
-					if(peer.getTotalDifficulty() == highestTotalDifficulty && !peer.isMessageQueueFull()) {
+					// Check if peer downloaded the next block and isn't syncing
+					if(downloadedBlock != downloadedBlocks.end() && peer.getIdentifier() == get<2>(downloadedBlock->second) && peer.getSyncingState() == Peer::SyncingState::NOT_SYNCING) {
+					
+						// Set downloaded block peer to the peer
+						downloadedBlockPeer = &peer;
+					}
+					
+					// Otherwise check if peer has the highest total difficulty and its message queue isn't full
+					else if(peer.getTotalDifficulty() == highestTotalDifficulty && !peer.isMessageQueueFull()) {
 					
 						// Add peer to list or syncable peers
 						syncablePeers.push_back(&peer);
@@ -4523,15 +5186,49 @@ void Node::sync() {
 				}
 			}
 			
-			// Check if a syncable peer exists
-			if(!syncablePeers.empty()) {
+			// Set syncing started to false
+			bool syncingStarted = false;
+			
+			// Check if the peer that downloaded the next block can process it
+			if(downloadedBlockPeer) {
+			
+				// Start syncing with the peer using the downloaded block
+				downloadedBlockPeer->startSyncing(syncedHeaderIndex, move(get<0>(downloadedBlock->second)));
+				
+				// Remove block from the list of downloaded blocks
+				downloadedBlocks.erase(downloadedBlock);
+				
+				// Set syncing started to true
+				syncingStarted = true;
+			}
+			
+			// Otherwise
+			else {
 			
-				// Set peer distribution
-				uniform_int_distribution<vector<Peer *>::size_type> peerDistribution(0, syncablePeers.size() - 1);
+				// Check if the next block was downloaded
+				if(downloadedBlock != downloadedBlocks.end()) {
+				
+					// Remove block from the list of downloaded blocks since the peer that downloaded it can't process it
+					downloadedBlocks.erase(downloadedBlock);
+				}
 				
-				// Start syncing with a random syncable peer
-				syncablePeers[peerDistribution(randomNumberGenerator)]->startSyncing(headers, syncedHeaderIndex);
+				// Check if a syncable peer exists and the next block isn't being downloaded
+				if(!syncablePeers.empty() && !blockRequests.contains(syncedHeaderIndex + 1)) {
 				
+					// Set peer distribution
+					uniform_int_distribution<vector<Peer *>::size_type> peerDistribution(0, syncablePeers.size() - 1);
+					
+					// Start syncing with a random syncable peer
+					syncablePeers[peerDistribution(randomNumberGenerator)]->startSyncing(headers, syncedHeaderIndex);
+					
+					// Set syncing started to true
+					syncingStarted = true;
+				}
+			}
+			
+			// Check if syncing started
+			if(syncingStarted) {
+			
 				// Set is syncing to true
 				isSyncing = true;
 				
@@ -4607,6 +5304,189 @@ void Node::sync() {
 	}
 }
 
+// Request blocks
+void Node::requestBlocks() {
+
+	// Go through all block requests
+	for(map<uint64_t, tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string, chrono::time_point<chrono::steady_clock>>>::iterator i = blockRequests.begin(); i != blockRequests.end();) {
+	
+		// Get block's header
+		const Header *header = (i->first > syncedHeaderIndex) ? headers.getLeaf(i->first) : nullptr;
+		
+		// Check if block is already synced, its header changed, or its request timed out
+		if(!header || header->getBlockHash() != get<0>(i->second) || chrono::steady_clock::now() - get<2>(i->second) > BLOCK_REQUEST_TIMEOUT) {
+		
+			// Remove block from the list of block requests
+			i = blockRequests.erase(i);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Go to next block request
+			++i;
+		}
+	}
+	
+	// Go through all downloaded blocks
+	for(map<uint64_t, tuple<vector<uint8_t>, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string>>::iterator i = downloadedBlocks.begin(); i != downloadedBlocks.end();) {
+	
+		// Get block's header
+		const Header *header = (i->first > syncedHeaderIndex) ? headers.getLeaf(i->first) : nullptr;
+		
+		// Check if block is already synced or its header changed
+		if(!header || header->getBlockHash() != get<1>(i->second)) {
+		
+			// Remove block from the list of downloaded blocks
+			i = downloadedBlocks.erase(i);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Go to next downloaded block
+			++i;
+		}
+	}
+	
+	// Check if no blocks can be requested or the transaction hash set is needed
+	if(headers.back().getHeight() <= syncedHeaderIndex || headers.back().getHeight() - syncedHeaderIndex > Consensus::CUT_THROUGH_HORIZON) {
+	
+		// Return
+		return;
+	}
+	
+	// Initialize number of block requests per peer
+	unordered_map<string, uint64_t> numberOfBlockRequestsPerPeer;
+	
+	// Go through all block requests
+	for(const pair<const uint64_t, tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string, chrono::time_point<chrono::steady_clock>>> &blockRequest : blockRequests) {
+	
+		// Increment the number of block requests for the block request's peer
+		++numberOfBlockRequestsPerPeer[get<1>(blockRequest.second)];
+	}
+	
+	// Initialize downloading peers
+	vector<pair<Peer *, unique_lock<shared_mutex>>> downloadingPeers;
+	
+	// Go through all peers
+	for(Peer &peer : peers) {
+	
+		// Lock peer for writing
+		unique_lock peerWriteLock(peer.getLock());
+		
+		// Check if peer is connected and healthy, isn't syncing, and has capacity for more block requests
+		if(peer.getConnectionState() == Peer::ConnectionState::CONNECTED_AND_HEALTHY && peer.getSyncingState() == Peer::SyncingState::NOT_SYNCING && !peer.isMessageQueueFull() && numberOfBlockRequestsPerPeer[peer.getIdentifier()] < MAXIMUM_NUMBER_OF_BLOCK_REQUESTS_PER_PEER) {
+		
+			// Add peer to the list of downloading peers
+			downloadingPeers.emplace_back(&peer, move(peerWriteLock));
+		}
+	}
+	
+	// Go through all blocks in the block download window
+	for(uint64_t height = syncedHeaderIndex + 1; height <= headers.back().getHeight() && height - syncedHeaderIndex <= BLOCK_DOWNLOAD_WINDOW_SIZE && !downloadingPeers.empty(); ++height) {
+	
+		// Check if block isn't downloaded or being downloaded
+		if(!downloadedBlocks.contains(height) && !blockRequests.contains(height)) {
+		
+			// Get block's header
+			const Header *header = headers.getLeaf(height);
+			
+			// Initialize least busy peer
+			Peer *leastBusyPeer = nullptr;
+			
+			// Go through all downloading peers
+			for(const pair<Peer *, unique_lock<shared_mutex>> &downloadingPeer : downloadingPeers) {
+			
+				// Check if peer has the block and is less busy than the least busy peer
+				if(downloadingPeer.first->getTotalDifficulty() >= header->getTotalDifficulty() && (!leastBusyPeer || numberOfBlockRequestsPerPeer[downloadingPeer.first->getIdentifier()] < numberOfBlockRequestsPerPeer[leastBusyPeer->getIdentifier()])) {
+				
+					// Set least busy peer to the peer
+					leastBusyPeer = downloadingPeer.first;
+				}
+			}
+			
+			// Check if no peers have the block
+			if(!leastBusyPeer) {
+			
+				// Break
+				break;
+			}
+			
+			// Request block from the least busy peer
+			const bool blockRequested = leastBusyPeer->requestBlock(height, header->getBlockHash());
+			
+			// Check if block was requested
+			if(blockRequested) {
+			
+				// Add block to the list of block requests
+				blockRequests.emplace(height, make_tuple(header->getBlockHash(), leastBusyPeer->getIdentifier(), chrono::steady_clock::now()));
+				
+				// Increment peer's number of block requests
+				++numberOfBlockRequestsPerPeer[leastBusyPeer->getIdentifier()];
+			}
+			
+			// Check if block wasn't requested or peer can't handle more block requests
+			if(!blockRequested || numberOfBlockRequestsPerPeer[leastBusyPeer->getIdentifier()] >= MAXIMUM_NUMBER_OF_BLOCK_REQUESTS_PER_PEER || leastBusyPeer->isMessageQueueFull()) {
+			
+				// Go through all downloading peers
+				for(vector<pair<Peer *, unique_lock<shared_mutex>>>::iterator i = downloadingPeers.begin(); i != downloadingPeers.end(); ++i) {
+				
+					// Check if downloading peer is the peer
+					if(i->first == leastBusyPeer) {
+					
+						// Remove peer from the list of downloading peers
+						downloadingPeers.erase(i);
+						
+						// Break
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+// Cancel block downloads
+void Node::cancelBlockDownloads(const string &peerIdentifier) {
+
+	// Go through all block requests
+	for(map<uint64_t, tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string, chrono::time_point<chrono::steady_clock>>>::iterator i = blockRequests.begin(); i != blockRequests.end();) {
+	
+		// Check if block was requested from the peer
+		if(get<1>(i->second) == peerIdentifier) {
+		
+			// Remove block from the list of block requests
+			i = blockRequests.erase(i);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Go to next block request
+			++i;
+		}
+	}
+	
+	// Go through all downloaded blocks
+	for(map<uint64_t, tuple<vector<uint8_t>, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string>>::iterator i = downloadedBlocks.begin(); i != downloadedBlocks.end();) {
+	
+		// Check if block was downloaded from the peer
+		if(get<2>(i->second) == peerIdentifier) {
+		
+			// Remove block from the list of downloaded blocks
+			i = downloadedBlocks.erase(i);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Go to next downloaded block
+			++i;
+		}
+	}
+}
+
 // Remove invalid unused peer candidates
 void Node::removeInvalidUnusedPeerCandidates() {
 
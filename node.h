@@ -7,13 +7,16 @@
 #include "./common.h"
 #include <condition_variable>
 #include <functional>
+#include <future>
 #include <list>
+#include <map>
 #include <random>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include "./block.h"
+#include "./difficulty_adjustment_window.h"
 #include "./header.h"
 #include "./mempool.h"
 #include "./merkle_mountain_range.h"
@@ -74,6 +77,9 @@ class Node final {
 			#endif
 		};
 		
+		// Block request timeout
+		static const chrono::seconds BLOCK_REQUEST_TIMEOUT;
+		
 		// Constructor
 		explicit Node();
 		
@@ -86,6 +92,15 @@ class Node final {
 		// Restore
 		void restore(ifstream &file);
 		
+		// Set checkpoint file
+		void setCheckpointFile(const string &checkpointFile);
+		
+		// Save checkpoint
+		void saveCheckpoint();
+		
+		// Restore checkpoint
+		void restoreCheckpoint();
+		
 		// Set on start syncing callback
 		void setOnStartSyncingCallback(const function<void(Node &node)> &onStartSyncingCallback);
 		
@@ -129,13 +144,13 @@ class Node final {
 		#ifdef ENABLE_FLOONET
 		
 			// Start
-			void start(const char *torProxyAddress = "localhost", const uint16_t torProxyPort = 9050, const char *customDnsSeed = nullptr, const uint64_t baseFee = DEFAULT_BASE_FEE, const char *listeningAddress = nullptr, const uint16_t listeningPort = 13414, const Capabilities desiredPeerCapabilities = Capabilities::FULL_NODE);
+			void start(const char *torProxyAddress = "localhost", const uint16_t torProxyPort = 9050, const char *customDnsSeed = nullptr, const uint64_t baseFee = DEFAULT_BASE_FEE, const char *listeningAddress = nullptr, const uint16_t listeningPort = 13414, const Capabilities desiredPeerCapabilities = Capabilities::FULL_NODE, const unsigned int numberOfVerificationThreads = thread::hardware_concurrency());
 			
 		// Otherwise
 		#else
 		
 			// Start
-			void start(const char *torProxyAddress = "localhost", const uint16_t torProxyPort = 9050, const char *customDnsSeed = nullptr, const uint64_t baseFee = DEFAULT_BASE_FEE, const char *listeningAddress = nullptr, const uint16_t listeningPort = 3414, const Capabilities desiredPeerCapabilities = Capabilities::FULL_NODE);
+			void start(const char *torProxyAddress = "localhost", const uint16_t torProxyPort = 9050, const char *customDnsSeed = nullptr, const uint64_t baseFee = DEFAULT_BASE_FEE, const char *listeningAddress = nullptr, const uint16_t listeningPort = 3414, const Capabilities desiredPeerCapabilities = Capabilities::FULL_NODE, const unsigned int numberOfVerificationThreads = thread::hardware_concurrency());
 		#endif
 		
 		// Stop
@@ -186,7 +201,7 @@ class Node final {
 		// Broadcast block
 		void broadcastBlock(Header &&header, Block &&block);
 		
-		// Get next block
+		// Get next block (create coinbase isn't called when the cached block template is returned)
 		tuple<Header, Block, uint64_t> getNextBlock(const function<tuple<Output, Rangeproof, Kernel>(const uint64_t amount)> &createCoinbase);
 		
 		// Default base fee
@@ -241,10 +256,13 @@ class Node final {
 		void setSyncState(MerkleMountainRange<Header> &&headers, const Header &transactionHashSetArchiveHeader, MerkleMountainRange<Kernel> &&kernels, MerkleMountainRange<Output> &&outputs, MerkleMountainRange<Rangeproof> &&rangeproofs);
 		
 		// Update sync state
-		bool updateSyncState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, const Block &block);
+		bool updateSyncState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, Block &&block);
 		
 		// Update sync state
-		bool updateSyncState(const uint64_t syncedHeaderIndex, const Block &block);
+		bool updateSyncState(const uint64_t syncedHeaderIndex, Block &&block);
+		
+		// Add downloaded block
+		void addDownloadedBlock(const uint64_t height, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &blockHash, vector<uint8_t> &&blockMessage, const string &peerIdentifier);
 		
 		// Peer connected
 		void peerConnected(const string &peerIdentifier);
@@ -282,6 +300,9 @@ class Node final {
 		// Get desired peer capabilities
 		Capabilities getDesiredPeerCapabilities() const;
 		
+		// Get number of verification threads
+		unsigned int getNumberOfVerificationThreads() const;
+		
 	// Private
 	private:
 		
@@ -327,11 +348,56 @@ class Node final {
 		// Remove random peer interval
 		static const chrono::hours REMOVE_RANDOM_PEER_INTERVAL;
 		
+		// Checkpoint interval
+		static const chrono::minutes CHECKPOINT_INTERVAL;
+		
+		// Maximum number of checkpoint deltas
+		static const uint64_t MAXIMUM_NUMBER_OF_CHECKPOINT_DELTAS;
+		
+		// State version
+		static const uint64_t STATE_VERSION;
+		
+		// Block download window size
+		static const uint64_t BLOCK_DOWNLOAD_WINDOW_SIZE;
+		
+		// Maximum number of block requests per peer
+		static const uint64_t MAXIMUM_NUMBER_OF_BLOCK_REQUESTS_PER_PEER;
+		
+		// Save state
+		static void saveState(ofstream &file, const MerkleMountainRange<Header> &headers, const uint64_t syncedHeaderIndex, const MerkleMountainRange<Kernel> &kernels, const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers);
+		
+		// Restore state
+		static void restoreState(ifstream &file, MerkleMountainRange<Header> &headers, uint64_t &syncedHeaderIndex, MerkleMountainRange<Kernel> &kernels, MerkleMountainRange<Output> &outputs, MerkleMountainRange<Rangeproof> &rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers);
+		
+		// Save file atomically
+		static void saveFileAtomically(const string &fileName, const function<void(ofstream &file)> &writeFile);
+		
+		// Get checkpoint delta file name
+		static string getCheckpointDeltaFileName(const string &checkpointFile, const uint64_t checkpointDeltaNumber);
+		
+		// Restore checkpoint state
+		static optional<uint64_t> restoreCheckpointState(const string &checkpointFile, MerkleMountainRange<Header> &headers, uint64_t &syncedHeaderIndex, MerkleMountainRange<Kernel> &kernels, MerkleMountainRange<Output> &outputs, MerkleMountainRange<Rangeproof> &rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers, uint64_t &numberOfCheckpointDeltas);
+		
+		// Save checkpoint snapshot
+		static void saveCheckpointSnapshot(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t previousNumberOfCheckpointDeltas, const MerkleMountainRange<Header> &headers, const uint64_t syncedHeaderIndex, const MerkleMountainRange<Kernel> &kernels, const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers);
+		
+		// Save checkpoint delta
+		static void saveCheckpointDelta(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t checkpointDeltaNumber, const uint64_t syncedHeaderIndex, const vector<MerkleMountainRange<Header>::JournalEntry> &headersJournal, const vector<MerkleMountainRange<Kernel>::JournalEntry> &kernelsJournal, const vector<MerkleMountainRange<Output>::JournalEntry> &outputsJournal, const vector<MerkleMountainRange<Rangeproof>::JournalEntry> &rangeproofsJournal);
+		
+		// Compact checkpoint
+		static void compactCheckpoint(const string &checkpointFile, const uint64_t checkpointIdentifier, const uint64_t numberOfCheckpointDeltas, const uint64_t newCheckpointIdentifier, const unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &healthyPeers);
+		
+		// Set restored state
+		void setRestoredState(MerkleMountainRange<Header> &&headers, const uint64_t syncedHeaderIndex, MerkleMountainRange<Kernel> &&kernels, MerkleMountainRange<Output> &&outputs, MerkleMountainRange<Rangeproof> &&rangeproofs, unordered_map<string, pair<chrono::time_point<chrono::steady_clock>, Capabilities>> &&healthyPeers);
+		
+		// Create checkpoint
+		void createCheckpoint();
+		
 		// Cleanup mempool
 		void cleanupMempool();
 		
 		// Apply block to sync state
-		bool applyBlockToSyncState(const uint64_t syncedHeaderIndex, const Block &block);
+		bool applyBlockToSyncState(const uint64_t syncedHeaderIndex, Block &&block);
 		
 		// Monitor
 		void monitor();
@@ -357,6 +423,12 @@ class Node final {
 		// Sync
 		void sync();
 		
+		// Request blocks
+		void requestBlocks();
+		
+		// Cancel block downloads
+		void cancelBlockDownloads(const string &peerIdentifier);
+		
 		// Remove invalid unused peer candidates
 		void removeInvalidUnusedPeerCandidates();
 		
@@ -429,6 +501,9 @@ class Node final {
 		// Desired peer capabilitied
 		Capabilities desiredPeerCapabilities;
 		
+		// Number of verification threads
+		unsigned int numberOfVerificationThreads;
+		
 		// Random number generator
 		mt19937_64 randomNumberGenerator;
 		
@@ -499,12 +574,27 @@ class Node final {
 		// Mempool
 		Mempool mempool;
 		
+		// Difficulty adjustment window
+		DifficultyAdjustmentWindow difficultyAdjustmentWindow;
+		
 		// Pending transactions
 		list<Transaction> pendingTransactions;
 		
 		// Pending block
 		optional<const tuple<const Header, const Block>> pendingBlock;
 		
+		// Block template
+		optional<tuple<Header, Block, uint64_t>> blockTemplate;
+		
+		// Block template mempool version
+		uint64_t blockTemplateMempoolVersion;
+		
+		// Block template previous block hash
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> blockTemplatePreviousBlockHash;
+		
+		// Block template coinbase
+		optional<tuple<uint64_t, uint64_t, tuple<Output, Rangeproof, Kernel>>> blockTemplateCoinbase;
+		
 		// Stop monitoring
 		atomic_bool stopMonitoring;
 		
@@ -516,6 +606,27 @@ class Node final {
 		
 		// Main thread
 		thread mainThread;
+		
+		// Checkpoint file
+		string checkpointFile;
+		
+		// Checkpoint identifier
+		uint64_t checkpointIdentifier;
+		
+		// Number of checkpoint deltas
+		uint64_t numberOfCheckpointDeltas;
+		
+		// Checkpoint snapshot required
+		bool checkpointSnapshotRequired;
+		
+		// Checkpoint saver
+		future<void> checkpointSaver;
+		
+		// Block requests
+		map<uint64_t, tuple<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string, chrono::time_point<chrono::steady_clock>>> blockRequests;
+		
+		// Downloaded blocks
+		map<uint64_t, tuple<vector<uint8_t>, array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, string>> downloadedBlocks;
 };
 
 
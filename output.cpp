@@ -74,10 +74,10 @@ bool Output::operator!=(const Output &other) const {
 }
 
 // Get lookup value
-optional<vector<uint8_t>> Output::getLookupValue() const {
+optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> Output::getLookupValue() const {
 
 	// Check if serializing commitment failed
-	vector<uint8_t> serializedCommitment(Crypto::COMMITMENT_LENGTH);
+	array<uint8_t, Crypto::COMMITMENT_LENGTH> serializedCommitment;
 	if(!secp256k1_pedersen_commitment_serialize(secp256k1_context_no_precomp, serializedCommitment.data(), &commitment)) {
 	
 		// Throw exception
@@ -218,7 +218,7 @@ void Output::subtractFromSum(secp256k1_pedersen_commitment &sum, const Subtracti
 }
 
 // Save
-void Output::save(ofstream &file) const {
+void Output::save(ostream &file) const {
 
 	// Write features to file
 	file.write(reinterpret_cast<const char *>(&features), sizeof(features));
@@ -236,14 +236,14 @@ void Output::save(ofstream &file) const {
 }
 
 // Restore
-Output Output::restore(ifstream &file) {
+Output Output::restore(istream &file) {
 
 	// Return output created from file
 	return Output(file);
 }
 
 // Save sum
-void Output::saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file) {
+void Output::saveSum(const secp256k1_pedersen_commitment &sum, ostream &file) {
 
 	// Check if sum isn't zero
 	uint8_t serializedSum[Crypto::COMMITMENT_LENGTH] = {};
@@ -266,7 +266,7 @@ void Output::saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file) {
 }
 
 // Restore sum
-void Output::restoreSum(secp256k1_pedersen_commitment &sum, ifstream &file) {
+void Output::restoreSum(secp256k1_pedersen_commitment &sum, istream &file) {
 
 	// Read sum from file
 	uint8_t serializedSum[Crypto::COMMITMENT_LENGTH];
@@ -376,7 +376,7 @@ Output::Output(const Features features, const uint8_t commitment[Crypto::COMMITM
 }
 
 // Constructor
-Output::Output(ifstream &file) {
+Output::Output(istream &file) {
 
 	// Read features from file
 	file.read(reinterpret_cast<char *>(&features), sizeof(features));
@@ -18,7 +18,7 @@ namespace MwcValidationNode {
 // Classes
 
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Node class forward declaration
 class Node;
@@ -67,13 +67,13 @@ class Output final : public MerkleMountainRangeLeaf<Output, sizeof(uint8_t) + Cr
 		bool operator!=(const Output &other) const;
 		
 		// Get lookup value
-		virtual optional<vector<uint8_t>> getLookupValue() const override final;
+		virtual optional<array<uint8_t, Crypto::COMMITMENT_LENGTH>> getLookupValue() const override final;
 		
 	// Public for Merkle mountain range class
 	private:
 	
 		// Merkle mountain range friend class
-		friend class MerkleMountainRange<Output>;
+		template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> friend class MerkleMountainRange;
 		
 		// Add to sum
 		virtual void addToSum(secp256k1_pedersen_commitment &sum, const AdditionReason additionReason) const override final;
@@ -82,16 +82,16 @@ class Output final : public MerkleMountainRangeLeaf<Output, sizeof(uint8_t) + Cr
 		virtual void subtractFromSum(secp256k1_pedersen_commitment &sum, const SubtractionReason subtractionReason) const override final;
 		
 		// Save
-		virtual void save(ofstream &file) const override final;
+		virtual void save(ostream &file) const override final;
 		
 		// Restore
-		static Output restore(ifstream &file);
+		static Output restore(istream &file);
 		
 		// Save sum
-		static void saveSum(const secp256k1_pedersen_commitment &sum, ofstream &file);
+		static void saveSum(const secp256k1_pedersen_commitment &sum, ostream &file);
 		
 		// Restore sum
-		static void restoreSum(secp256k1_pedersen_commitment &sum, ifstream &file);
+		static void restoreSum(secp256k1_pedersen_commitment &sum, istream &file);
 		
 		// Get serialized protocol version
 		static uint32_t getSerializedProtocolVersion(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedOutput, const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedOutputLength, const uint32_t protocolVersion);
@@ -123,7 +123,7 @@ class Output final : public MerkleMountainRangeLeaf<Output, sizeof(uint8_t) + Cr
 	private:
 	
 		// Constructor
-		explicit Output(ifstream &file);
+		explicit Output(istream &file);
 		
 		// Features
 		Features features;
@@ -1,6 +1,7 @@
 // Header files
 #include "./common.h"
 #include <climits>
+#include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
 #include <functional>
@@ -9,6 +10,7 @@
 #include "./consensus.h"
 #include "./message.h"
 #include "./peer.h"
+#include "./proof_of_work.h"
 #include "./saturate_math.h"
 
 // Check if not Windows
@@ -103,6 +105,9 @@ const chrono::minutes Peer::GET_TRANSACTION_HASH_SET_RESPONSE_REQUIRED_DURATION
 // Get transaction hash set attachment required duration
 const chrono::minutes Peer::GET_TRANSACTION_HASH_SET_ATTACHMENT_REQUIRED_DURATION = 60min;
 
+// Transaction hash set archive file name prefix
+const char Peer::TRANSACTION_HASH_SET_ARCHIVE_FILE_NAME_PREFIX[] = "./transaction_hash_set_archive.";
+
 // Get block response required duration
 const chrono::minutes Peer::GET_BLOCK_RESPONSE_REQUIRED_DURATION = 2min;
 
@@ -115,6 +120,15 @@ const int Peer::MAXIMUM_ALLOWED_NUMBER_OF_REORGS_DURING_BLOCK_SYNC = 2;
 // Before disconnect delay duration
 const chrono::milliseconds Peer::BEFORE_DISCONNECT_DELAY_DURATION = 1ms;
 
+// Kernel roots verification chunk size
+const vector<const Header *>::size_type Peer::KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE = 1024;
+
+// Rangeproofs verification chunk size
+const uint64_t Peer::RANGEPROOFS_VERIFICATION_CHUNK_SIZE = 4096;
+
+// Proof of work verification chunk size
+const vector<const Header *>::size_type Peer::PROOF_OF_WORK_VERIFICATION_CHUNK_SIZE = 16;
+
 
 // Supporting function implementation
 
@@ -161,6 +175,15 @@ Peer::Peer(condition_variable &eventOccurred, const mt19937_64::result_type rand
 	// Set number of messages received to zero
 	numberOfMessagesReceived(0),
 	
+	// Set transaction hash set archive file to nothing
+	transactionHashSetArchiveFile(nullptr, fclose),
+	
+	// Set transaction hash set archive outputs file to nothing
+	transactionHashSetArchiveOutputsFile(nullptr, fclose),
+	
+	// Set transaction hash set archive rangeproofs file to nothing
+	transactionHashSetArchiveRangeproofsFile(nullptr, fclose),
+	
 	// Create random number generator using the random seed
 	randomNumberGenerator(randomSeed),
 	
@@ -386,7 +409,7 @@ Peer::~Peer() {
 									#ifdef _WIN32
 								
 										// Get bytes sent to socket
-										bytesSent = send(socket, reinterpret_cast<char *>(writeBuffer.data()), writeBuffer.size(), 0);
+										bytesSent = send(socket, reinterpret_cast<const char *>(writeBuffer.data()), writeBuffer.size(), 0);
 									
 									// Otherwise
 									#else
@@ -399,7 +422,7 @@ Peer::~Peer() {
 									if(bytesSent > 0) {
 									
 										// Remove bytes from write buffer
-										writeBuffer.erase(writeBuffer.cbegin(), writeBuffer.cbegin() + bytesSent);
+										writeBuffer.consume(bytesSent);
 									}
 									
 								} while(bytesSent > 0 && !writeBuffer.empty());
@@ -675,6 +698,9 @@ void Peer::startSyncing(const MerkleMountainRange<Header> &headers, const uint64
 	// Set number of reorgs during block sync to zero
 	numberOfReorgsDuringBlockSync = 0;
 	
+	// Remove downloaded block
+	downloadedBlock.reset();
+	
 	// Check if next block's header is known, all this peer's headers are known, and transaction hash set isn't needed
 	if(headers.getLeaf(syncedHeaderIndex + 1) && headers.back().getTotalDifficulty() >= totalDifficulty && headers.back().getHeight() - syncedHeaderIndex <= Consensus::CUT_THROUGH_HORIZON) {
 	
@@ -690,6 +716,48 @@ void Peer::startSyncing(const MerkleMountainRange<Header> &headers, const uint64
 	}
 }
 
+// Start syncing
+void Peer::startSyncing(const uint64_t syncedHeaderIndex, vector<uint8_t> &&blockMessage) {
+
+	// Set use node headers to true
+	useNodeHeaders = true;
+	
+	// Set synced header index to synced header index
+	this->syncedHeaderIndex = syncedHeaderIndex;
+	
+	// Set number of reorgs during headers sync to zero
+	numberOfReorgsDuringHeadersSync = 0;
+	
+	// Set number of reorgs during block sync to zero
+	numberOfReorgsDuringBlockSync = 0;
+	
+	// Set downloaded block to the block message
+	downloadedBlock = move(blockMessage);
+	
+	// Set syncing state to requesting block
+	syncingState = SyncingState::REQUESTING_BLOCK;
+}
+
+// Request block
+bool Peer::requestBlock(const uint64_t height, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &blockHash) {
+
+	// Check if messages can't be sent and received
+	if(isMessageQueueFull()) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Send get block message
+	sendMessage(Message::createGetBlockMessage(blockHash.data()));
+	
+	// Add block to the list of requested blocks
+	requestedBlocks[height] = {blockHash, chrono::steady_clock::now()};
+	
+	// Return true
+	return true;
+}
+
 // Get headers
 MerkleMountainRange<Header> &Peer::getHeaders() {
 
@@ -701,7 +769,7 @@ MerkleMountainRange<Header> &Peer::getHeaders() {
 void Peer::sendMessage(const vector<uint8_t> &message) {
 
 	// Append message to write buffer
-	writeBuffer.insert(writeBuffer.cend(), message.cbegin(), message.cend());
+	writeBuffer.append(message);
 	
 	// Check if not at the max number of messages sent
 	if(numberOfMessagesSent != INT_MAX) {
@@ -2363,7 +2431,7 @@ void Peer::connectOutbound(const string address) {
 					const vector handMessage = Message::createHandMessage(nonce, nodesTotalDifficulty, clientAddress, serverAddress, node->getBaseFee(), Node::CAPABILITIES, Node::USER_AGENT);
 					
 					// Append hand message to write buffer
-					writeBuffer.insert(writeBuffer.cend(), handMessage.cbegin(), handMessage.cend());
+					writeBuffer.append(handMessage);
 					
 					// Check if not at the max number of messages sent
 					if(numberOfMessagesSent != INT_MAX) {
@@ -2408,7 +2476,7 @@ void Peer::connectOutbound(const string address) {
 					#endif
 					
 					// Free all memory allocated by the write buffer
-					vector<uint8_t>().swap(writeBuffer);
+					writeBuffer.clear();
 					
 					// Delay
 					this_thread::sleep_for(BEFORE_DISCONNECT_DELAY_DURATION);
@@ -2749,7 +2817,7 @@ void Peer::readAndWrite() {
 						if(numberOfMessagesReceived < MAXIMUM_NUMBER_OF_MESSAGES_RECEIVED_PER_INTERVAL / 2 && numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 						
 							// Append get peer addresses message to write buffer
-							writeBuffer.insert(writeBuffer.cend(), getPeerAddressesMessage.cbegin(), getPeerAddressesMessage.cend());
+							writeBuffer.append(getPeerAddressesMessage);
 							
 							// Increment number of messages sent
 							++numberOfMessagesSent;
@@ -2768,6 +2836,29 @@ void Peer::readAndWrite() {
 				lastGetPeerAddressesTime = chrono::steady_clock::now();
 			}
 			
+			{
+				// Lock for writing
+				lock_guard writeLock(lock);
+				
+				// Go through all requested blocks
+				for(unordered_map<uint64_t, pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, chrono::time_point<chrono::steady_clock>>>::iterator i = requestedBlocks.begin(); i != requestedBlocks.end();) {
+				
+					// Check if waiting for the block has timed out
+					if(chrono::steady_clock::now() - i->second.second > Node::BLOCK_REQUEST_TIMEOUT) {
+					
+						// Remove block from the list of requested blocks
+						i = requestedBlocks.erase(i);
+					}
+					
+					// Otherwise
+					else {
+					
+						// Go to next requested block
+						++i;
+					}
+				}
+			}
+			
 			// Check if waiting for a sync response has timed out
 			if(currentSyncResponseRequiredTime.has_value() && chrono::steady_clock::now() > currentSyncResponseRequiredTime.value()) {
 			
@@ -2890,7 +2981,7 @@ void Peer::readAndWrite() {
 									if(numberOfMessagesReceived < MAXIMUM_NUMBER_OF_MESSAGES_RECEIVED_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL && numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL) {
 									
 										// Append get headers message to write buffer
-										writeBuffer.insert(writeBuffer.cend(), getHeadersMessage.cbegin(), getHeadersMessage.cend());
+										writeBuffer.append(getHeadersMessage);
 										
 										// Increment number of messages sent
 										++numberOfMessagesSent;
@@ -2931,7 +3022,7 @@ void Peer::readAndWrite() {
 									if(numberOfMessagesReceived < MAXIMUM_NUMBER_OF_MESSAGES_RECEIVED_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL && numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL) {
 									
 										// Append get transaction hash set message to write buffer
-										writeBuffer.insert(writeBuffer.cend(), getTransactionHashSetMessage.cbegin(), getTransactionHashSetMessage.cend());
+										writeBuffer.append(getTransactionHashSetMessage);
 										
 										// Increment number of messages sent
 										++numberOfMessagesSent;
@@ -2967,6 +3058,27 @@ void Peer::readAndWrite() {
 								break;
 							}
 						
+							// Check if block was already downloaded
+							if(downloadedBlock.has_value()) {
+							
+								{
+									// Lock for writing
+									lock_guard writeLock(lock);
+									
+									// Set syncing state to processing block
+									syncingState = SyncingState::PROCESSING_BLOCK;
+								}
+								
+								// Create worker operation to process the downloaded block
+								workerOperation = async(launch::async, &Peer::processBlock, this, move(downloadedBlock.value()));
+								
+								// Remove downloaded block
+								downloadedBlock.reset();
+								
+								// Break
+								break;
+							}
+						
 							{
 								// Initialize block hash
 								array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> blockHash;
@@ -2999,7 +3111,7 @@ void Peer::readAndWrite() {
 									if(numberOfMessagesReceived < MAXIMUM_NUMBER_OF_MESSAGES_RECEIVED_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL && numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2 - RESERVED_NUMBER_OF_MESSAGES_PER_INTERVAL) {
 									
 										// Append get block message to write buffer
-										writeBuffer.insert(writeBuffer.cend(), getBlockMessage.cbegin(), getBlockMessage.cend());
+										writeBuffer.append(getBlockMessage);
 										
 										// Increment number of messages sent
 										++numberOfMessagesSent;
@@ -3096,7 +3208,7 @@ void Peer::readAndWrite() {
 						if(numberOfMessagesReceived < MAXIMUM_NUMBER_OF_MESSAGES_RECEIVED_PER_INTERVAL / 2 && numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 							// Append ping message to write buffer
-							writeBuffer.insert(writeBuffer.cend(), pingMessage.cbegin(), pingMessage.cend());
+							writeBuffer.append(pingMessage);
 							
 							// Increment number of messages sent
 							++numberOfMessagesSent;
@@ -3267,7 +3379,7 @@ void Peer::readAndWrite() {
 							currentReadDone = true;
 						
 							// Add bytes to read buffer
-							readBuffer.insert(readBuffer.cend(), cbegin(buffer), cbegin(buffer) + bytesRead);
+							readBuffer.append(buffer, bytesRead);
 						}
 						
 					} while(bytesRead > 0);
@@ -3325,7 +3437,7 @@ void Peer::readAndWrite() {
 							#ifdef _WIN32
 							
 								// Get bytes sent to socket
-								bytesSent = send(socket, reinterpret_cast<char *>(writeBuffer.data()), writeBuffer.size(), 0);
+								bytesSent = send(socket, reinterpret_cast<const char *>(writeBuffer.data()), writeBuffer.size(), 0);
 								
 							// Otherwise
 							#else
@@ -3345,13 +3457,13 @@ void Peer::readAndWrite() {
 							lock_guard writeLock(lock);
 					
 							// Remove bytes from write buffer
-							writeBuffer.erase(writeBuffer.cbegin(), writeBuffer.cbegin() + bytesSent);
+							writeBuffer.consume(bytesSent);
 							
 							// Check if write buffer is empty
 							if(writeBuffer.empty()) {
 							
 								// Free all memory allocated by the write buffer
-								vector<uint8_t>().swap(writeBuffer);
+								writeBuffer.clear();
 							
 								// break
 								break;
@@ -3597,7 +3709,7 @@ void Peer::disconnect() {
 	}
 	
 	// Free all memory allocated by the read buffer
-	vector<uint8_t>().swap(readBuffer);
+	readBuffer.clear();
 	
 	// Delay
 	this_thread::sleep_for(BEFORE_DISCONNECT_DELAY_DURATION);
@@ -3609,7 +3721,7 @@ void Peer::disconnect() {
 		lock_guard writeLock(lock);
 		
 		// Free all memory allocated by the write buffer
-		vector<uint8_t>().swap(writeBuffer);
+		writeBuffer.clear();
 		
 		// Set connection state to disconnected
 		connectionState = ConnectionState::DISCONNECTED;
@@ -3654,6 +3766,84 @@ bool Peer::processRequestsAndOrResponses() {
 	// Go through all requests and responses
 	while(true) {
 	
+		// Check if receiving a transaction hash set archive attachment
+		if(transactionHashSetArchiveFile) {
+		
+			// Get number of the attachment's bytes in the read buffer
+			const MessageBuffer::size_type length = min(readBuffer.size(), static_cast<MessageBuffer::size_type>(transactionHashSetArchiveFileRemainingLength));
+			
+			// Check if writing the attachment's bytes to the transaction hash set archive file failed
+			if(fwrite(readBuffer.data(), sizeof(uint8_t), length, transactionHashSetArchiveFile.get()) != length) {
+			
+				// Return false
+				return false;
+			}
+			
+			// Remove the attachment's bytes from read buffer
+			readBuffer.consume(length);
+			
+			// Update transaction hash set archive file remaining length
+			transactionHashSetArchiveFileRemainingLength -= length;
+			
+			// Check if the attachment hasn't been completely received
+			if(transactionHashSetArchiveFileRemainingLength) {
+			
+				// Break
+				break;
+			}
+			
+			// Check if flushing the transaction hash set archive file failed
+			if(fflush(transactionHashSetArchiveFile.get())) {
+			
+				// Return false
+				return false;
+			}
+			
+			// Remove the current sync response required time
+			currentSyncResponseRequiredTime.reset();
+			
+			// Initialize transaction hash set requested
+			bool transactionHashSetRequested;
+			
+			{
+				// Lock for writing
+				lock_guard writeLock(lock);
+				
+				// Set transaction hash set requested to if the transaction hash set is still requested
+				transactionHashSetRequested = syncingState == SyncingState::REQUESTED_TRANSACTION_HASH_SET;
+				
+				// Check if transaction hash set is requested
+				if(transactionHashSetRequested) {
+				
+					// Set syncing state to processing transaction hash set
+					syncingState = SyncingState::PROCESSING_TRANSACTION_HASH_SET;
+				}
+			}
+			
+			// Check if transaction hash set is requested
+			if(transactionHashSetRequested) {
+			
+				// Create worker operation to process the transaction hash set archive
+				workerOperation = async(launch::async, &Peer::processTransactionHashSetArchive, this, move(transactionHashSetArchiveFile), move(transactionHashSetArchiveOutputsFile), move(transactionHashSetArchiveRangeproofsFile), transactionHashSetArchiveFileLength, transactionHashSetArchiveFileHeader);
+			}
+			
+			// Otherwise
+			else {
+			
+				// Close transaction hash set archive files
+				transactionHashSetArchiveFile.reset();
+				transactionHashSetArchiveOutputsFile.reset();
+				transactionHashSetArchiveRangeproofsFile.reset();
+			}
+			
+			// Check if read buffer is empty
+			if(readBuffer.empty()) {
+			
+				// Free all memory allocated by the read buffer
+				readBuffer.clear();
+			}
+		}
+		
 		// Check if request or response doesn't contain a message header
 		if(readBuffer.size() < Message::MESSAGE_HEADER_LENGTH) {
 		
@@ -3668,7 +3858,7 @@ bool Peer::processRequestsAndOrResponses() {
 		try {
 		
 			// Read message header
-			messageHeader = Message::readMessageHeader(readBuffer);
+			messageHeader = Message::readMessageHeader(readBuffer.getContents());
 		}
 		
 		// Catch errors
@@ -3736,7 +3926,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read hand message
-						handComponents = Message::readHandMessage(readBuffer);
+						handComponents = Message::readHandMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -3973,7 +4163,7 @@ bool Peer::processRequestsAndOrResponses() {
 						baseFee = handBaseFee;
 						
 						// Append shake messages to write buffer
-						writeBuffer.insert(writeBuffer.cend(), shakeMessage.cbegin(), shakeMessage.cend());
+						writeBuffer.append(shakeMessage);
 						
 						// Check if not at the max number of messages sent
 						if(numberOfMessagesSent != INT_MAX) {
@@ -3983,7 +4173,7 @@ bool Peer::processRequestsAndOrResponses() {
 						}
 						
 						// Append get peer addresses messages to write buffer
-						writeBuffer.insert(writeBuffer.cend(), getPeerAddressesMessage.cbegin(), getPeerAddressesMessage.cend());
+						writeBuffer.append(getPeerAddressesMessage);
 						
 						// Check if not at the max number of messages sent
 						if(numberOfMessagesSent != INT_MAX) {
@@ -4029,7 +4219,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read shake message
-						shakeComponents = Message::readShakeMessage(readBuffer);
+						shakeComponents = Message::readShakeMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4099,7 +4289,7 @@ bool Peer::processRequestsAndOrResponses() {
 						baseFee = shakeBaseFee;
 						
 						// Append get peer addresses messages to write buffer
-						writeBuffer.insert(writeBuffer.cend(), getPeerAddressesMessage.cbegin(), getPeerAddressesMessage.cend());
+						writeBuffer.append(getPeerAddressesMessage);
 						
 						// Check if not at the max number of messages sent
 						if(numberOfMessagesSent != INT_MAX) {
@@ -4112,7 +4302,7 @@ bool Peer::processRequestsAndOrResponses() {
 						if(!networkAddresses.empty()) {
 						
 							// Append peer addresses message to write buffer
-							writeBuffer.insert(writeBuffer.cend(), peerAddressesMessage.cbegin(), peerAddressesMessage.cend());
+							writeBuffer.append(peerAddressesMessage);
 							
 							// Check if not at the max number of messages sent
 							if(numberOfMessagesSent != INT_MAX) {
@@ -4159,7 +4349,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read ping message
-						pingComponents = Message::readPingMessage(readBuffer);
+						pingComponents = Message::readPingMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4211,7 +4401,7 @@ bool Peer::processRequestsAndOrResponses() {
 						if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 						
 							// Append pong message to write buffer
-							writeBuffer.insert(writeBuffer.cend(), pongMessage.cbegin(), pongMessage.cend());
+							writeBuffer.append(pongMessage);
 							
 							// Increment number of messages sent
 							++numberOfMessagesSent;
@@ -4262,7 +4452,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read pong message
-						pongComponents = Message::readPongMessage(readBuffer);
+						pongComponents = Message::readPongMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4337,7 +4527,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read get peer addresses message
-						desiredCapabilities = Message::readGetPeerAddressesMessage(readBuffer);
+						desiredCapabilities = Message::readGetPeerAddressesMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4560,7 +4750,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append peer addresses message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), peerAddressesMessage.cbegin(), peerAddressesMessage.cend());
+						writeBuffer.append(peerAddressesMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -4584,13 +4774,13 @@ bool Peer::processRequestsAndOrResponses() {
 				if(communicationState >= CommunicationState::PEER_ADDRESSES_REQUESTED) {
 				
 					// Initialize peer addresses
-					list<NetworkAddress> peerAddresses;
+					vector<NetworkAddress> peerAddresses;
 					
 					// Try
 					try {
 					
 						// Read peer addresses message
-						peerAddresses = Message::readPeerAddressesMessage(readBuffer);
+						peerAddresses = Message::readPeerAddressesMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4795,7 +4985,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append error message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), errorMessage.cbegin(), errorMessage.cend());
+						writeBuffer.append(errorMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -4825,7 +5015,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read header message
-						header = Message::readHeaderMessage(readBuffer);
+						header = Message::readHeaderMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -4913,13 +5103,13 @@ bool Peer::processRequestsAndOrResponses() {
 						currentSyncResponseRequiredTime.reset();
 				
 						// Initialize headers
-						list<Header> headers;
+						vector<Header> headers;
 						
 						// Try
 						try {
 						
 							// Read headers message
-							headers = Message::readHeadersMessage(readBuffer);
+							headers = Message::readHeadersMessage(readBuffer.getContents(), false);
 						}
 			
 						// Catch errors
@@ -4933,7 +5123,7 @@ bool Peer::processRequestsAndOrResponses() {
 						}
 						
 						// Get number of headers
-						const list<Header>::size_type numberOfHeaders = headers.size();
+						const vector<Header>::size_type numberOfHeaders = headers.size();
 						
 						// Get newest header height
 						const uint64_t newestHeaderHeight = numberOfHeaders ? headers.back().getHeight() : Consensus::GENESIS_BLOCK_HEADER.getHeight();
@@ -5108,7 +5298,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append error message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), errorMessage.cbegin(), errorMessage.cend());
+						writeBuffer.append(errorMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -5131,43 +5321,98 @@ bool Peer::processRequestsAndOrResponses() {
 				// Check if handshake was completed
 				if(communicationState > CommunicationState::HANDSHAKE_PENDING) {
 				
-					// Lock for reading
-					shared_lock readLock(lock);
-				
-					// Check if block was requested
-					if(syncingState == SyncingState::REQUESTED_BLOCK) {
+					// Lock for writing
+					unique_lock writeLock(lock);
 					
-						// Unlock read lock
-						readLock.unlock();
+					// Initialize downloaded block header
+					optional<Header> downloadedBlockHeader;
+					
+					// Check if blocks were requested
+					if(!requestedBlocks.empty()) {
+					
+						// Initialize header
+						optional<Header> header;
 						
-						// Remove the current sync response required time
-						currentSyncResponseRequiredTime.reset();
+						// Try
+						try {
 						
-						// Set number of reorgs during block sync to zero
-						numberOfReorgsDuringBlockSync = 0;
+							// Read header from block message
+							header = Message::readHeaderMessage(readBuffer.getContents());
+						}
 						
-						// Move read buffer and empty it
-						vector<uint8_t> buffer;
-						readBuffer.swap(buffer);
+						// Catch errors
+						catch(...) {
 						
-						// Set response or request erased to true
-						responseOrRequestErased = true;
+							// Unlock write lock
+							writeLock.unlock();
+							
+							// Set ban to true
+							ban = true;
+							
+							// Break
+							break;
+						}
 						
-						// Check if more requests or responses exist
-						if(buffer.size() > Message::MESSAGE_HEADER_LENGTH + messagePayloadLength) {
+						// Check if block was requested
+						if(requestedBlocks.contains(header.value().getHeight()) && requestedBlocks.at(header.value().getHeight()).first == header.value().getBlockHash()) {
 						
-							// Append requests or responses to the read buffer
-							readBuffer.insert(readBuffer.cend(), buffer.cbegin() + Message::MESSAGE_HEADER_LENGTH + messagePayloadLength, buffer.cend());
+							// Remove block from the list of requested blocks
+							requestedBlocks.erase(header.value().getHeight());
+							
+							// Check if block isn't the block being synced
+							if(syncingState != SyncingState::REQUESTED_BLOCK || header.value().getHeight() != syncedHeaderIndex + 1) {
+							
+								// Set downloaded block header to the header
+								downloadedBlockHeader = move(header);
+							}
 						}
+					}
+					
+					// Check if block was downloaded
+					if(downloadedBlockHeader.has_value()) {
+					
+						// Unlock write lock
+						writeLock.unlock();
+						
+						// Extract block message from the read buffer
+						vector<uint8_t> buffer = readBuffer.extract(Message::MESSAGE_HEADER_LENGTH + messagePayloadLength);
+						
+						// Set response or request erased to true
+						responseOrRequestErased = true;
 						
 						{
-							// Lock for writing
-							lock_guard writeLock(lock);
+							// Lock node for writing
+							lock_guard nodeWriteLock(node->getLock());
 							
-							// Set syncing state to processing block
-							syncingState = SyncingState::PROCESSING_BLOCK;
+							// Add downloaded block to the node
+							node->addDownloadedBlock(downloadedBlockHeader.value().getHeight(), downloadedBlockHeader.value().getBlockHash(), move(buffer), identifier);
 						}
 						
+						// Notify peers that event occurred
+						eventOccurred.notify_one();
+					}
+					
+					// Otherwise check if block was requested while syncing
+					else if(syncingState == SyncingState::REQUESTED_BLOCK) {
+					
+						// Set syncing state to processing block
+						syncingState = SyncingState::PROCESSING_BLOCK;
+						
+						// Unlock write lock
+						writeLock.unlock();
+						
+						// Remove the current sync response required time
+						currentSyncResponseRequiredTime.reset();
+						
+						// Set number of reorgs during block sync to zero
+						numberOfReorgsDuringBlockSync = 0;
+						
+						// Extract block message from the read buffer
+						vector<uint8_t> buffer = readBuffer.extract(Message::MESSAGE_HEADER_LENGTH + messagePayloadLength);
+						
+						// Set response or request erased to true
+						responseOrRequestErased = true;
+						
 						// Create worker operation to process the block
 						workerOperation = async(launch::async, &Peer::processBlock, this, move(buffer));
 					}
@@ -5175,8 +5420,8 @@ bool Peer::processRequestsAndOrResponses() {
 					// Otherwise
 					else {
 					
-						// Unlock read lock
-						readLock.unlock();
+						// Unlock write lock
+						writeLock.unlock();
 						
 						// Set ban to true
 						ban = true;
@@ -5209,7 +5454,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append error message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), errorMessage.cbegin(), errorMessage.cend());
+						writeBuffer.append(errorMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -5239,7 +5484,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read compact block message
-						header = Message::readCompactBlockMessage(readBuffer);
+						header = Message::readCompactBlockMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -5321,7 +5566,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read stem transaction message
-						stemTransactionMessage = Message::readStemTransactionMessage(readBuffer, protocolVersion);
+						stemTransactionMessage = Message::readStemTransactionMessage(readBuffer.getContents(), protocolVersion);
 					}
 		
 					// Catch errors
@@ -5339,7 +5584,7 @@ bool Peer::processRequestsAndOrResponses() {
 						lock_guard writeLock(lock);
 						
 						// Append stem transaction message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), stemTransactionMessage.cbegin(), stemTransactionMessage.cend());
+						writeBuffer.append(stemTransactionMessage);
 					}
 					
 					// Set increment number of messages received to false
@@ -5369,7 +5614,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read transaction message
-						transaction = Message::readTransactionMessage(readBuffer, protocolVersion);
+						transaction = Message::readTransactionMessage(readBuffer.getContents(), protocolVersion);
 					}
 		
 					// Catch errors
@@ -5437,7 +5682,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append error message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), errorMessage.cbegin(), errorMessage.cend());
+						writeBuffer.append(errorMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -5486,7 +5731,7 @@ bool Peer::processRequestsAndOrResponses() {
 						try {
 						
 							// Read transaction hash set archive message
-							transactionHashSetArchiveComponents = Message::readTransactionHashSetArchiveMessage(readBuffer);
+							transactionHashSetArchiveComponents = Message::readTransactionHashSetArchiveMessage(readBuffer.getContents());
 						}
 			
 						// Catch errors
@@ -5537,50 +5782,74 @@ bool Peer::processRequestsAndOrResponses() {
 							break;
 						}
 						
-						// Check if transaction hash set archive attachment length is too big
-						if(transactionHashSetArchiveAttachmentLength > numeric_limits<vector<uint8_t>::size_type>::max() - Message::MESSAGE_HEADER_LENGTH - messagePayloadLength) {
+						// Check if Windows
+						#ifdef _WIN32
 						
-							// Set ban to true
-							ban = true;
+							// Get transaction hash set archive file name
+							const string transactionHashSetArchiveFileName = TRANSACTION_HASH_SET_ARCHIVE_FILE_NAME_PREFIX + to_string(randomNumberGenerator());
 							
-							// Break
-							break;
-						}
-						
-						// Set message attachment length to the transaction hash set attachment length
-						messageAttachmentLength = transactionHashSetArchiveAttachmentLength;
-						
-						// Check if request contains the transaction hash set archive attachment
-						if(readBuffer.size() >= Message::MESSAGE_HEADER_LENGTH + messagePayloadLength + transactionHashSetArchiveAttachmentLength) {
-						
-							// Remove the current sync response required time
-							currentSyncResponseRequiredTime.reset();
+							// Create transaction hash set archive file that's deleted when closed
+							transactionHashSetArchiveFile.reset(fopen(transactionHashSetArchiveFileName.c_str(), "w+bD"));
 							
-							// Move read buffer and empty it
-							vector<uint8_t> buffer;
-							readBuffer.swap(buffer);
+							// Check if transaction hash set archive file was created
+							if(transactionHashSetArchiveFile) {
 							
-							// Set response or request erased to true
-							responseOrRequestErased = true;
+								// Open separate handles to the transaction hash set archive file for reading its outputs and rangeproofs
+								transactionHashSetArchiveOutputsFile.reset(fopen(transactionHashSetArchiveFileName.c_str(), "rbD"));
+								transactionHashSetArchiveRangeproofsFile.reset(fopen(transactionHashSetArchiveFileName.c_str(), "rbD"));
+							}
 							
-							// Check if more requests or responses exist
-							if(buffer.size() > Message::MESSAGE_HEADER_LENGTH + messagePayloadLength + messageAttachmentLength) {
+						// Otherwise
+						#else
+						
+							// Create transaction hash set archive file with a unique name that only this process can access
+							string transactionHashSetArchiveFileName = string(TRANSACTION_HASH_SET_ARCHIVE_FILE_NAME_PREFIX) + "XXXXXX";
+							const int transactionHashSetArchiveFileDescriptor = mkstemp(transactionHashSetArchiveFileName.data());
 							
-								// Append requests or responses to the read buffer
-								readBuffer.insert(readBuffer.cend(), buffer.cbegin() + Message::MESSAGE_HEADER_LENGTH + messagePayloadLength + messageAttachmentLength, buffer.cend());
-							}
+							// Check if transaction hash set archive file was created
+							if(transactionHashSetArchiveFileDescriptor != -1) {
 							
-							{
-								// Lock for writing
-								lock_guard writeLock(lock);
+								// Open transaction hash set archive file from its file descriptor
+								transactionHashSetArchiveFile.reset(fdopen(transactionHashSetArchiveFileDescriptor, "w+b"));
+								
+								// Check if opening transaction hash set archive file failed
+								if(!transactionHashSetArchiveFile) {
 								
-								// Set syncing state to processing transaction hash set
-								syncingState = SyncingState::PROCESSING_TRANSACTION_HASH_SET;
+									// Close transaction hash set archive file's file descriptor
+									close(transactionHashSetArchiveFileDescriptor);
+								}
+								
+								// Otherwise
+								else {
+								
+									// Open separate handles to the transaction hash set archive file for reading its outputs and rangeproofs
+									transactionHashSetArchiveOutputsFile.reset(fopen(transactionHashSetArchiveFileName.c_str(), "rb"));
+									transactionHashSetArchiveRangeproofsFile.reset(fopen(transactionHashSetArchiveFileName.c_str(), "rb"));
+								}
+								
+								// Remove transaction hash set archive file's name so that it's deleted when closed
+								unlink(transactionHashSetArchiveFileName.c_str());
 							}
+						#endif
+						
+						// Check if creating transaction hash set archive file or opening its handles failed
+						if(!transactionHashSetArchiveFile || !transactionHashSetArchiveOutputsFile || !transactionHashSetArchiveRangeproofsFile) {
+						
+							// Close transaction hash set archive files
+							transactionHashSetArchiveFile.reset();
+							transactionHashSetArchiveOutputsFile.reset();
+							transactionHashSetArchiveRangeproofsFile.reset();
 							
-							// Create worker operation to process the transaction hash set archive
-							workerOperation = async(launch::async, &Peer::processTransactionHashSetArchive, this, move(buffer), Message::MESSAGE_HEADER_LENGTH + messagePayloadLength, transactionHashSetArchiveAttachmentLength, header);
+							// Return false
+							return false;
 						}
+						
+						// Set transaction hash set archive file length and remaining length to the attachment length
+						transactionHashSetArchiveFileLength = transactionHashSetArchiveAttachmentLength;
+						transactionHashSetArchiveFileRemainingLength = transactionHashSetArchiveAttachmentLength;
+						
+						// Set transaction hash set archive file header to the header
+						transactionHashSetArchiveFileHeader = header;
 					}
 					
 					// Otherwise
@@ -5629,7 +5898,7 @@ bool Peer::processRequestsAndOrResponses() {
 					if(numberOfMessagesSent < MAXIMUM_NUMBER_OF_MESSAGES_SENT_PER_INTERVAL / 2) {
 					
 						// Append error message to write buffer
-						writeBuffer.insert(writeBuffer.cend(), errorMessage.cbegin(), errorMessage.cend());
+						writeBuffer.append(errorMessage);
 						
 						// Increment number of messages sent
 						++numberOfMessagesSent;
@@ -5656,7 +5925,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read transaction kernel message
-						Message::readTransactionKernelMessage(readBuffer);
+						Message::readTransactionKernelMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -5687,7 +5956,7 @@ bool Peer::processRequestsAndOrResponses() {
 					try {
 					
 						// Read Tor address message
-						Message::readTorAddressMessage(readBuffer);
+						Message::readTorAddressMessage(readBuffer.getContents());
 					}
 		
 					// Catch errors
@@ -5750,13 +6019,13 @@ bool Peer::processRequestsAndOrResponses() {
 			}
 			
 			// Remove request or response from read buffer
-			readBuffer.erase(readBuffer.cbegin(), readBuffer.cbegin() + Message::MESSAGE_HEADER_LENGTH + messagePayloadLength + messageAttachmentLength);
+			readBuffer.consume(Message::MESSAGE_HEADER_LENGTH + messagePayloadLength + messageAttachmentLength);
 			
 			// Check if read buffer is empty
 			if(readBuffer.empty()) {
 			
 				// Free all memory allocated by the read buffer
-				vector<uint8_t>().swap(readBuffer);
+				readBuffer.clear();
 			}
 		}
 		
@@ -5805,7 +6074,71 @@ list<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> Peer::getLocatorHeadersBlockHa
 }
 
 // Process headers
-bool Peer::processHeaders(list<Header> &&headers) {
+bool Peer::processHeaders(vector<Header> &&headers) {
+
+	// Initialize proof of work headers
+	vector<const Header *> proofOfWorkHeaders;
+	proofOfWorkHeaders.reserve(headers.size());
+	
+	// Go through all headers
+	for(const Header &header : headers) {
+	
+		// Append header to list of proof of work headers
+		proofOfWorkHeaders.push_back(&header);
+	}
+	
+	// Set next header index to the first proof of work header
+	atomic_size_t nextHeaderIndex(0);
+	
+	// Set proof of work invalid to false
+	atomic_bool proofOfWorkInvalid(false);
+	
+	// Go through all additional verification threads
+	list<future<bool>> proofOfWorkVerificationOperations;
+	for(unsigned int i = 1; i < node->getNumberOfVerificationThreads() && i * PROOF_OF_WORK_VERIFICATION_CHUNK_SIZE < proofOfWorkHeaders.size(); ++i) {
+	
+		// Try
+		try {
+		
+			// Create verification operation to verify proof of work
+			proofOfWorkVerificationOperations.push_back(async(launch::async, &Peer::verifyProofOfWork, this, cref(proofOfWorkHeaders), ref(nextHeaderIndex), ref(proofOfWorkInvalid)));
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+			// Break
+			break;
+		}
+	}
+	
+	// Verify proof of work in this thread
+	bool proofOfWorkValid = verifyProofOfWork(proofOfWorkHeaders, nextHeaderIndex, proofOfWorkInvalid);
+	
+	// Go through all proof of work verification operations
+	for(future<bool> &proofOfWorkVerificationOperation : proofOfWorkVerificationOperations) {
+	
+		// Check if verifying proof of work failed
+		if(!proofOfWorkVerificationOperation.get()) {
+		
+			// Set proof of work valid to false
+			proofOfWorkValid = false;
+		}
+	}
+	
+	// Check if stopping read and write or is closing
+	if(stopReadAndWrite.load() || Common::isClosing()) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if proof of work isn't valid
+	if(!proofOfWorkValid) {
+	
+		// Return false
+		return false;
+	}
 	
 	// Set first header to true
 	bool firstHeader = true;
@@ -6011,118 +6344,18 @@ bool Peer::processHeaders(list<Header> &&headers) {
 			continue;
 		}
 		
-		// Initialize secondary scaling sum to zero
-		uint64_t secondaryScalingSum = 0;
-		
-		// Initialize difficulty sum to zero
-		uint64_t difficultySum = 0;
-		
-		// Initialize number of C29 headers to zero
-		uint64_t numberOfC29Headers = 0;
-		
-		// Go through all previous headers in the difficulty adjustment window
-		for(uint64_t i = 0; i < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW; ++i) {
-		
-			// Add header's secondary scaling to the sum
-			secondaryScalingSum += (i <= previousHeader->getHeight()) ? this->headers.getLeaf(previousHeader->getHeight() - i)->getSecondaryScaling() : Consensus::GENESIS_BLOCK_HEADER.getSecondaryScaling();
-			
-			// Check if previous header exists
-			if(i <= previousHeader->getHeight()) {
-			
-				// Check if header before the previous header exists
-				if(i + 1 <= previousHeader->getHeight()) {
-				
-					// Add header's difficulty to the difficulty sum
-					difficultySum += this->headers.getLeaf(previousHeader->getHeight() - i)->getTotalDifficulty() - this->headers.getLeaf(previousHeader->getHeight() - (i + 1))->getTotalDifficulty();
-				}
-				
-				// Otherwise
-				else {
-				
-					// Add header's difficulty to the difficulty sum
-					difficultySum += this->headers.getLeaf(previousHeader->getHeight() - i)->getTotalDifficulty();
-				}
-			}
-			
-			// Otherwise
-			else {
-			
-				// Add header's difficulty to the difficulty sum
-				difficultySum += previousHeader->getTotalDifficulty() - (previousHeader->getHeight() ? this->headers.getLeaf(previousHeader->getHeight() - 1)->getTotalDifficulty() : 0);
-			}
-			
-			// Check if header uses C29 proof of work
-			if(((i <= previousHeader->getHeight()) ? this->headers.getLeaf(previousHeader->getHeight() - i)->getEdgeBits() : Consensus::GENESIS_BLOCK_HEADER.getEdgeBits()) == Consensus::C29_EDGE_BITS) {
-			
-				// Increment the number of C29 headers
-				++numberOfC29Headers;
-			}
-		}
-		
-		// Get target C29 ratio
-		const uint64_t targetC29Ratio = Consensus::getC29ProofOfWorkRatio(header.getHeight());
-		
-		// Get target number of C29 headers
-		const uint64_t targetNumberOfC29Headers = Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * targetC29Ratio;
-		
-		// Get C29 headers adjustment
-		const uint64_t c29HeadersAdjustment = Common::clamp(Common::damp(numberOfC29Headers * 100, targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_DAMP_FACTOR), targetNumberOfC29Headers, Consensus::C29_HEADERS_ADJUSTMENT_CLAMP_FACTOR);
-		
-		// Get target secondary scaling
-		const uint32_t targetSecondaryScaling = max(secondaryScalingSum * targetC29Ratio / max(static_cast<uint64_t>(1), c29HeadersAdjustment), static_cast<uint64_t>(Consensus::MINIMUM_SECONDARY_SCALING));
+		// Get target difficulty and secondary scaling using the difficulty adjustment window
+		const pair targetDifficultyAndSecondaryScaling = difficultyAdjustmentWindow.getTargetDifficultyAndSecondaryScaling(this->headers, *previousHeader, blockHash);
 		
 		// Check if secondary scaling isn't correct
-		if(header.getSecondaryScaling() != targetSecondaryScaling) {
+		if(header.getSecondaryScaling() != targetDifficultyAndSecondaryScaling.second) {
 		
 			// Return false
 			return false;
 		}
 		
-		// Set number of missing headers
-		const uint64_t numberOfMissingHeaders = (previousHeader->getHeight() < Consensus::DIFFICULTY_ADJUSTMENT_WINDOW) ? Consensus::DIFFICULTY_ADJUSTMENT_WINDOW - previousHeader->getHeight() : 0;
-		
-		// Get last timestamp delta
-		const chrono::seconds lastTimestampDelta = (previousHeader->getHeight() != Consensus::GENESIS_BLOCK_HEADER.getHeight()) ? chrono::duration_cast<chrono::seconds>(previousHeader->getTimestamp() - this->headers.getLeaf(previousHeader->getHeight() - 1)->getTimestamp()) : Consensus::BLOCK_TIME;
-		
-		// Initialize window start timestamp
-		chrono::time_point<chrono::system_clock> windowStartTimestamp;
-		
-		// Check if headers are missing from the window
-		if(numberOfMissingHeaders) {
-		
-			// Check if window start timestamp won't underflow
-			if(lastTimestampDelta * numberOfMissingHeaders <= chrono::duration_cast<chrono::seconds>(Consensus::GENESIS_BLOCK_HEADER.getTimestamp().time_since_epoch())) {
-			
-				// Set window start timestamp to the timestamp of the first missing block in the window
-				windowStartTimestamp = Consensus::GENESIS_BLOCK_HEADER.getTimestamp() - lastTimestampDelta * numberOfMissingHeaders;
-			}
-			
-			// Otherwise
-			else {
-			
-				// Set window start timestamp to zero
-				windowStartTimestamp = chrono::time_point<chrono::system_clock>(chrono::seconds(0));
-			}
-		}
-		
-		// Otherwise
-		else {
-		
-			// Set window start timestamp to the timestamp of the first header in the window
-			windowStartTimestamp = this->headers.getLeaf(previousHeader->getHeight() - Consensus::DIFFICULTY_ADJUSTMENT_WINDOW)->getTimestamp();
-		}
-		
-		// Get window duration
-		const chrono::seconds windowDuration = chrono::duration_cast<chrono::seconds>(previousHeader->getTimestamp() - windowStartTimestamp);
-		
-		// Get window duration adjustment
-		const uint64_t windowDurationAdjustment = Common::clamp(Common::damp(windowDuration.count(), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_DAMP_FACTOR), Consensus::DIFFICULTY_ADJUSTMENT_WINDOW * Consensus::BLOCK_TIME.count(), Consensus::WINDOW_DURATION_ADJUSTMENT_CLAMP_FACTOR);
-		
-		// Get target difficulty
-		const uint64_t targetDifficulty = max(Consensus::MINIMUM_DIFFICULTY, difficultySum * Consensus::BLOCK_TIME.count() / windowDurationAdjustment);
-		
 		// Check if difficulty isn't correct
-		if(difficulty != targetDifficulty) {
+		if(difficulty != targetDifficultyAndSecondaryScaling.first) {
 		
 			// Return false
 			return false;
@@ -6177,35 +6410,48 @@ bool Peer::processHeaders(list<Header> &&headers) {
 	return true;
 }
 
-// Process transaction hash set archive
-bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vector<uint8_t>::size_type transactionHashSetArchiveAttachmentIndex, const vector<uint8_t>::size_type transactionHashSetArchiveAttachmentLength, const Header *transactionHashSetArchiveHeader) {
+// Open transaction hash set archive
+unique_ptr<zip_t, decltype(&zip_discard)> Peer::openTransactionHashSetArchive(unique_ptr<FILE, decltype(&fclose)> &&transactionHashSetArchiveFile, const uint64_t transactionHashSetArchiveLength) {
 
-	// Check if creating source from the transaction hash set archive attactment failed
-	unique_ptr<zip_source_t, decltype(&zip_source_free)> source(zip_source_buffer_create(&buffer[transactionHashSetArchiveAttachmentIndex], transactionHashSetArchiveAttachmentLength, 0, nullptr), zip_source_free);
+	// Check if creating source from the transaction hash set archive file failed
+	unique_ptr<zip_source_t, decltype(&zip_source_free)> source(zip_source_filep_create(transactionHashSetArchiveFile.get(), 0, transactionHashSetArchiveLength, nullptr), zip_source_free);
 	if(!source) {
 	
-		// Return false
-		return false;
+		// Return nothing
+		return unique_ptr<zip_t, decltype(&zip_discard)>(nullptr, zip_discard);
 	}
 	
-	// Check if stopping read and write or is closing
-	if(stopReadAndWrite.load() || Common::isClosing()) {
-	
-		// Return true
-		return true;
-	}
+	// Release transaction hash set archive file since it's closed by the source
+	transactionHashSetArchiveFile.release();
 	
 	// Check if opening source as a ZIP archive failed
 	unique_ptr<zip_t, decltype(&zip_discard)> zip(zip_open_from_source(source.get(), ZIP_CHECKCONS | ZIP_RDONLY, nullptr), zip_discard);
 	if(!zip) {
 	
-		// Return false
-		return false;	
+		// Return nothing
+		return zip;
 	}
 	
-	// Release source
+	// Release source since it's freed by the ZIP archive
 	source.release();
 	
+	// Return ZIP archive
+	return zip;
+}
+
+// Process transaction hash set archive
+bool Peer::processTransactionHashSetArchive(unique_ptr<FILE, decltype(&fclose)> &&kernelsFile, unique_ptr<FILE, decltype(&fclose)> &&outputsFile, unique_ptr<FILE, decltype(&fclose)> &&rangeproofsFile, const uint64_t transactionHashSetArchiveLength, const Header *transactionHashSetArchiveHeader) {
+
+	// Check if opening the transaction hash set archive for the kernels, outputs, and rangeproofs failed
+	unique_ptr kernelsZip = openTransactionHashSetArchive(move(kernelsFile), transactionHashSetArchiveLength);
+	unique_ptr outputsZip = openTransactionHashSetArchive(move(outputsFile), transactionHashSetArchiveLength);
+	unique_ptr rangeproofsZip = openTransactionHashSetArchive(move(rangeproofsFile), transactionHashSetArchiveLength);
+	if(!kernelsZip || !outputsZip || !rangeproofsZip) {
+	
+		// Return false
+		return false;
+	}
+	
 	// Check if stopping read and write or is closing
 	if(stopReadAndWrite.load() || Common::isClosing()) {
 	
@@ -6213,14 +6459,30 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		return true;
 	}
 	
-	// Initialize kernels
+	// Get short block hash from the transaction hash set archive header's block hash
+	const string shortBlockHash = Common::toHexString(transactionHashSetArchiveHeader->getBlockHash().data(), SHORT_BLOCK_HASH_LENGTH);
+	
+	// Get outputs and rangeproofs leaf set paths
+	const string outputsLeafSetPath = "output/pmmr_leaf.bin." + shortBlockHash;
+	const string rangeproofsLeafSetPath = "rangeproof/pmmr_leaf.bin." + shortBlockHash;
+	
+	// Initialize kernels, outputs, and rangeproofs
 	MerkleMountainRange<Kernel> kernels;
+	MerkleMountainRange<Output> outputs;
+	MerkleMountainRange<Rangeproof> rangeproofs;
 	
 	// Try
 	try {
 	
-		// Read kernels from the ZIP archive
-		kernels = MerkleMountainRange<Kernel>::createFromZip(zip.get(), protocolVersion, "kernel/pmmr_data.bin", "kernel/pmmr_hash.bin");
+		// Create operations to read the kernels, outputs, and rangeproofs from their ZIP archives concurrently
+		future kernelsOperation = async(launch::async | launch::deferred, &MerkleMountainRange<Kernel>::createFromZip, kernelsZip.get(), protocolVersion, "kernel/pmmr_data.bin", "kernel/pmmr_hash.bin", nullptr, nullptr);
+		future outputsOperation = async(launch::async | launch::deferred, &MerkleMountainRange<Output>::createFromZip, outputsZip.get(), protocolVersion, "output/pmmr_data.bin", "output/pmmr_hash.bin", "output/pmmr_prun.bin", outputsLeafSetPath.c_str());
+		future rangeproofsOperation = async(launch::async | launch::deferred, &MerkleMountainRange<Rangeproof>::createFromZip, rangeproofsZip.get(), protocolVersion, "rangeproof/pmmr_data.bin", "rangeproof/pmmr_hash.bin", "rangeproof/pmmr_prun.bin", rangeproofsLeafSetPath.c_str());
+		
+		// Get kernels, outputs, and rangeproofs from their operations
+		kernels = kernelsOperation.get();
+		outputs = outputsOperation.get();
+		rangeproofs = rangeproofsOperation.get();
 		
 		// Check if stopping read and write or is closing
 		if(stopReadAndWrite.load() || Common::isClosing()) {
@@ -6233,6 +6495,10 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		kernels.rewindToSize(transactionHashSetArchiveHeader->getKernelMerkleMountainRangeSize());
 		
 		// mwc-node doesn't check existing kernels' coinbase maturity, lock height, and NRD header version https://github.com/mwcproject/mwc-node/blob/master/chain/src/chain.rs#L1459
+		
+		// Rewind outputs and rangeproofs to the transaction hash set archive header
+		outputs.rewindToSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
+		rangeproofs.rewindToSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
 	}
 	
 	// Catch errors
@@ -6242,6 +6508,11 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		return false;
 	}
 	
+	// Free the ZIP archives
+	kernelsZip.reset();
+	outputsZip.reset();
+	rangeproofsZip.reset();
+	
 	// Check if stopping read and write or is closing
 	if(stopReadAndWrite.load() || Common::isClosing()) {
 	
@@ -6249,6 +6520,9 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		return true;
 	}
 	
+	// Initialize kernel root headers
+	vector<const Header *> kernelRootHeaders;
+	
 	// Go through all headers from the transaction hash set archive header to the genesis block header while not stopping read and write and not closing
 	for(uint64_t i = transactionHashSetArchiveHeader->getHeight(); i > 0 && !stopReadAndWrite.load() && !Common::isClosing(); --i) {
 	
@@ -6256,13 +6530,8 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		const Header *header = headers.getLeaf(i);
 		if(header) {
 		
-			// Check if header's kernel root is invalid
-			const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> kernelRoot = kernels.getRootAtSize(header->getKernelMerkleMountainRangeSize());
-			if(memcmp(header->getKernelRoot(), kernelRoot.data(), kernelRoot.size())) {
-			
-				// Return false
-				return false;
-			}
+			// Append header to list
+			kernelRootHeaders.push_back(header);
 		}
 		
 		// Otherwise
@@ -6273,66 +6542,64 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		}
 	}
 	
-	// Check if stopping read and write or is closing
-	if(stopReadAndWrite.load() || Common::isClosing()) {
-	
-		// Return true
-		return true;
-	}
+	// Order kernel root headers by ascending height so that their kernel roots can be computed in a single sweep
+	reverse(kernelRootHeaders.begin(), kernelRootHeaders.end());
 	
-	// TODO NRD check for floonet
+	// Set next header index to the first kernel root header
+	atomic_size_t nextHeaderIndex(0);
 	
-	// Get short block hash from the transaction hash set archive header's block hash
-	const string shortBlockHash = Common::toHexString(transactionHashSetArchiveHeader->getBlockHash().data(), SHORT_BLOCK_HASH_LENGTH);
-
-	// Initialize outputs and rangeproofs
-	MerkleMountainRange<Output> outputs;
-	MerkleMountainRange<Rangeproof> rangeproofs;
+	// Set kernel roots invalid to false
+	atomic_bool kernelRootsInvalid(false);
 	
-	// Try
-	try {
+	// Go through all additional verification threads
+	list<future<bool>> kernelRootsVerificationOperations;
+	for(unsigned int i = 1; i < node->getNumberOfVerificationThreads() && i * KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE < kernelRootHeaders.size(); ++i) {
 	
-		// Read outputs from the ZIP archive
-		outputs = MerkleMountainRange<Output>::createFromZip(zip.get(), protocolVersion, "output/pmmr_data.bin", "output/pmmr_hash.bin", "output/pmmr_prun.bin", ("output/pmmr_leaf.bin." + shortBlockHash).c_str());
-		
-		// Check if stopping read and write or is closing
-		if(stopReadAndWrite.load() || Common::isClosing()) {
+		// Try
+		try {
 		
-			// Return true
-			return true;
+			// Create verification operation to verify kernel roots
+			kernelRootsVerificationOperations.push_back(async(launch::async, &Peer::verifyKernelRoots, this, cref(kernels), cref(kernelRootHeaders), ref(nextHeaderIndex), ref(kernelRootsInvalid)));
 		}
 		
-		// Rewind outputs to the transaction hash set archive header
-		outputs.rewindToSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
-		
-		// Check if stopping read and write or is closing
-		if(stopReadAndWrite.load() || Common::isClosing()) {
+		// Catch errors
+		catch(...) {
 		
-			// Return true
-			return true;
+			// Break
+			break;
 		}
+	}
+	
+	// Verify kernel roots in this thread
+	bool kernelRootsValid = verifyKernelRoots(kernels, kernelRootHeaders, nextHeaderIndex, kernelRootsInvalid);
+	
+	// Go through all kernel roots verification operations
+	for(future<bool> &kernelRootsVerificationOperation : kernelRootsVerificationOperations) {
+	
+		// Check if verifying kernel roots failed
+		if(!kernelRootsVerificationOperation.get()) {
 		
-		// Read rangeproofs from the ZIP archive
-		rangeproofs = MerkleMountainRange<Rangeproof>::createFromZip(zip.get(), protocolVersion, "rangeproof/pmmr_data.bin", "rangeproof/pmmr_hash.bin", "rangeproof/pmmr_prun.bin", ("rangeproof/pmmr_leaf.bin." + shortBlockHash).c_str());
-		
-		// Check if stopping read and write or is closing
-		if(stopReadAndWrite.load() || Common::isClosing()) {
-		
-			// Return true
-			return true;
+			// Set kernel roots valid to false
+			kernelRootsValid = false;
 		}
-		
-		// Rewind rangeproofs to the transaction hash set archive header
-		rangeproofs.rewindToSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
 	}
 	
-	// Catch errors
-	catch(...) {
+	// Check if stopping read and write or is closing
+	if(stopReadAndWrite.load() || Common::isClosing()) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if kernel roots aren't valid
+	if(!kernelRootsValid) {
 	
 		// Return false
 		return false;
 	}
 	
+	// TODO NRD check for floonet
+	
 	// Check if stopping read and write or is closing
 	if(stopReadAndWrite.load() || Common::isClosing()) {
 	
@@ -6370,29 +6637,40 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		return true;
 	}
 	
-	// Go through all outputs while not stopping read and write and not closing
-	for(uint64_t i = 0; i < outputs.getNumberOfLeaves() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
+	// Initialize next leaf index and rangeproofs invalid
+	atomic_uint64_t nextLeafIndex(0);
+	atomic_bool rangeproofsInvalid(false);
 	
-		// Get output and rangeproof
-		const Output *output = outputs.getLeaf(i);
-		const Rangeproof *rangeproof = rangeproofs.getLeaf(i);
+	// Go through all additional verification threads
+	list<future<bool>> verificationOperations;
+	for(unsigned int i = 1; i < node->getNumberOfVerificationThreads(); ++i) {
 	
-		// Check if output doesn't have a rangeproof or rangeproof doesn't have an output
-		if(static_cast<bool>(output) != static_cast<bool>(rangeproof)) {
+		// Try
+		try {
 		
-			// Return false
-			return false;
+			// Create verification operation to verify rangeproofs
+			verificationOperations.push_back(async(launch::async, &Peer::verifyRangeproofs, this, cref(outputs), cref(rangeproofs), ref(nextLeafIndex), ref(rangeproofsInvalid)));
 		}
 		
-		// Check if output exists
-		if(output) {
+		// Catch errors
+		catch(...) {
 		
-			// Check if rangeproof is invalid
-			if(!secp256k1_bulletproof_rangeproof_verify(Crypto::getSecp256k1Context(), Crypto::getSecp256k1ScratchSpace(), Crypto::getSecp256k1Generators(), rangeproof->getProof(), rangeproof->getLength(), nullptr, &output->getCommitment(), 1, sizeof(uint64_t) * Common::BITS_IN_A_BYTE, &secp256k1_generator_const_h, nullptr, 0)) {
-			
-				// Return false
-				return false;
-			}
+			// Break
+			break;
+		}
+	}
+	
+	// Verify rangeproofs in this thread
+	bool rangeproofsValid = verifyRangeproofs(outputs, rangeproofs, nextLeafIndex, rangeproofsInvalid);
+	
+	// Go through all verification operations
+	for(future<bool> &verificationOperation : verificationOperations) {
+	
+		// Check if verifying rangeproofs failed
+		if(!verificationOperation.get()) {
+		
+			// Set rangeproofs valid to false
+			rangeproofsValid = false;
 		}
 	}
 	
@@ -6403,6 +6681,13 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 		return true;
 	}
 	
+	// Check if rangeproofs aren't valid
+	if(!rangeproofsValid) {
+	
+		// Return false
+		return false;
+	}
+	
 	// Set outputs and rangeproofs minimum size to the transaction hash set archive header
 	outputs.setMinimumSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
 	rangeproofs.setMinimumSize(transactionHashSetArchiveHeader->getOutputMerkleMountainRangeSize());
@@ -6469,6 +6754,198 @@ bool Peer::processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vect
 	return true;
 }
 
+// Verify kernel roots
+bool Peer::verifyKernelRoots(const MerkleMountainRange<Kernel> &kernels, const vector<const Header *> &headers, atomic_size_t &nextHeaderIndex, atomic_bool &kernelRootsInvalid) {
+
+	// Initialize chunk sizes
+	vector<uint64_t> chunkSizes;
+	chunkSizes.reserve(KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE);
+	
+	// Loop while not stopping read and write, not closing, and kernel roots aren't invalid
+	while(!stopReadAndWrite.load() && !Common::isClosing() && !kernelRootsInvalid.load()) {
+	
+		// Get the next chunk's start header index
+		const vector<const Header *>::size_type chunkStartHeaderIndex = nextHeaderIndex.fetch_add(KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE);
+		
+		// Check if there's no more chunks
+		if(chunkStartHeaderIndex >= headers.size()) {
+		
+			// Break
+			break;
+		}
+		
+		// Get the chunk's end header index
+		const vector<const Header *>::size_type chunkEndHeaderIndex = min(chunkStartHeaderIndex + KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE, headers.size());
+		
+		// Clear chunk sizes
+		chunkSizes.clear();
+		
+		// Go through all headers in the chunk
+		for(vector<const Header *>::size_type i = chunkStartHeaderIndex; i < chunkEndHeaderIndex; ++i) {
+		
+			// Append header's kernel Merkle mountain range size to list
+			chunkSizes.push_back(headers[i]->getKernelMerkleMountainRangeSize());
+		}
+		
+		// Initialize kernel roots
+		vector<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> kernelRoots;
+		
+		// Try
+		try {
+		
+			// Get kernel roots at the chunk's sizes
+			kernelRoots = kernels.getRootsAtSizes(chunkSizes);
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+			// Set kernel roots invalid to true
+			kernelRootsInvalid.store(true);
+			
+			// Return false
+			return false;
+		}
+		
+		// Go through all headers in the chunk
+		for(vector<const Header *>::size_type i = chunkStartHeaderIndex; i < chunkEndHeaderIndex; ++i) {
+		
+			// Check if header's kernel root is invalid
+			if(memcmp(headers[i]->getKernelRoot(), kernelRoots[i - chunkStartHeaderIndex].data(), Crypto::BLAKE2B_HASH_LENGTH)) {
+			
+				// Set kernel roots invalid to true
+				kernelRootsInvalid.store(true);
+				
+				// Return false
+				return false;
+			}
+		}
+	}
+	
+	// Return true
+	return true;
+}
+
+// Verify proof of work
+bool Peer::verifyProofOfWork(const vector<const Header *> &headers, atomic_size_t &nextHeaderIndex, atomic_bool &proofOfWorkInvalid) {
+
+	// Loop while not stopping read and write, not closing, and proof of work isn't invalid
+	while(!stopReadAndWrite.load() && !Common::isClosing() && !proofOfWorkInvalid.load()) {
+	
+		// Get the next chunk's start header index
+		const vector<const Header *>::size_type chunkStartHeaderIndex = nextHeaderIndex.fetch_add(PROOF_OF_WORK_VERIFICATION_CHUNK_SIZE);
+		
+		// Check if there's no more chunks
+		if(chunkStartHeaderIndex >= headers.size()) {
+		
+			// Break
+			break;
+		}
+		
+		// Get the chunk's end header index
+		const vector<const Header *>::size_type chunkEndHeaderIndex = min(chunkStartHeaderIndex + PROOF_OF_WORK_VERIFICATION_CHUNK_SIZE, headers.size());
+		
+		// Go through all headers in the chunk
+		for(vector<const Header *>::size_type i = chunkStartHeaderIndex; i < chunkEndHeaderIndex; ++i) {
+		
+			// Check if header's proof of work is invalid
+			if(headers[i]->getHeight() != Consensus::GENESIS_BLOCK_HEADER.getHeight() && !ProofOfWork::hasValidProofOfWork(*headers[i])) {
+			
+				// Set proof of work invalid to true
+				proofOfWorkInvalid.store(true);
+				
+				// Return false
+				return false;
+			}
+		}
+	}
+	
+	// Return true
+	return true;
+}
+
+// Verify rangeproofs
+bool Peer::verifyRangeproofs(const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, atomic_uint64_t &nextLeafIndex, atomic_bool &rangeproofsInvalid) {
+
+	// Initialize batch commitments and proofs
+	vector<const secp256k1_pedersen_commitment *> batchCommitments;
+	vector<const uint8_t *> batchProofs;
+	batchCommitments.reserve(Crypto::BULLETPROOFS_BATCH_SIZE);
+	batchProofs.reserve(Crypto::BULLETPROOFS_BATCH_SIZE);
+	
+	// Loop while not stopping read and write, not closing, and rangeproofs aren't invalid
+	while(!stopReadAndWrite.load() && !Common::isClosing() && !rangeproofsInvalid.load()) {
+	
+		// Get the next chunk's start leaf index
+		const uint64_t chunkStartLeafIndex = nextLeafIndex.fetch_add(RANGEPROOFS_VERIFICATION_CHUNK_SIZE);
+		
+		// Check if there's no more chunks
+		if(chunkStartLeafIndex >= outputs.getNumberOfLeaves()) {
+		
+			// Break
+			break;
+		}
+		
+		// Get the chunk's end leaf index
+		const uint64_t chunkEndLeafIndex = min(chunkStartLeafIndex + RANGEPROOFS_VERIFICATION_CHUNK_SIZE, outputs.getNumberOfLeaves());
+		
+		// Go through all outputs in the chunk while not stopping read and write, not closing, and rangeproofs aren't invalid
+		for(uint64_t i = chunkStartLeafIndex; i < chunkEndLeafIndex && !stopReadAndWrite.load() && !Common::isClosing() && !rangeproofsInvalid.load(); ++i) {
+		
+			// Get output and rangeproof
+			const Output *output = outputs.getLeaf(i);
+			const Rangeproof *rangeproof = rangeproofs.getLeaf(i);
+		
+			// Check if output doesn't have a rangeproof or rangeproof doesn't have an output
+			if(static_cast<bool>(output) != static_cast<bool>(rangeproof)) {
+			
+				// Set rangeproofs invalid to true
+				rangeproofsInvalid.store(true);
+				
+				// Return false
+				return false;
+			}
+			
+			// Check if output exists
+			if(output) {
+			
+				// Add output's commitment and rangeproof's proof to the batch
+				batchCommitments.push_back(&output->getCommitment());
+				batchProofs.push_back(rangeproof->getProof());
+			}
+			
+			// Check if batch is full or it's the last output in the chunk and the batch isn't empty
+			if(batchProofs.size() == Crypto::BULLETPROOFS_BATCH_SIZE || (i == chunkEndLeafIndex - 1 && !batchProofs.empty())) {
+			
+				// Check if verifying the batch's rangeproofs together failed
+				if(!Crypto::verifyBulletproofs(batchCommitments.data(), batchProofs.data(), batchProofs.size())) {
+				
+					// Go through all rangeproofs in the batch
+					for(vector<const uint8_t *>::size_type j = 0; j < batchProofs.size(); ++j) {
+					
+						// Check if rangeproof is invalid
+						if(!Crypto::verifyBulletproof(*batchCommitments[j], batchProofs[j])) {
+						
+							// Set rangeproofs invalid to true
+							rangeproofsInvalid.store(true);
+							
+							// Return false
+							return false;
+						}
+					}
+				}
+				
+				// Clear batch commitments and proofs
+				batchCommitments.clear();
+				batchProofs.clear();
+			}
+		}
+	}
+	
+	// Return true
+	return true;
+}
+
 // Process block
 bool Peer::processBlock(vector<uint8_t > &&buffer) {
 
@@ -6538,7 +7015,7 @@ bool Peer::processBlock(vector<uint8_t > &&buffer) {
 	vector<const secp256k1_pedersen_commitment *> inputCommitments;
 	
 	// Go through all of the block's inputs while not stopping read and write and not closing
-	for(list<Input>::const_iterator i = block.getInputs().cbegin(); i != block.getInputs().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
+	for(vector<Input>::const_iterator i = block.getInputs().cbegin(); i != block.getInputs().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
 	
 		// Get input
 		const Input &input = *i;
@@ -6561,7 +7038,7 @@ bool Peer::processBlock(vector<uint8_t > &&buffer) {
 	vector<const secp256k1_pedersen_commitment *> outputCommitments;
 	
 	// Go through all of the block's outputs while not stopping read and write and not closing
-	for(list<Output>::const_iterator i = block.getOutputs().cbegin(); i != block.getOutputs().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
+	for(vector<Output>::const_iterator i = block.getOutputs().cbegin(); i != block.getOutputs().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
 	
 		// Get output
 		const Output &output = *i;
@@ -6601,7 +7078,7 @@ bool Peer::processBlock(vector<uint8_t > &&buffer) {
 	vector<const secp256k1_pedersen_commitment *> kernelExcesses;
 	
 	// Go through all of the block's kernels while not stopping read and write and not closing
-	for(list<Kernel>::const_iterator i = block.getKernels().cbegin(); i != block.getKernels().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
+	for(vector<Kernel>::const_iterator i = block.getKernels().cbegin(); i != block.getKernels().cend() && !stopReadAndWrite.load() && !Common::isClosing(); ++i) {
 	
 		// Get Kernel
 		const Kernel &kernel = *i;
@@ -7023,7 +7500,7 @@ bool Peer::processBlock(vector<uint8_t > &&buffer) {
 			if(useNodeHeaders) {
 			
 				// Check if updating node's sync state failed
-				if(!node->updateSyncState(syncedHeaderIndex + 1, block)) {
+				if(!node->updateSyncState(syncedHeaderIndex + 1, move(get<1>(blockComponents.value())))) {
 				
 					// Return false
 					return false;
@@ -7034,7 +7511,7 @@ bool Peer::processBlock(vector<uint8_t > &&buffer) {
 			else {
 			
 				// Check if updating node's sync state failed
-				if(!node->updateSyncState(move(headers), syncedHeaderIndex + 1, block)) {
+				if(!node->updateSyncState(move(headers), syncedHeaderIndex + 1, move(get<1>(blockComponents.value())))) {
 				
 					// Return false
 					return false;
@@ -5,7 +5,9 @@
 
 // Header files
 #include "./common.h"
+#include <cstdio>
 #include <future>
+#include "./message_buffer.h"
 #include "./node.h"
 
 // Check if not Windows
@@ -144,6 +146,12 @@ class Peer final {
 		// Start syncing
 		void startSyncing(const MerkleMountainRange<Header> &headers, const uint64_t syncedHeaderIndex);
 		
+		// Start syncing
+		void startSyncing(const uint64_t syncedHeaderIndex, vector<uint8_t> &&blockMessage);
+		
+		// Request block
+		bool requestBlock(const uint64_t height, const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &blockHash);
+		
 		// Get headers
 		MerkleMountainRange<Header> &getHeaders();
 		
@@ -222,6 +230,9 @@ class Peer final {
 		// Get transaction hash set attachment required duration
 		static const chrono::minutes GET_TRANSACTION_HASH_SET_ATTACHMENT_REQUIRED_DURATION;
 		
+		// Transaction hash set archive file name prefix
+		static const char TRANSACTION_HASH_SET_ARCHIVE_FILE_NAME_PREFIX[];
+		
 		// Get block response required duration
 		static const chrono::minutes GET_BLOCK_RESPONSE_REQUIRED_DURATION;
 		
@@ -234,6 +245,15 @@ class Peer final {
 		// Before disconnect delay duration
 		static const chrono::milliseconds BEFORE_DISCONNECT_DELAY_DURATION;
 		
+		// Kernel roots verification chunk size
+		static const vector<const Header *>::size_type KERNEL_ROOTS_VERIFICATION_CHUNK_SIZE;
+		
+		// Rangeproofs verification chunk size
+		static const uint64_t RANGEPROOFS_VERIFICATION_CHUNK_SIZE;
+		
+		// Proof of work verification chunk size
+		static const vector<const Header *>::size_type PROOF_OF_WORK_VERIFICATION_CHUNK_SIZE;
+		
 		// Connect outbound
 		void connectOutbound(const string address);
 		
@@ -253,10 +273,22 @@ class Peer final {
 		list<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>> getLocatorHeadersBlockHashes() const;
 		
 		// Process header
-		bool processHeaders(list<Header> &&headers);
+		bool processHeaders(vector<Header> &&headers);
+		
+		// Verify proof of work
+		bool verifyProofOfWork(const vector<const Header *> &headers, atomic_size_t &nextHeaderIndex, atomic_bool &proofOfWorkInvalid);
+		
+		// Open transaction hash set archive
+		static unique_ptr<zip_t, decltype(&zip_discard)> openTransactionHashSetArchive(unique_ptr<FILE, decltype(&fclose)> &&transactionHashSetArchiveFile, const uint64_t transactionHashSetArchiveLength);
 		
 		// Process transaction hash set archive
-		bool processTransactionHashSetArchive(vector<uint8_t> &&buffer, const vector<uint8_t>::size_type transactionHashSetArchiveAttachmentIndex, const vector<uint8_t>::size_type transactionHashSetArchiveAttachmentLength, const Header *transactionHashSetArchiveHeader);
+		bool processTransactionHashSetArchive(unique_ptr<FILE, decltype(&fclose)> &&kernelsFile, unique_ptr<FILE, decltype(&fclose)> &&outputsFile, unique_ptr<FILE, decltype(&fclose)> &&rangeproofsFile, const uint64_t transactionHashSetArchiveLength, const Header *transactionHashSetArchiveHeader);
+		
+		// Verify kernel roots
+		bool verifyKernelRoots(const MerkleMountainRange<Kernel> &kernels, const vector<const Header *> &headers, atomic_size_t &nextHeaderIndex, atomic_bool &kernelRootsInvalid);
+		
+		// Verify rangeproofs
+		bool verifyRangeproofs(const MerkleMountainRange<Output> &outputs, const MerkleMountainRange<Rangeproof> &rangeproofs, atomic_uint64_t &nextLeafIndex, atomic_bool &rangeproofsInvalid);
 		
 		// Process block
 		bool processBlock(vector<uint8_t> &&buffer);
@@ -287,10 +319,10 @@ class Peer final {
 		#endif
 		
 		// Read buffer
-		vector<uint8_t> readBuffer;
+		MessageBuffer readBuffer;
 		
 		// Write buffer
-		vector<uint8_t> writeBuffer;
+		MessageBuffer writeBuffer;
 		
 		// Node
 		Node *node;
@@ -316,6 +348,9 @@ class Peer final {
 		// Headers
 		MerkleMountainRange<Header> headers;
 		
+		// Difficulty adjustment window
+		DifficultyAdjustmentWindow difficultyAdjustmentWindow;
+		
 		// Use node headers
 		bool useNodeHeaders;
 		
@@ -337,12 +372,36 @@ class Peer final {
 		// Current sync response required time
 		optional<chrono::time_point<chrono::steady_clock>> currentSyncResponseRequiredTime;
 		
+		// Requested blocks
+		unordered_map<uint64_t, pair<array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH>, chrono::time_point<chrono::steady_clock>>> requestedBlocks;
+		
+		// Downloaded block
+		optional<vector<uint8_t>> downloadedBlock;
+		
 		// Number of reorgs during headers sync
 		int numberOfReorgsDuringHeadersSync;
 		
 		// Transaction hash set response received
 		bool transactionHashSetResponseReceived;
 		
+		// Transaction hash set archive file
+		unique_ptr<FILE, decltype(&fclose)> transactionHashSetArchiveFile;
+		
+		// Transaction hash set archive outputs file
+		unique_ptr<FILE, decltype(&fclose)> transactionHashSetArchiveOutputsFile;
+		
+		// Transaction hash set archive rangeproofs file
+		unique_ptr<FILE, decltype(&fclose)> transactionHashSetArchiveRangeproofsFile;
+		
+		// Transaction hash set archive file length
+		uint64_t transactionHashSetArchiveFileLength;
+		
+		// Transaction hash set archive file remaining length
+		uint64_t transactionHashSetArchiveFileRemainingLength;
+		
+		// Transaction hash set archive file header
+		const Header *transactionHashSetArchiveFileHeader;
+		
 		// Number of reorgs during block sync
 		int numberOfReorgsDuringBlockSync;
 		
@@ -3,8 +3,16 @@
 #include <bit>
 #include "blake2.h"
 #include "./consensus.h"
+#include <limits>
 #include "./proof_of_work.h"
 
+// Check if x86-64 and GCC compatible compiler
+#if defined __x86_64__ && defined __GNUC__
+
+	// Header files
+	#include <immintrin.h>
+#endif
+
 using namespace std;
 
 
@@ -29,6 +37,15 @@ const uint8_t ProofOfWork::SIPHASH_DEFAULT_ROTATION = 21;
 // C29 SipHash rotation
 const uint8_t ProofOfWork::C29_SIPHASH_ROTATION = 25;
 
+// SipHash self-check keys
+const uint64_t ProofOfWork::SIPHASH_SELF_CHECK_KEYS[ProofOfWork::SIPHASH_KEYS_LENGTH] = {0x0706050403020100, 0x0F0E0D0C0B0A0908, 0x1716151413121110, 0x1F1E1D1C1B1A1918};
+
+// SipHash self-check nonces
+const uint64_t ProofOfWork::SIPHASH_SELF_CHECK_NONCES[] = {0, 1, 2, 31, 62, 63, 64, 65, 0x1FFFFFFF, 0x123456789ABCDEF0, UINT64_MAX};
+
+// SipHash implementation
+atomic<ProofOfWork::SipHashImplementation> ProofOfWork::sipHashImplementation = ProofOfWork::getBestSipHashImplementation();
+
 
 // Supporting function implementation
 
@@ -42,6 +59,30 @@ bool ProofOfWork::hasValidProofOfWork(const Header &header) {
 	return hasValidProofOfWork(hash, header.getEdgeBits(), header.getProofNonces());
 }
 
+// Get SipHash implementation
+ProofOfWork::SipHashImplementation ProofOfWork::getSipHashImplementation() {
+
+	// Return SipHash implementation
+	return sipHashImplementation.load();
+}
+
+// Set SipHash implementation
+bool ProofOfWork::setSipHashImplementation(const SipHashImplementation implementation) {
+
+	// Check if implementation isn't supported
+	if(!isSipHashImplementationSupported(implementation)) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Set SipHash implementation to the implementation
+	sipHashImplementation.store(implementation);
+	
+	// Return true
+	return true;
+}
+
 // Has valid proof of work
 bool ProofOfWork::hasValidProofOfWork(const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &proofOfWorkHash, const uint8_t edgeBits, const uint64_t proofNonces[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES]) {
 
@@ -80,6 +121,10 @@ bool ProofOfWork::hasValidProofOfWork(const array<uint8_t, Crypto::BLAKE2B_HASH_
 		uint64_t xor0 = 0;
 		uint64_t xor1 = 0;
 		
+		// Get edges for all of the proof nonces
+		uint64_t edges[Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES];
+		sipHashBlocks(sipHashKeys, proofNonces, Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES, C29_SIPHASH_ROTATION, edges, getSipHashImplementation());
+		
 		// Go through all of the proof nonces
 		for(uint64_t i = 0; i < Crypto::CUCKOO_CYCLE_NUMBER_OF_PROOF_NONCES; ++i) {
 		
@@ -108,7 +153,7 @@ bool ProofOfWork::hasValidProofOfWork(const array<uint8_t, Crypto::BLAKE2B_HASH_
 			}
 			
 			// Get edge
-			const uint64_t edge = sipHashBlock(sipHashKeys, proofNonces[i], C29_SIPHASH_ROTATION);
+			const uint64_t edge = edges[i];
 			
 			// Get index
 			const uint64_t index = 4 * ndir[dir] + 2 * dir;
@@ -426,6 +471,323 @@ uint64_t ProofOfWork::sipHashBlock(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGT
 	return block;
 }
 
+// SipHash blocks
+void ProofOfWork::sipHashBlocks(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[], const size_t numberOfNonces, const uint8_t rotation, uint64_t blocks[], const SipHashImplementation implementation) {
+
+	// Check if x86-64 and GCC compatible compiler
+	#if defined __x86_64__ && defined __GNUC__
+	
+		// Check if using the AVX-512 implementation
+		if(implementation == SipHashImplementation::AVX512) {
+		
+			// Go through all nonces eight at a time
+			for(size_t i = 0; i < numberOfNonces; i += SIPHASH_AVX512_LANES) {
+			
+				// Go through all lanes
+				uint64_t laneNonces[SIPHASH_AVX512_LANES];
+				for(size_t j = 0; j < SIPHASH_AVX512_LANES; ++j) {
+				
+					// Set lane's nonce to the nonce or the last nonce if the lane is unused
+					laneNonces[j] = nonces[min(i + j, numberOfNonces - 1)];
+				}
+				
+				// Get the lanes' blocks
+				uint64_t laneBlocks[SIPHASH_AVX512_LANES];
+				sipHashBlocksAvx512(sipHashKeys, laneNonces, rotation, laneBlocks);
+				
+				// Go through all used lanes
+				for(size_t j = 0; j < SIPHASH_AVX512_LANES && i + j < numberOfNonces; ++j) {
+				
+					// Set block to the lane's block
+					blocks[i + j] = laneBlocks[j];
+				}
+			}
+			
+			// Return
+			return;
+		}
+		
+		// Check if using the AVX2 implementation
+		if(implementation == SipHashImplementation::AVX2) {
+		
+			// Go through all nonces four at a time
+			for(size_t i = 0; i < numberOfNonces; i += SIPHASH_AVX2_LANES) {
+			
+				// Go through all lanes
+				uint64_t laneNonces[SIPHASH_AVX2_LANES];
+				for(size_t j = 0; j < SIPHASH_AVX2_LANES; ++j) {
+				
+					// Set lane's nonce to the nonce or the last nonce if the lane is unused
+					laneNonces[j] = nonces[min(i + j, numberOfNonces - 1)];
+				}
+				
+				// Get the lanes' blocks
+				uint64_t laneBlocks[SIPHASH_AVX2_LANES];
+				sipHashBlocksAvx2(sipHashKeys, laneNonces, rotation, laneBlocks);
+				
+				// Go through all used lanes
+				for(size_t j = 0; j < SIPHASH_AVX2_LANES && i + j < numberOfNonces; ++j) {
+				
+					// Set block to the lane's block
+					blocks[i + j] = laneBlocks[j];
+				}
+			}
+			
+			// Return
+			return;
+		}
+	#endif
+	
+	// Go through all nonces
+	for(size_t i = 0; i < numberOfNonces; ++i) {
+	
+		// Set block to the nonce's SipHash block
+		blocks[i] = sipHashBlock(sipHashKeys, nonces[i], rotation);
+	}
+}
+
+// Is SipHash implementation supported
+bool ProofOfWork::isSipHashImplementationSupported(const SipHashImplementation implementation) {
+
+	// Check if implementation is scalar
+	if(implementation == SipHashImplementation::SCALAR) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if x86-64 and GCC compatible compiler
+	#if defined __x86_64__ && defined __GNUC__
+	
+		// Initialize CPU features since this can run before constructors
+		__builtin_cpu_init();
+		
+		// Check if CPU doesn't support the implementation
+		if((implementation == SipHashImplementation::AVX2 && !__builtin_cpu_supports("avx2")) || (implementation == SipHashImplementation::AVX512 && !__builtin_cpu_supports("avx512f"))) {
+		
+			// Return false
+			return false;
+		}
+		
+		// Go through all rotations
+		for(const uint8_t rotation : {SIPHASH_DEFAULT_ROTATION, C29_SIPHASH_ROTATION}) {
+		
+			// Get the self-check nonces' blocks with the implementation
+			uint64_t blocks[sizeof(SIPHASH_SELF_CHECK_NONCES) / sizeof(SIPHASH_SELF_CHECK_NONCES[0])];
+			sipHashBlocks(SIPHASH_SELF_CHECK_KEYS, SIPHASH_SELF_CHECK_NONCES, sizeof(blocks) / sizeof(blocks[0]), rotation, blocks, implementation);
+			
+			// Go through all self-check nonces
+			for(size_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); ++i) {
+			
+				// Check if the implementation's block isn't the scalar block
+				if(blocks[i] != sipHashBlock(SIPHASH_SELF_CHECK_KEYS, SIPHASH_SELF_CHECK_NONCES[i], rotation)) {
+				
+					// Return false
+					return false;
+				}
+			}
+		}
+		
+		// Return true
+		return true;
+	
+	// Otherwise
+	#else
+	
+		// Return false
+		return false;
+	#endif
+}
+
+// Get best SipHash implementation
+ProofOfWork::SipHashImplementation ProofOfWork::getBestSipHashImplementation() {
+
+	// Check if AVX-512 implementation is supported
+	if(isSipHashImplementationSupported(SipHashImplementation::AVX512)) {
+	
+		// Return AVX-512 implementation
+		return SipHashImplementation::AVX512;
+	}
+	
+	// Check if AVX2 implementation is supported
+	if(isSipHashImplementationSupported(SipHashImplementation::AVX2)) {
+	
+		// Return AVX2 implementation
+		return SipHashImplementation::AVX2;
+	}
+	
+	// Return scalar implementation
+	return SipHashImplementation::SCALAR;
+}
+
+// Check if x86-64 and GCC compatible compiler
+#if defined __x86_64__ && defined __GNUC__
+
+	// SipHash blocks AVX2
+	__attribute__((target("avx2"))) void ProofOfWork::sipHashBlocksAvx2(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[SIPHASH_AVX2_LANES], const uint8_t rotation, uint64_t blocks[SIPHASH_AVX2_LANES]) {
+	
+		// Set rotation counts
+		const __m128i rotationCount = _mm_cvtsi32_si128(rotation);
+		const __m128i inverseRotationCount = _mm_cvtsi32_si128(numeric_limits<uint64_t>::digits - rotation);
+		
+		// Set lanes' starting nonces and indices
+		const __m256i laneNonces = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(nonces));
+		const __m256i startingNonces = _mm256_andnot_si256(_mm256_set1_epi64x(SIPHASH_BLOCK_MASK), laneNonces);
+		const __m256i indices = _mm256_and_si256(laneNonces, _mm256_set1_epi64x(SIPHASH_BLOCK_MASK));
+		
+		// Set values to the SipHash keys
+		__m256i values[] = {
+			_mm256_set1_epi64x(sipHashKeys[0]),
+			_mm256_set1_epi64x(sipHashKeys[1]),
+			_mm256_set1_epi64x(sipHashKeys[2]),
+			_mm256_set1_epi64x(sipHashKeys[3])
+		};
+		
+		// Initialize digest and the nonce hashes at the indices
+		__m256i digest = _mm256_setzero_si256();
+		__m256i nonceHashes = _mm256_setzero_si256();
+		
+		// Go through all nonces in the lanes' blocks
+		for(uint64_t i = 0; i < SIPHASH_BLOCK_LENGTH; ++i) {
+		
+			// Get lanes' nonce
+			const __m256i nonce = _mm256_add_epi64(startingNonces, _mm256_set1_epi64x(i));
+			
+			// Perform hash on values
+			values[3] = _mm256_xor_si256(values[3], nonce);
+			
+			for(int j = 0; j < 6; ++j) {
+			
+				// Check if finished compressing the nonce
+				if(j == 2) {
+				
+					// Finalize values
+					values[0] = _mm256_xor_si256(values[0], nonce);
+					values[2] = _mm256_xor_si256(values[2], _mm256_set1_epi64x(UINT8_MAX));
+				}
+				
+				// Perform round on values
+				values[0] = _mm256_add_epi64(values[0], values[1]);
+				values[2] = _mm256_add_epi64(values[2], values[3]);
+				
+				values[1] = _mm256_or_si256(_mm256_slli_epi64(values[1], 13), _mm256_srli_epi64(values[1], 64 - 13));
+				values[3] = _mm256_or_si256(_mm256_slli_epi64(values[3], 16), _mm256_srli_epi64(values[3], 64 - 16));
+				
+				values[1] = _mm256_xor_si256(values[1], values[0]);
+				values[3] = _mm256_xor_si256(values[3], values[2]);
+				
+				values[0] = _mm256_shuffle_epi32(values[0], _MM_SHUFFLE(2, 3, 0, 1));
+				
+				values[2] = _mm256_add_epi64(values[2], values[1]);
+				values[0] = _mm256_add_epi64(values[0], values[3]);
+				
+				values[1] = _mm256_or_si256(_mm256_slli_epi64(values[1], 17), _mm256_srli_epi64(values[1], 64 - 17));
+				values[3] = _mm256_or_si256(_mm256_sll_epi64(values[3], rotationCount), _mm256_srl_epi64(values[3], inverseRotationCount));
+				
+				values[1] = _mm256_xor_si256(values[1], values[2]);
+				values[3] = _mm256_xor_si256(values[3], values[0]);
+				
+				values[2] = _mm256_shuffle_epi32(values[2], _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			
+			// Set digest to the SipHash-2-4 digest
+			digest = _mm256_xor_si256(_mm256_xor_si256(values[0], values[1]), _mm256_xor_si256(values[2], values[3]));
+			
+			// Set nonce hashes to the digest in lanes whose index is the nonce
+			const __m256i nonceLanes = _mm256_cmpeq_epi64(indices, _mm256_set1_epi64x(i));
+			nonceHashes = _mm256_or_si256(_mm256_andnot_si256(nonceLanes, nonceHashes), _mm256_and_si256(nonceLanes, digest));
+		}
+		
+		// Set blocks to the nonce hashes updated with the last digest or the last digest in lanes whose index is the last nonce
+		const __m256i lastNonceLanes = _mm256_cmpeq_epi64(indices, _mm256_set1_epi64x(SIPHASH_BLOCK_MASK));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(blocks), _mm256_or_si256(_mm256_andnot_si256(lastNonceLanes, _mm256_xor_si256(nonceHashes, digest)), _mm256_and_si256(lastNonceLanes, digest)));
+	}
+	
+	// Disable uninitialized warnings for the AVX-512 intrinsics that start from undefined vectors
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	
+	// SipHash blocks AVX-512
+	__attribute__((target("avx512f"))) void ProofOfWork::sipHashBlocksAvx512(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[SIPHASH_AVX512_LANES], const uint8_t rotation, uint64_t blocks[SIPHASH_AVX512_LANES]) {
+	
+		// Set rotations
+		const __m512i rotations = _mm512_set1_epi64(rotation);
+		
+		// Set lanes' starting nonces and indices
+		const __m512i laneNonces = _mm512_loadu_si512(nonces);
+		const __m512i startingNonces = _mm512_andnot_si512(_mm512_set1_epi64(SIPHASH_BLOCK_MASK), laneNonces);
+		const __m512i indices = _mm512_and_si512(laneNonces, _mm512_set1_epi64(SIPHASH_BLOCK_MASK));
+		
+		// Set values to the SipHash keys
+		__m512i values[] = {
+			_mm512_set1_epi64(sipHashKeys[0]),
+			_mm512_set1_epi64(sipHashKeys[1]),
+			_mm512_set1_epi64(sipHashKeys[2]),
+			_mm512_set1_epi64(sipHashKeys[3])
+		};
+		
+		// Initialize digest and the nonce hashes at the indices
+		__m512i digest = _mm512_setzero_si512();
+		__m512i nonceHashes = _mm512_setzero_si512();
+		
+		// Go through all nonces in the lanes' blocks
+		for(uint64_t i = 0; i < SIPHASH_BLOCK_LENGTH; ++i) {
+		
+			// Get lanes' nonce
+			const __m512i nonce = _mm512_add_epi64(startingNonces, _mm512_set1_epi64(i));
+			
+			// Perform hash on values
+			values[3] = _mm512_xor_si512(values[3], nonce);
+			
+			for(int j = 0; j < 6; ++j) {
+			
+				// Check if finished compressing the nonce
+				if(j == 2) {
+				
+					// Finalize values
+					values[0] = _mm512_xor_si512(values[0], nonce);
+					values[2] = _mm512_xor_si512(values[2], _mm512_set1_epi64(UINT8_MAX));
+				}
+				
+				// Perform round on values
+				values[0] = _mm512_add_epi64(values[0], values[1]);
+				values[2] = _mm512_add_epi64(values[2], values[3]);
+				
+				values[1] = _mm512_rol_epi64(values[1], 13);
+				values[3] = _mm512_rol_epi64(values[3], 16);
+				
+				values[1] = _mm512_xor_si512(values[1], values[0]);
+				values[3] = _mm512_xor_si512(values[3], values[2]);
+				
+				values[0] = _mm512_rol_epi64(values[0], 32);
+				
+				values[2] = _mm512_add_epi64(values[2], values[1]);
+				values[0] = _mm512_add_epi64(values[0], values[3]);
+				
+				values[1] = _mm512_rol_epi64(values[1], 17);
+				values[3] = _mm512_rolv_epi64(values[3], rotations);
+				
+				values[1] = _mm512_xor_si512(values[1], values[2]);
+				values[3] = _mm512_xor_si512(values[3], values[0]);
+				
+				values[2] = _mm512_rol_epi64(values[2], 32);
+			}
+			
+			// Set digest to the SipHash-2-4 digest
+			digest = _mm512_xor_si512(_mm512_xor_si512(values[0], values[1]), _mm512_xor_si512(values[2], values[3]));
+			
+			// Set nonce hashes to the digest in lanes whose index is the nonce
+			nonceHashes = _mm512_mask_blend_epi64(_mm512_cmpeq_epi64_mask(indices, _mm512_set1_epi64(i)), nonceHashes, digest);
+		}
+		
+		// Set blocks to the nonce hashes updated with the last digest or the last digest in lanes whose index is the last nonce
+		_mm512_storeu_si512(blocks, _mm512_mask_blend_epi64(_mm512_cmpeq_epi64_mask(indices, _mm512_set1_epi64(SIPHASH_BLOCK_MASK)), _mm512_xor_si512(nonceHashes, digest), digest));
+	}
+	
+	// Restore warnings
+	#pragma GCC diagnostic pop
+#endif
+
 // SipNode
 uint64_t ProofOfWork::sipNode(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t edge, const uint64_t uorv) {
 
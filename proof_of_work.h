@@ -25,9 +25,28 @@ class ProofOfWork final {
 		// Constructor
 		ProofOfWork() = delete;
 		
+		// SipHash implementation
+		enum class SipHashImplementation {
+		
+			// Scalar
+			SCALAR,
+			
+			// AVX2
+			AVX2,
+			
+			// AVX-512
+			AVX512
+		};
+		
 		// Has valid proof of work
 		static bool hasValidProofOfWork(const Header &header);
 		
+		// Get SipHash implementation
+		static SipHashImplementation getSipHashImplementation();
+		
+		// Set SipHash implementation
+		static bool setSipHashImplementation(const SipHashImplementation implementation);
+		
 	// Public for header class
 	private:
 	
@@ -60,6 +79,15 @@ class ProofOfWork final {
 		
 		// C29 SipHash rotation
 		static const uint8_t C29_SIPHASH_ROTATION;
+		
+		// SipHash self-check keys
+		static const uint64_t SIPHASH_SELF_CHECK_KEYS[SIPHASH_KEYS_LENGTH];
+		
+		// SipHash self-check nonces
+		static const uint64_t SIPHASH_SELF_CHECK_NONCES[];
+		
+		// SipHash implementation
+		static atomic<SipHashImplementation> sipHashImplementation;
 	
 		// SipHash-2-4 class
 		class SipHash24 final {
@@ -89,6 +117,31 @@ class ProofOfWork final {
 		// SipHash block
 		static uint64_t sipHashBlock(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonce, const uint8_t rotation);
 		
+		// SipHash blocks
+		static void sipHashBlocks(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[], const size_t numberOfNonces, const uint8_t rotation, uint64_t blocks[], const SipHashImplementation implementation);
+		
+		// Is SipHash implementation supported
+		static bool isSipHashImplementationSupported(const SipHashImplementation implementation);
+		
+		// Get best SipHash implementation
+		static SipHashImplementation getBestSipHashImplementation();
+		
+		// Check if x86-64 and GCC compatible compiler
+		#if defined __x86_64__ && defined __GNUC__
+		
+			// SipHash AVX2 lanes
+			static const size_t SIPHASH_AVX2_LANES = 4;
+			
+			// SipHash AVX-512 lanes
+			static const size_t SIPHASH_AVX512_LANES = 8;
+			
+			// SipHash blocks AVX2
+			static void sipHashBlocksAvx2(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[SIPHASH_AVX2_LANES], const uint8_t rotation, uint64_t blocks[SIPHASH_AVX2_LANES]);
+			
+			// SipHash blocks AVX-512
+			static void sipHashBlocksAvx512(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t nonces[SIPHASH_AVX512_LANES], const uint8_t rotation, uint64_t blocks[SIPHASH_AVX512_LANES]);
+		#endif
+		
 		// SipNode
 		static uint64_t sipNode(const uint64_t sipHashKeys[SIPHASH_KEYS_LENGTH], const uint64_t edge, const uint64_t uorv);
 };
@@ -86,7 +86,7 @@ bool Rangeproof::operator!=(const Rangeproof &other) const {
 }
 
 // Save
-void Rangeproof::save(ofstream &file) const {
+void Rangeproof::save(ostream &file) const {
 
 	// Write length to file
 	const uint64_t serializedLength = Common::hostByteOrderToBigEndian(length);
@@ -97,19 +97,19 @@ void Rangeproof::save(ofstream &file) const {
 }
 
 // Restore
-Rangeproof Rangeproof::restore(ifstream &file) {
+Rangeproof Rangeproof::restore(istream &file) {
 
 	// Return rangeproof created from file
 	return Rangeproof(file);
 }
 
 // Save sum
-void Rangeproof::saveSum(const int &sum, ofstream &file) {
+void Rangeproof::saveSum(const int &sum, ostream &file) {
 
 }
 
 // Restore sum
-void Rangeproof::restoreSum(int &sum, ifstream &file) {
+void Rangeproof::restoreSum(int &sum, istream &file) {
 
 }
 
@@ -182,7 +182,7 @@ Rangeproof::Rangeproof(const uint64_t length, const uint8_t proof[Crypto::BULLET
 }
 
 // Constructor
-Rangeproof::Rangeproof(ifstream &file) {
+Rangeproof::Rangeproof(istream &file) {
 
 	// Read length from file
 	uint64_t serializedLength;
@@ -18,7 +18,7 @@ namespace MwcValidationNode {
 // Classes
 
 // Merkle mountain range class forward declaration
-template<typename MerkleMountainRangeLeafDerivedClass> class MerkleMountainRange;
+template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> class MerkleMountainRange;
 
 // Transaction class forward declaration
 class Transaction;
@@ -54,19 +54,19 @@ class Rangeproof final : public MerkleMountainRangeLeaf<Rangeproof, sizeof(uint6
 	private:
 	
 		// Merkle mountain range friend class
-		friend class MerkleMountainRange<Rangeproof>;
+		template<typename MerkleMountainRangeLeafDerivedClass, typename HashesClass> friend class MerkleMountainRange;
 		
 		// Save
-		virtual void save(ofstream &file) const override final;
+		virtual void save(ostream &file) const override final;
 		
 		// Restore
-		static Rangeproof restore(ifstream &file);
+		static Rangeproof restore(istream &file);
 		
 		// Save sum
-		static void saveSum(const int &sum, ofstream &file);
+		static void saveSum(const int &sum, ostream &file);
 		
 		// Restore sum
-		static void restoreSum(int &sum, ifstream &file);
+		static void restoreSum(int &sum, istream &file);
 		
 		// Get serialized protocol version
 		static uint32_t getSerializedProtocolVersion(const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH> &serializedRangeproof, const array<uint8_t, MAXIMUM_SERIALIZED_LENGTH>::size_type serializedRangeproofLength, const uint32_t protocolVersion);
@@ -96,7 +96,7 @@ class Rangeproof final : public MerkleMountainRangeLeaf<Rangeproof, sizeof(uint6
 	private:
 	
 		// Constructor
-		explicit Rangeproof(ifstream &file);
+		explicit Rangeproof(istream &file);
 		
 		// length
 		uint64_t length;
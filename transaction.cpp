@@ -2,6 +2,7 @@
 #include "./common.h"
 #include <algorithm>
 #include <cstring>
+#include "blake2.h"
 #include "./saturate_math.h"
 #include "./transaction.h"
 
@@ -21,7 +22,7 @@ const uint64_t Transaction::BODY_WEIGHT_OUTPUT_FACTOR = 4;
 // Supporting function implementation
 
 // Constructor
-Transaction::Transaction(const uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels) :
+Transaction::Transaction(const uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels) :
 
 	// Create block using inputs, outputs, rangeproofs, and kernels
 	block(move(inputs), move(outputs), move(rangeproofs), move(kernels), true),
@@ -153,6 +154,19 @@ Transaction::Transaction(const uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENG
 	
 	// Set offset to offset
 	memcpy(this->offset, offset, sizeof(this->offset));
+	
+	// Get ID preimage
+	const vector idPreimage = getIdPreimage();
+	
+	// Check if creating ID from the ID preimage failed
+	if(blake2b(id.data(), id.size(), idPreimage.data(), idPreimage.size(), nullptr, 0)) {
+	
+		// Throw exception
+		throw runtime_error("Creating ID from the ID preimage failed");
+	}
+	
+	// Set serialized length to the ID preimage's length with the features that the ID preimage leaves out of each input
+	serializedLength = SaturateMath::add(idPreimage.size(), SaturateMath::multiply(getInputs().size(), sizeof(underlying_type_t<Input::Features>)));
 }
 
 // Get offset
@@ -163,28 +177,28 @@ const uint8_t *Transaction::getOffset() const {
 }
 
 // Get inputs
-const list<Input> &Transaction::getInputs() const {
+const vector<Input> &Transaction::getInputs() const {
 
 	// Return block's inputs
 	return block.getInputs();
 }
 
 // Get outputs
-const list<Output> &Transaction::getOutputs() const {
+const vector<Output> &Transaction::getOutputs() const {
 
 	// Return block's outputs
 	return block.getOutputs();
 }
 
 // Get rangeproofs
-const list<Rangeproof> &Transaction::getRangeproofs() const {
+const vector<Rangeproof> &Transaction::getRangeproofs() const {
 
 	// Return block's rangeproofs
 	return block.getRangeproofs();
 }
 
 // Get kernels
-const list<Kernel> &Transaction::getKernels() const {
+const vector<Kernel> &Transaction::getKernels() const {
 
 	// Return block's kernels
 	return block.getKernels();
@@ -204,70 +218,84 @@ uint64_t Transaction::getRequiredFees(const uint64_t baseFee) const {
 	return SaturateMath::multiply(max(SaturateMath::subtract(SaturateMath::add(SaturateMath::multiply(getOutputs().size(), BODY_WEIGHT_OUTPUT_FACTOR), getKernels().size()), getInputs().size()), static_cast<uint64_t>(1)), baseFee);
 }
 
+// Get ID
+const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &Transaction::getId() const {
+
+	// Return ID
+	return id;
+}
+
+// Get serialized length
+uint64_t Transaction::getSerializedLength() const {
+
+	// Return serialized length
+	return serializedLength;
+}
+
 // Equal operator
 bool Transaction::operator==(const Transaction &transaction) const {
 
-	// Return if serialized transactions are equal
-	return serialize() == transaction.serialize();
+	// Return if IDs are equal
+	return id == transaction.id;
 }
 
 // Get inputs
-list<Input> &Transaction::getInputs() {
+vector<Input> &Transaction::getInputs() {
 
 	// Return block's inputs
 	return block.getInputs();
 }
 
-// Serialize
-vector<uint8_t> Transaction::serialize() const {
+// Get ID preimage
+vector<uint8_t> Transaction::getIdPreimage() const {
 
-	// Initialize serialized transaction
-	vector<uint8_t> serializedTransaction;
+	// Initialize ID preimage
+	vector<uint8_t> idPreimage;
 	
-	// Append offset to serialized transaction
-	serializedTransaction.insert(serializedTransaction.cend(), cbegin(offset), cend(offset));
+	// Append offset to ID preimage
+	idPreimage.insert(idPreimage.cend(), cbegin(offset), cend(offset));
 	
-	// Append number of inputs to serialized transaction
-	Common::writeUint64(serializedTransaction, getInputs().size());
+	// Append number of inputs to ID preimage
+	Common::writeUint64(idPreimage, getInputs().size());
 	
-	// Append number of outputs to serialized transaction
-	Common::writeUint64(serializedTransaction, getOutputs().size());
+	// Append number of outputs to ID preimage
+	Common::writeUint64(idPreimage, getOutputs().size());
 	
-	// Append number of kernels to serialized transaction
-	Common::writeUint64(serializedTransaction, getKernels().size());
+	// Append number of kernels to ID preimage
+	Common::writeUint64(idPreimage, getKernels().size());
 	
 	// Go through all inputs
 	for(const Input &input : getInputs()) {
 	
-		// Append serialized input to serialized transaction
-		const vector serialziedInput = input.serialize();
-		serializedTransaction.insert(serializedTransaction.cend(), serialziedInput.cbegin(), serialziedInput.cend());
+		// Append input's lookup value to ID preimage without its features since the node sets inputs' features that are the same as their output's
+		const array inputLookupValue = input.getLookupValue();
+		idPreimage.insert(idPreimage.cend(), inputLookupValue.cbegin(), inputLookupValue.cend());
 	}
 	
 	// Go through all outputs
 	for(const Output &output : getOutputs()) {
 	
-		// Append serialized output to serialized transaction
-		const vector serialziedOutput = output.serialize();
-		serializedTransaction.insert(serializedTransaction.cend(), serialziedOutput.cbegin(), serialziedOutput.cend());
+		// Append serialized output to ID preimage
+		const vector serializedOutput = output.serialize();
+		idPreimage.insert(idPreimage.cend(), serializedOutput.cbegin(), serializedOutput.cend());
 	}
 	
 	// Go through all rangeproofs
 	for(const Rangeproof &rangeproof : getRangeproofs()) {
 	
-		// Append serialized rangeproof to serialized transaction
-		const vector serialziedRangeproof = rangeproof.serialize();
-		serializedTransaction.insert(serializedTransaction.cend(), serialziedRangeproof.cbegin(), serialziedRangeproof.cend());
+		// Append serialized rangeproof to ID preimage
+		const vector serializedRangeproof = rangeproof.serialize();
+		idPreimage.insert(idPreimage.cend(), serializedRangeproof.cbegin(), serializedRangeproof.cend());
 	}
 	
 	// Go through all kernels
 	for(const Kernel &kernel : getKernels()) {
 	
-		// Append serialized kernel to serialized transaction
-		const vector serialziedKernel = kernel.serialize();
-		serializedTransaction.insert(serializedTransaction.cend(), serialziedKernel.cbegin(), serialziedKernel.cend());
+		// Append serialized kernel to ID preimage
+		const vector serializedKernel = kernel.serialize();
+		idPreimage.insert(idPreimage.cend(), serializedKernel.cbegin(), serializedKernel.cend());
 	}
 	
-	// Return serialized transaction
-	return serializedTransaction;
+	// Return ID preimage
+	return idPreimage;
 }
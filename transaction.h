@@ -5,7 +5,8 @@
 
 // Header files
 #include "./common.h"
-#include <list>
+#include <array>
+#include <vector>
 #include "./block.h"
 
 using namespace std;
@@ -20,9 +21,6 @@ namespace MwcValidationNode {
 // Node class forward declaration
 class Node;
 
-// Mempool class forward declaration
-class Mempool;
-
 // Transaction class
 class Transaction final {
 
@@ -30,22 +28,22 @@ class Transaction final {
 	public:
 	
 		// Constructor
-		explicit Transaction(const uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], list<Input> &&inputs, list<Output> &&outputs, list<Rangeproof> &&rangeproofs, list<Kernel> &&kernels);
+		explicit Transaction(const uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH], vector<Input> &&inputs, vector<Output> &&outputs, vector<Rangeproof> &&rangeproofs, vector<Kernel> &&kernels);
 		
 		// Get offset
 		const uint8_t *getOffset() const;
 		
 		// Get inputs
-		const list<Input> &getInputs() const;
+		const vector<Input> &getInputs() const;
 		
 		// Get outputs
-		const list<Output> &getOutputs() const;
+		const vector<Output> &getOutputs() const;
 		
 		// Get rangeproofs
-		const list<Rangeproof> &getRangeproofs() const;
+		const vector<Rangeproof> &getRangeproofs() const;
 		
 		// Get kernels
-		const list<Kernel> &getKernels() const;
+		const vector<Kernel> &getKernels() const;
 		
 		// Get fees
 		uint64_t getFees() const;
@@ -53,6 +51,12 @@ class Transaction final {
 		// Get required fees
 		uint64_t getRequiredFees(const uint64_t baseFee) const;
 		
+		// Get ID
+		const array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> &getId() const;
+		
+		// Get serialized length
+		uint64_t getSerializedLength() const;
+		
 		// Equal operator
 		bool operator==(const Transaction &transaction) const;
 		
@@ -63,16 +67,7 @@ class Transaction final {
 		friend class Node;
 		
 		// Get inputs
-		list<Input> &getInputs();
-		
-	// Public for mempool class
-	private:
-	
-		// Mempool friend class
-		friend class Mempool;
-		
-		// Serialize
-		vector<uint8_t> serialize() const;
+		vector<Input> &getInputs();
 		
 	// Private
 	private:
@@ -80,6 +75,9 @@ class Transaction final {
 		// Body weight output factor
 		static const uint64_t BODY_WEIGHT_OUTPUT_FACTOR;
 		
+		// Get ID preimage
+		vector<uint8_t> getIdPreimage() const;
+		
 		// Offset
 		uint8_t offset[Crypto::SECP256K1_PRIVATE_KEY_LENGTH];
 	
@@ -88,6 +86,12 @@ class Transaction final {
 		
 		// Fees
 		uint64_t fees;
+		
+		// ID
+		array<uint8_t, Crypto::BLAKE2B_HASH_LENGTH> id;
+		
+		// Serialized length
+		uint64_t serializedLength;
 };
 
 